@@ -0,0 +1,132 @@
+#ifndef ASSIGNMENTS_DG_BENCHMARK_H_
+#define ASSIGNMENTS_DG_BENCHMARK_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/* small helpers shared by the graph benchmark binaries. Build them with
+ * optimisations on, e.g. bazel run -c opt //assignments/dg:iteration_benchmark */
+namespace gdwg {
+namespace benchmark {
+
+class Stopwatch {
+ public:
+  Stopwatch() : start_{std::chrono::steady_clock::now()} {}
+  void Reset() { start_ = std::chrono::steady_clock::now(); }
+  double Seconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+};
+
+/* reads argv[i] as a count, falling back to def if it wasn't given */
+inline std::size_t Arg(int argc, char** argv, int i, std::size_t def) {
+  return argc > i ? static_cast<std::size_t>(std::strtoull(argv[i], nullptr, 10)) : def;
+}
+
+/* num_edges random (src, dst, weight) tuples over nodes 0..num_nodes-1. The seed
+ * is fixed so every run (and every benchmark) sees the same graph */
+inline std::vector<std::tuple<int, int, int>>
+RandomEdges(std::size_t num_nodes, std::size_t num_edges, unsigned seed = 6771) {
+  std::mt19937 rng{seed};
+  std::uniform_int_distribution<int> node{0, static_cast<int>(num_nodes) - 1};
+  std::uniform_int_distribution<int> weight{1, 100};
+  std::vector<std::tuple<int, int, int>> edges{};
+  edges.reserve(num_edges);
+  for (std::size_t i = 0; i < num_edges; ++i) {
+    edges.emplace_back(node(rng), node(rng), weight(rng));
+  }
+  return edges;
+}
+
+/* prints one result line: what was timed, how many items and the rate */
+inline void Report(const std::string& name, std::size_t items, double seconds) {
+  std::cout << name << ": " << items << " items in " << seconds << " s ("
+            << (seconds > 0 ? static_cast<double>(items) / seconds : 0.0) << " items/s)\n";
+}
+
+/* prints the latency distribution of a set of timed calls (e.g. one per query):
+ * the median, 90th and 99th percentiles and the worst, in microseconds */
+inline void ReportLatencies(const std::string& name, std::vector<double> seconds) {
+  if (seconds.empty())
+    return;
+  std::sort(seconds.begin(), seconds.end());
+  auto percentile = [&seconds](double p) {
+    return 1e6 * seconds[static_cast<std::size_t>(p * static_cast<double>(seconds.size() - 1))];
+  };
+  std::cout << name << ": " << seconds.size() << " calls, p50 " << percentile(0.5) << " us, p90 "
+            << percentile(0.9) << " us, p99 " << percentile(0.99) << " us, max "
+            << 1e6 * seconds.back() << " us\n";
+}
+
+/* collects results for regression tracking and writes them out as a JSON array,
+ * one object per result: its name, the params describing the run (e.g.
+ * {"shape", "star"}), and the items, seconds and items per second */
+class JsonResults {
+ public:
+  using Params = std::vector<std::pair<std::string, std::string>>;
+
+  void Add(const std::string& name, const Params& params, std::size_t items, double seconds) {
+    results_.push_back({name, params, items, seconds});
+  }
+
+  void Write(std::ostream& os) const {
+    os << "[";
+    for (std::size_t i = 0; i < results_.size(); ++i) {
+      const auto& result = results_[i];
+      os << (i == 0 ? "\n" : ",\n") << "  {\"name\": " << Quote(result.name);
+      for (const auto& [key, value] : result.params) {
+        os << ", " << Quote(key) << ": " << Quote(value);
+      }
+      const auto rate =
+          result.seconds > 0 ? static_cast<double>(result.items) / result.seconds : 0.0;
+      os << ", \"items\": " << result.items << ", \"seconds\": " << result.seconds
+         << ", \"items_per_second\": " << rate << "}";
+    }
+    os << "\n]\n";
+  }
+
+ private:
+  struct Result {
+    std::string name;
+    Params params;
+    std::size_t items;
+    double seconds;
+  };
+
+  static std::string Quote(const std::string& s) {
+    std::string quoted{"\""};
+    for (char c : s) {
+      if (c == '"' || c == '\\') {
+        quoted += '\\';
+        quoted += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        const char* hex = "0123456789abcdef";
+        quoted += "\\u00";
+        quoted += hex[(c >> 4) & 0xf];
+        quoted += hex[c & 0xf];
+      } else {
+        quoted += c;
+      }
+    }
+    return quoted + "\"";
+  }
+
+  std::vector<Result> results_;
+};
+
+}  // namespace benchmark
+}  // namespace gdwg
+
+#endif  // ASSIGNMENTS_DG_BENCHMARK_H_
@@ -0,0 +1,300 @@
+#include "assignments/dg/community.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/* label propagation stops after this many rounds even if nodes are still moving */
+constexpr std::size_t kMaxRounds = 20;
+/* and a Louvain level after this many passes over the nodes */
+constexpr std::size_t kMaxPasses = 50;
+/* a move has to raise modularity (times 2m) by more than this to count, so
+ * rounding can't keep a node hopping between equally good communities */
+constexpr double kMinGain = 1e-12;
+
+/* renumbers labels 0, 1, ... in the order they first appear, returning how many
+ * there are */
+std::size_t Renumber(std::vector<std::uint32_t>& labels) {
+  const auto unseen = static_cast<std::uint32_t>(-1);
+  std::vector<std::uint32_t> number(labels.size(), unseen);
+  std::uint32_t next = 0;
+  for (auto& label : labels) {
+    if (number[label] == unseen)
+      number[label] = next++;
+    label = number[label];
+  }
+  return next;
+}
+
+/* the weight from v to each community its neighbours (other than v itself) are
+ * in, as (community, weight) sorted by community. pairs is scratch space */
+void NeighbourWeights(const gdwg::detail::WeightedCsr& g,
+                      std::uint32_t v,
+                      const std::vector<std::atomic<std::uint32_t>>& label,
+                      std::vector<std::pair<std::uint32_t, double>>& pairs) {
+  pairs.clear();
+  for (auto e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+    if (g.targets[e] != v)
+      pairs.emplace_back(label[g.targets[e]].load(std::memory_order_relaxed), g.weights[e]);
+  }
+  std::sort(pairs.begin(), pairs.end());
+  std::size_t out = 0;
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    if (out > 0 && pairs[out - 1].first == pairs[i].first) {
+      pairs[out - 1].second += pairs[i].second;
+    } else {
+      pairs[out++] = pairs[i];
+    }
+  }
+  pairs.resize(out);
+}
+
+/* one level of Louvain on g: moves nodes between communities (starting from one
+ * each) until a pass moves none. Returns whether any node moved at all */
+bool MoveNodes(const gdwg::detail::WeightedCsr& g, std::vector<std::uint32_t>& community) {
+  const auto n = static_cast<std::uint32_t>(g.offsets.size() - 1);
+  /* k[v] is v's weighted degree, tot[c] the sum of k over community c, and two_m
+   * the sum of every k */
+  std::vector<double> k(n, 0.0);
+  double two_m = 0.0;
+  for (std::uint32_t v = 0; v < n; ++v) {
+    for (auto e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+      k[v] += g.weights[e];
+    }
+    two_m += k[v];
+  }
+  community.resize(n);
+  for (std::uint32_t v = 0; v < n; ++v) {
+    community[v] = v;
+  }
+  if (two_m <= 0.0)
+    return false;
+  auto tot = k;
+
+  /* weight_to[c] is the weight from the current node to community c, for the
+   * communities in touched (and zero for the rest). A community can be in
+   * touched twice, which only means it is looked at twice */
+  std::vector<double> weight_to(n, 0.0);
+  std::vector<std::uint32_t> touched{};
+  bool any_moved = false;
+  for (std::size_t pass = 0; pass < kMaxPasses; ++pass) {
+    std::size_t moved = 0;
+    for (std::uint32_t v = 0; v < n; ++v) {
+      const auto from = community[v];
+      touched.clear();
+      touched.push_back(from);
+      for (auto e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+        const auto c = community[g.targets[e]];
+        if (g.targets[e] == v)
+          continue;
+        if (weight_to[c] == 0.0)
+          touched.push_back(c);
+        weight_to[c] += g.weights[e];
+      }
+      /* take v out, then put it back wherever gains most: joining c gains
+       * weight_to[c] - tot[c] * k[v] / two_m (all times 2m) */
+      tot[from] -= k[v];
+      auto best = from;
+      auto best_gain = weight_to[from] - tot[from] * k[v] / two_m;
+      for (const auto c : touched) {
+        const auto gain = weight_to[c] - tot[c] * k[v] / two_m;
+        if (gain > best_gain + kMinGain) {
+          best = c;
+          best_gain = gain;
+        }
+      }
+      tot[best] += k[v];
+      community[v] = best;
+      moved += best != from;
+      for (const auto c : touched) {
+        weight_to[c] = 0.0;
+      }
+    }
+    any_moved = any_moved || moved > 0;
+    if (moved == 0)
+      break;
+  }
+  return any_moved;
+}
+
+/* g with each community (numbered 0..num_communities - 1) collapsed into one
+ * node, the weight between two communities being the sum of the weights
+ * between their members. Communities are worked on in parallel */
+gdwg::detail::WeightedCsr Coarsen(const gdwg::detail::WeightedCsr& g,
+                                  const std::vector<std::uint32_t>& community,
+                                  std::size_t num_communities,
+                                  gdwg::ThreadPool& pool) {
+  const auto n = community.size();
+  /* the nodes of each community, by counting sort */
+  std::vector<std::size_t> member_offsets(num_communities + 1, 0);
+  for (const auto c : community) {
+    ++member_offsets[c + 1];
+  }
+  for (std::size_t c = 0; c < num_communities; ++c) {
+    member_offsets[c + 1] += member_offsets[c];
+  }
+  std::vector<std::uint32_t> members(n);
+  auto next = member_offsets;
+  for (std::uint32_t v = 0; v < n; ++v) {
+    members[next[community[v]]++] = v;
+  }
+
+  /* each chunk of communities gathers, sorts and sums its own edges */
+  struct Chunk {
+    std::vector<std::size_t> degrees;
+    std::vector<std::pair<std::uint32_t, double>> edges;
+  };
+  const auto num_chunks = std::min(num_communities, 16 * (pool.Size() + 1));
+  std::vector<Chunk> chunks(num_chunks);
+  pool.ParallelFor(num_chunks, [&](std::size_t i) {
+    auto& chunk = chunks[i];
+    std::vector<std::pair<std::uint32_t, double>> pairs{};
+    for (auto c = num_communities * i / num_chunks; c < num_communities * (i + 1) / num_chunks;
+         ++c) {
+      pairs.clear();
+      for (auto m = member_offsets[c]; m < member_offsets[c + 1]; ++m) {
+        const auto v = members[m];
+        for (auto e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+          pairs.emplace_back(community[g.targets[e]], g.weights[e]);
+        }
+      }
+      std::sort(pairs.begin(), pairs.end());
+      const auto first = chunk.edges.size();
+      for (const auto& pair : pairs) {
+        if (chunk.edges.size() > first && chunk.edges.back().first == pair.first) {
+          chunk.edges.back().second += pair.second;
+        } else {
+          chunk.edges.push_back(pair);
+        }
+      }
+      chunk.degrees.push_back(chunk.edges.size() - first);
+    }
+  });
+
+  gdwg::detail::WeightedCsr coarse{};
+  coarse.offsets.reserve(num_communities + 1);
+  coarse.offsets.push_back(0);
+  for (const auto& chunk : chunks) {
+    for (const auto degree : chunk.degrees) {
+      coarse.offsets.push_back(coarse.offsets.back() + degree);
+    }
+    for (const auto& [target, weight] : chunk.edges) {
+      coarse.targets.push_back(target);
+      coarse.weights.push_back(weight);
+    }
+  }
+  return coarse;
+}
+
+}  // namespace
+
+double gdwg::detail::Modularity(const WeightedCsr& g, const std::vector<std::uint32_t>& community) {
+  const auto n = community.size();
+  if (n == 0)
+    return 0.0;
+  const auto num_communities =
+      std::size_t{*std::max_element(community.begin(), community.end())} + 1;
+  /* Q = sum over communities c of in[c] / 2m - (tot[c] / 2m)^2, where in[c] is
+   * the weight of the edges inside c (both ways) and tot[c] its members' degrees */
+  std::vector<double> in(num_communities, 0.0);
+  std::vector<double> tot(num_communities, 0.0);
+  double two_m = 0.0;
+  for (std::size_t v = 0; v < n; ++v) {
+    for (auto e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+      tot[community[v]] += g.weights[e];
+      if (community[g.targets[e]] == community[v])
+        in[community[v]] += g.weights[e];
+      two_m += g.weights[e];
+    }
+  }
+  if (two_m <= 0.0)
+    return 0.0;
+  double q = 0.0;
+  for (std::size_t c = 0; c < num_communities; ++c) {
+    q += in[c] / two_m - (tot[c] / two_m) * (tot[c] / two_m);
+  }
+  return q;
+}
+
+gdwg::detail::Clustering gdwg::detail::PropagateLabels(const WeightedCsr& g, ThreadPool& pool) {
+  const auto n = g.offsets.size() - 1;
+  /* labels are read and written by every thread at once: relaxed atomics make
+   * that well defined without costing anything over plain loads and stores */
+  std::vector<std::atomic<std::uint32_t>> label(n);
+  for (std::size_t v = 0; v < n; ++v) {
+    label[v].store(static_cast<std::uint32_t>(v), std::memory_order_relaxed);
+  }
+  const auto num_chunks = std::min(n, 16 * (pool.Size() + 1));
+  std::vector<std::size_t> moved(num_chunks, 0);
+  for (std::size_t round = 0; round < kMaxRounds; ++round) {
+    pool.ParallelFor(num_chunks, [&](std::size_t chunk) {
+      std::vector<std::pair<std::uint32_t, double>> pairs{};
+      moved[chunk] = 0;
+      for (auto v = n * chunk / num_chunks; v < n * (chunk + 1) / num_chunks; ++v) {
+        const auto vid = static_cast<std::uint32_t>(v);
+        NeighbourWeights(g, vid, label, pairs);
+        const auto current = label[v].load(std::memory_order_relaxed);
+        /* the heaviest label, staying put on a tie, or else the lowest label */
+        auto best = current;
+        double best_weight = -1.0;
+        for (const auto& [l, w] : pairs) {
+          if (w > best_weight || (w == best_weight && l == current)) {
+            best = l;
+            best_weight = w;
+          }
+        }
+        if (best != current) {
+          label[v].store(best, std::memory_order_relaxed);
+          ++moved[chunk];
+        }
+      }
+    });
+    std::size_t total_moved = 0;
+    for (const auto m : moved) {
+      total_moved += m;
+    }
+    if (total_moved <= n / 1000)
+      break;
+  }
+
+  Clustering clustering{};
+  clustering.community.resize(n);
+  for (std::size_t v = 0; v < n; ++v) {
+    clustering.community[v] = label[v].load(std::memory_order_relaxed);
+  }
+  clustering.num_communities = Renumber(clustering.community);
+  return clustering;
+}
+
+gdwg::detail::Clustering gdwg::detail::LouvainClustering(const WeightedCsr& g, ThreadPool& pool) {
+  const auto n = g.offsets.size() - 1;
+  Clustering clustering{};
+  clustering.community.resize(n);
+  for (std::size_t v = 0; v < n; ++v) {
+    clustering.community[v] = static_cast<std::uint32_t>(v);
+  }
+  clustering.num_communities = n;
+
+  /* level holds the current coarse graph; each of the original nodes' community
+   * is the coarse node it has been collapsed into */
+  WeightedCsr level{};
+  const auto* current = &g;
+  std::vector<std::uint32_t> moved_to{};
+  while (MoveNodes(*current, moved_to)) {
+    const auto num_communities = Renumber(moved_to);
+    for (auto& c : clustering.community) {
+      c = moved_to[c];
+    }
+    clustering.num_communities = num_communities;
+    ++clustering.levels;
+    level = Coarsen(*current, moved_to, num_communities, pool);
+    current = &level;
+  }
+  Renumber(clustering.community);
+  return clustering;
+}
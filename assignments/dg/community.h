@@ -0,0 +1,98 @@
+#ifndef ASSIGNMENTS_DG_COMMUNITY_H_
+#define ASSIGNMENTS_DG_COMMUNITY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+
+/* community detection: grouping nodes so that much more edge weight falls inside
+ * the groups than would by chance. Both algorithms work on the undirected graph
+ * underneath a snapshot, where the weight between u and v is the sum of every
+ * edge's weight between them in either direction (a reflexive edge counts
+ * twice, as both of its ends are at the same node). Weights must be numbers, and
+ * not negative */
+namespace gdwg {
+
+/* a clustering of a graph's nodes into num_communities communities */
+template <typename N>
+struct Communities {
+  std::size_t num_communities{0};
+  /* the rest are per node, in the graph's node order. Communities are numbered
+   * 0..num_communities - 1 in the order their first node appears */
+  std::vector<N> nodes;
+  std::vector<std::uint32_t> community;
+  /* Newman's modularity of the clustering, between -1/2 and 1 */
+  double modularity{0.0};
+  /* how many times the graph was coarsened (label propagation doesn't, so 0) */
+  std::size_t levels{0};
+};
+
+namespace detail {
+
+/* the weighted undirected graph underneath a snapshot, as a CSR with each
+ * node's neighbours in increasing order. A node's reflexive edges show up as a
+ * neighbour of itself, with twice their weight */
+struct WeightedCsr {
+  std::vector<std::size_t> offsets;
+  std::vector<std::uint32_t> targets;
+  std::vector<double> weights;
+};
+
+/* a community per node, numbered by first appearance */
+struct Clustering {
+  std::vector<std::uint32_t> community;
+  std::size_t num_communities{0};
+  std::size_t levels{0};
+};
+
+template <typename N, typename E>
+WeightedCsr MakeWeightedUndirected(const CsrSnapshot<N, E>& g);
+double Modularity(const WeightedCsr& g, const std::vector<std::uint32_t>& community);
+Clustering PropagateLabels(const WeightedCsr& g, ThreadPool& pool);
+Clustering LouvainClustering(const WeightedCsr& g, ThreadPool& pool);
+
+}  // namespace detail
+
+/* weighted label propagation: every node starts in its own community, then in
+ * rounds each node joins whichever community the most weight of its neighbours
+ * is in (staying put on a tie). Nodes are updated in place, in parallel on pool,
+ * so later nodes in a round already see earlier moves and clusters spread fast;
+ * which thread gets there first can change the result a little from run to
+ * run. Stops once a round moves next to nothing. Throws std::domain_error if
+ * any weight is negative */
+template <typename N, typename E>
+Communities<N> LabelPropagation(const CsrSnapshot<N, E>& g,
+                                ThreadPool& pool = ThreadPool::Default());
+template <typename N, typename E>
+Communities<N> LabelPropagation(const Graph<N, E>& g, ThreadPool& pool = ThreadPool::Default()) {
+  return LabelPropagation(CsrSnapshot<N, E>{g}, pool);
+}
+
+/* Blondel et al.'s multi-level Louvain method. Each level moves nodes one at a
+ * time to the neighbouring community that raises modularity most, until no
+ * move does, then collapses each community into a single node (its internal
+ * weight becoming a reflexive edge) and starts again on that smaller graph.
+ * Stops at the first level where nothing moves. Deterministic. Coarsening runs
+ * on pool. Throws std::domain_error if any weight is negative */
+template <typename N, typename E>
+Communities<N> Louvain(const CsrSnapshot<N, E>& g, ThreadPool& pool = ThreadPool::Default());
+template <typename N, typename E>
+Communities<N> Louvain(const Graph<N, E>& g, ThreadPool& pool = ThreadPool::Default()) {
+  return Louvain(CsrSnapshot<N, E>{g}, pool);
+}
+
+/* the modularity of any clustering of g, given as a community per snapshot id
+ * (see Communities::modularity). Throws std::invalid_argument if there isn't
+ * one per node */
+template <typename N, typename E>
+double Modularity(const CsrSnapshot<N, E>& g, const std::vector<std::uint32_t>& community);
+
+}  // namespace gdwg
+
+#include "assignments/dg/community.tpp"
+
+#endif  // ASSIGNMENTS_DG_COMMUNITY_H_
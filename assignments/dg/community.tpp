@@ -0,0 +1,88 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename N, typename E>
+gdwg::detail::WeightedCsr gdwg::detail::MakeWeightedUndirected(const CsrSnapshot<N, E>& g) {
+  static_assert(std::is_arithmetic<E>::value, "community detection needs numeric weights");
+  const auto t = g.Transposed();
+  const auto n = static_cast<std::uint32_t>(g.NumNodes());
+  WeightedCsr u{};
+  u.offsets.reserve(n + 1);
+  u.offsets.push_back(0);
+  u.targets.reserve(2 * g.NumEdges());
+  u.weights.reserve(2 * g.NumEdges());
+  auto add = [&u](std::uint32_t target, E w) {
+    if (w < 0) {
+      throw std::domain_error("Cannot call community detection on a graph with negative weights");
+    }
+    if (u.targets.size() != u.offsets.back() && u.targets.back() == target) {
+      u.weights.back() += static_cast<double>(w);
+    } else {
+      u.targets.push_back(target);
+      u.weights.push_back(static_cast<double>(w));
+    }
+  };
+  for (std::uint32_t v = 0; v < n; ++v) {
+    /* both lists are sorted by id, so merge them, summing the weight to each
+     * neighbour. A reflexive edge is in both, so is counted twice */
+    auto out = g.Offsets()[v];
+    auto in = t.Offsets()[v];
+    const auto out_end = g.Offsets()[v + 1];
+    const auto in_end = t.Offsets()[v + 1];
+    while (out < out_end || in < in_end) {
+      if (in == in_end || (out < out_end && g.Targets()[out] < t.Targets()[in])) {
+        add(g.Targets()[out], g.Weights()[out]);
+        ++out;
+      } else {
+        add(t.Targets()[in], t.Weights()[in]);
+        ++in;
+      }
+    }
+    u.offsets.push_back(u.targets.size());
+  }
+  return u;
+}
+
+namespace gdwg {
+namespace detail {
+
+/* the clustering as communities of node values */
+template <typename N, typename E>
+Communities<N> ToCommunities(const CsrSnapshot<N, E>& g,
+                             const WeightedCsr& u,
+                             Clustering clustering) {
+  Communities<N> result{};
+  result.num_communities = clustering.num_communities;
+  result.nodes = g.Nodes();
+  result.modularity = Modularity(u, clustering.community);
+  result.community = std::move(clustering.community);
+  result.levels = clustering.levels;
+  return result;
+}
+
+}  // namespace detail
+}  // namespace gdwg
+
+template <typename N, typename E>
+gdwg::Communities<N> gdwg::LabelPropagation(const CsrSnapshot<N, E>& g, ThreadPool& pool) {
+  const auto u = detail::MakeWeightedUndirected(g);
+  return detail::ToCommunities(g, u, detail::PropagateLabels(u, pool));
+}
+
+template <typename N, typename E>
+gdwg::Communities<N> gdwg::Louvain(const CsrSnapshot<N, E>& g, ThreadPool& pool) {
+  const auto u = detail::MakeWeightedUndirected(g);
+  return detail::ToCommunities(g, u, detail::LouvainClustering(u, pool));
+}
+
+template <typename N, typename E>
+double gdwg::Modularity(const CsrSnapshot<N, E>& g, const std::vector<std::uint32_t>& community) {
+  if (community.size() != g.NumNodes()) {
+    throw std::invalid_argument("Cannot call Modularity without a community for every node");
+  }
+  return detail::Modularity(detail::MakeWeightedUndirected(g), community);
+}
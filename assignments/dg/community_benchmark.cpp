@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/community.h"
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+
+/* clusters a planted partition graph: num_nodes nodes in groups of group_size,
+ * with num_edges random edges (weights 1..10), each staying inside its src's
+ * group 80% of the time. Reports the runtime, number of communities and
+ * modularity of label propagation and Louvain, against the planted groups' own
+ * modularity. The graph is built with Graph::FromSortedIds so the setup doesn't
+ * take longer than the clustering.
+ * usage: community_benchmark [num_nodes (default 200000)] [num_edges (default 1500000)]
+ *                            [group_size (default 100)] */
+int main(int argc, char** argv) {
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 1, 200000);
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 2, 1500000);
+  const auto group_size = gdwg::benchmark::Arg(argc, argv, 3, 100);
+
+  std::mt19937 rng{6771};
+  const auto last_node = static_cast<std::uint32_t>(num_nodes - 1);
+  std::uniform_int_distribution<std::uint32_t> node{0, last_node};
+  std::uniform_int_distribution<std::uint32_t> offset{
+      0, static_cast<std::uint32_t>(group_size) - 1};
+  std::uniform_int_distribution<int> weight{1, 10};
+  std::uniform_int_distribution<int> percent{0, 99};
+  std::vector<std::tuple<std::uint32_t, std::uint32_t, double>> edges{};
+  edges.reserve(num_edges);
+  for (std::size_t i = 0; i < num_edges; ++i) {
+    const auto src = node(rng);
+    auto dst = node(rng);
+    if (percent(rng) < 80)
+      dst = std::min<std::uint32_t>(src / group_size * group_size + offset(rng), last_node);
+    edges.emplace_back(src, dst, weight(rng));
+  }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  std::vector<int> nodes(num_nodes);
+  std::vector<std::uint32_t> planted(num_nodes);
+  for (std::size_t v = 0; v < num_nodes; ++v) {
+    nodes[v] = static_cast<int>(v);
+    planted[v] = static_cast<std::uint32_t>(v / group_size);
+  }
+  const auto g = gdwg::Graph<int, double>::FromSortedIds(nodes, edges);
+  const gdwg::CsrSnapshot<int, double> csr{g};
+  std::cout << num_nodes << " nodes, " << csr.NumEdges() << " edges, planted modularity "
+            << gdwg::Modularity(csr, planted) << "\n";
+
+  gdwg::benchmark::JsonResults json{};
+  auto report = [&](const std::string& name, const gdwg::Communities<int>& communities,
+                    double seconds) {
+    gdwg::benchmark::Report(name, csr.NumEdges(), seconds);
+    std::cout << "  " << communities.num_communities << " communities, modularity "
+              << communities.modularity << ", " << communities.levels << " levels\n";
+    json.Add(name,
+             {{"communities", std::to_string(communities.num_communities)},
+              {"modularity", std::to_string(communities.modularity)}},
+             csr.NumEdges(), seconds);
+  };
+
+  gdwg::benchmark::Stopwatch lpa_timer{};
+  const auto lpa = gdwg::LabelPropagation(csr);
+  report("LabelPropagation", lpa, lpa_timer.Seconds());
+
+  gdwg::benchmark::Stopwatch louvain_timer{};
+  const auto louvain = gdwg::Louvain(csr);
+  report("Louvain", louvain, louvain_timer.Seconds());
+  json.Write(std::cout);
+}
@@ -0,0 +1,173 @@
+#include "assignments/dg/community.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+#include "catch.h"
+
+namespace {
+
+/* num_groups groups of group_size nodes, each a clique (one way round), with a
+ * chain of single light edges joining group i to group i + 1 */
+gdwg::Graph<int, double> Cliques(int num_groups, int group_size) {
+  std::vector<std::tuple<int, int, double>> edges{};
+  for (int group = 0; group < num_groups; ++group) {
+    const auto first = group * group_size;
+    for (int a = first; a < first + group_size; ++a) {
+      for (int b = a + 1; b < first + group_size; ++b) {
+        edges.emplace_back(a, b, 1.0);
+      }
+    }
+    if (group + 1 < num_groups)
+      edges.emplace_back(first, first + group_size, 0.5);
+  }
+  return gdwg::Graph<int, double>{edges.cbegin(), edges.cend()};
+}
+
+}  // namespace
+
+SCENARIO("MakeWeightedUndirected") {
+  GIVEN("edges both ways, a parallel edge and a reflexive edge") {
+    std::vector<std::tuple<char, char, int>> edges{
+        {'a', 'b', 1}, {'b', 'a', 2}, {'b', 'c', 3}, {'b', 'c', 4}, {'c', 'c', 5}};
+    gdwg::Graph<char, int> g{edges.cbegin(), edges.cend()};
+    const auto u = gdwg::detail::MakeWeightedUndirected(gdwg::CsrSnapshot<char, int>{g});
+    THEN("the weights between each pair are summed, and the reflexive edge counts twice") {
+      REQUIRE(u.offsets == std::vector<std::size_t>{0, 1, 3, 5});
+      REQUIRE(u.targets == std::vector<std::uint32_t>{1, 0, 2, 1, 2});
+      REQUIRE(u.weights == std::vector<double>{3, 3, 7, 7, 10});
+    }
+  }
+  GIVEN("a negative weight") {
+    gdwg::Graph<char, int> g{'a', 'b'};
+    g.InsertEdge('a', 'b', -1);
+    THEN("nothing can be clustered") {
+      REQUIRE_THROWS_AS(gdwg::Louvain(g), std::domain_error);
+      REQUIRE_THROWS_AS(gdwg::LabelPropagation(g), std::domain_error);
+    }
+  }
+}
+
+SCENARIO("Modularity") {
+  GIVEN("two triangles joined by an edge") {
+    std::vector<std::tuple<int, int, double>> edges{{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {3, 4, 1},
+                                                    {4, 5, 1}, {5, 3, 1}, {2, 3, 1}};
+    gdwg::Graph<int, double> g{edges.cbegin(), edges.cend()};
+    gdwg::CsrSnapshot<int, double> csr{g};
+    THEN("splitting it into the triangles scores 2 * (6/14 - (7/14)^2)") {
+      REQUIRE(gdwg::Modularity(csr, {0, 0, 0, 1, 1, 1}) == Approx(5.0 / 14));
+    }
+    THEN("one community scores 0, and one per node scores less") {
+      REQUIRE(gdwg::Modularity(csr, {0, 0, 0, 0, 0, 0}) == Approx(0.0).margin(1e-12));
+      REQUIRE(gdwg::Modularity(csr, {0, 1, 2, 3, 4, 5}) == Approx(-34.0 / 196));
+    }
+    THEN("a community has to be given for every node") {
+      REQUIRE_THROWS_AS(gdwg::Modularity(csr, {0, 0}), std::invalid_argument);
+    }
+    THEN("Louvain finds the triangles") {
+      const auto communities = gdwg::Louvain(g);
+      REQUIRE(communities.nodes == g.GetNodes());
+      REQUIRE(communities.num_communities == 2);
+      REQUIRE(communities.community == std::vector<std::uint32_t>{0, 0, 0, 1, 1, 1});
+      REQUIRE(communities.modularity == Approx(5.0 / 14));
+      REQUIRE(communities.levels >= 1);
+    }
+  }
+}
+
+SCENARIO("Louvain") {
+  GIVEN("a chain of cliques") {
+    const auto g = Cliques(12, 6);
+    gdwg::ThreadPool pool{3};
+    const auto communities = gdwg::Louvain(g, pool);
+    THEN("each clique is a community") {
+      REQUIRE(communities.num_communities == 12);
+      for (std::size_t v = 0; v < communities.nodes.size(); ++v) {
+        REQUIRE(communities.community[v] == v / 6);
+      }
+    }
+    THEN("it takes more than one level to merge the cliques' singletons") {
+      REQUIRE(communities.levels >= 1);
+      REQUIRE(communities.modularity ==
+              Approx(gdwg::Modularity(gdwg::CsrSnapshot<int, double>{g}, communities.community)));
+    }
+  }
+  GIVEN("a weighted graph where one heavy edge decides a node's community") {
+    std::vector<std::tuple<std::string, std::string, double>> edges{
+        {"a", "b", 1}, {"b", "c", 1}, {"c", "a", 1}, {"x", "y", 1},
+        {"y", "z", 1}, {"z", "x", 1}, {"m", "a", 1}, {"m", "x", 9}};
+    gdwg::Graph<std::string, double> g{edges.cbegin(), edges.cend()};
+    const auto communities = gdwg::Louvain(g);
+    THEN("that node goes with the heavy side") {
+      const auto& c = communities.community;
+      /* nodes are a, b, c, m, x, y, z */
+      REQUIRE(c[3] == c[4]);
+      REQUIRE(c[0] != c[3]);
+    }
+  }
+  GIVEN("random graphs with planted communities") {
+    std::mt19937 rng{5};
+    for (int trial = 0; trial < 5; ++trial) {
+      const int n = 200;
+      const int group_size = 20;
+      gdwg::Graph<int, double> g{};
+      std::vector<std::uint32_t> planted(n);
+      for (int v = 0; v < n; ++v) {
+        g.InsertNode(v);
+        planted[static_cast<std::size_t>(v)] = static_cast<std::uint32_t>(v / group_size);
+      }
+      for (int e = 0; e < 1600; ++e) {
+        const auto a = static_cast<int>(rng() % n);
+        const auto b = rng() % 10 == 0 ? static_cast<int>(rng() % n)
+                                       : a / group_size * group_size +
+                                             static_cast<int>(rng() % group_size);
+        g.InsertEdge(a, b, 1.0 + static_cast<double>(rng() % 3));
+      }
+      gdwg::ThreadPool pool{2};
+      const auto louvain = gdwg::Louvain(g, pool);
+      const auto lpa = gdwg::LabelPropagation(g, pool);
+      const auto planted_q = gdwg::Modularity(gdwg::CsrSnapshot<int, double>{g}, planted);
+      THEN("Louvain does about as well as the planted communities, and LPA finds structure") {
+        REQUIRE(louvain.modularity >= planted_q - 0.02);
+        REQUIRE(lpa.modularity > 0.5);
+        REQUIRE(louvain.num_communities <= 30);
+      }
+    }
+  }
+}
+
+SCENARIO("LabelPropagation") {
+  GIVEN("a chain of cliques") {
+    const auto g = Cliques(20, 8);
+    gdwg::ThreadPool pool{3};
+    const auto communities = gdwg::LabelPropagation(g, pool);
+    THEN("each clique ends up with one label of its own") {
+      REQUIRE(communities.num_communities == 20);
+      for (std::size_t v = 0; v < communities.nodes.size(); ++v) {
+        REQUIRE(communities.community[v] == v / 8);
+      }
+      REQUIRE(communities.levels == 0);
+      REQUIRE(communities.modularity > 0.8);
+    }
+  }
+  GIVEN("nodes without edges, and no nodes at all") {
+    gdwg::Graph<int, double> g{1, 2, 3};
+    THEN("every node is alone") {
+      for (const auto& communities : {gdwg::LabelPropagation(g), gdwg::Louvain(g)}) {
+        REQUIRE(communities.num_communities == 3);
+        REQUIRE(communities.community == std::vector<std::uint32_t>{0, 1, 2});
+        REQUIRE(communities.modularity == 0.0);
+      }
+      REQUIRE(gdwg::Louvain(gdwg::Graph<int, double>{}).num_communities == 0);
+      REQUIRE(gdwg::LabelPropagation(gdwg::Graph<int, double>{}).community.empty());
+    }
+  }
+}
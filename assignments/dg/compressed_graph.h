@@ -0,0 +1,132 @@
+#ifndef ASSIGNMENTS_DG_COMPRESSED_GRAPH_H_
+#define ASSIGNMENTS_DG_COMPRESSED_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/varint.h"
+
+namespace gdwg {
+
+/* a read-only, compressed copy of the topology of a Graph. Nodes are given dense
+ * ids (their rank in the sorted node order) and each node's sorted, de-duplicated
+ * neighbour ids are stored as a varint encoded stream of deltas. Every kBlockSize
+ * neighbours the stream restarts with an absolute id, and a skip entry records that
+ * id and its byte offset so a lookup only has to decode a single block.
+ * Edge weights are not kept, so GetWeights etc. still have to go to the Graph */
+template <typename N, typename E>
+class CompressedGraph {
+ public:
+  using node_id = std::uint32_t;
+  /* number of neighbours per independently decodable block */
+  static constexpr std::size_t kBlockSize = 64;
+
+  /* decodes one node's neighbour ids on the fly, one varint per increment */
+  class neighbour_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = node_id;
+    using reference = node_id;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+
+    /* a default constructed iterator is the end of any node's neighbours */
+    neighbour_iterator() = default;
+
+    reference operator*() const { return current_; }
+    neighbour_iterator& operator++();
+    neighbour_iterator operator++(int) {
+      auto copy{*this};
+      ++(*this);
+      return copy;
+    }
+
+    /* two iterators over the same node are equal if they are up to the same neighbour */
+    friend bool operator==(const neighbour_iterator& lhs, const neighbour_iterator& rhs) {
+      return lhs.remaining_ == rhs.remaining_;
+    }
+    friend bool operator!=(const neighbour_iterator& lhs, const neighbour_iterator& rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    const std::uint8_t* pos_{nullptr};
+    std::size_t remaining_{0};  // neighbours left including current_
+    std::size_t index_{0};      // position of current_ in the node's list
+    node_id current_{0};
+
+    friend class CompressedGraph;
+    /* pos must point at the start of a block, i.e. index is a multiple of kBlockSize */
+    neighbour_iterator(const std::uint8_t* pos, std::size_t remaining, std::size_t index);
+  };
+
+  /* a begin/end pair so a node's neighbours can be used in a range-for */
+  class neighbour_range {
+   public:
+    neighbour_iterator begin() const { return begin_; }
+    neighbour_iterator end() const { return end_; }
+    std::size_t size() const { return size_; }
+
+   private:
+    neighbour_iterator begin_;
+    neighbour_iterator end_;
+    std::size_t size_;
+
+    friend class CompressedGraph;
+    neighbour_range(neighbour_iterator b, neighbour_iterator e, std::size_t size)
+      : begin_{b}, end_{e}, size_{size} {}
+  };
+
+  /* ctors */
+  explicit CompressedGraph(const gdwg::Graph<N, E>& g);
+
+  /* methods */
+  std::size_t NumNodes() const { return nodes_.size(); }
+  std::size_t NumEdges() const { return num_edges_; }
+  bool IsNode(const N& val) const;
+  /* throws std::runtime_error if src or dst doesn't exist, like Graph::IsConnected */
+  bool IsConnected(const N& src, const N& dst) const;
+  bool IsConnected(node_id src, node_id dst) const;
+  /* throws std::out_of_range if src doesn't exist, like Graph::GetConnected */
+  std::vector<N> GetConnected(const N& src) const;
+  const std::vector<N>& GetNodes() const { return nodes_; }
+  /* id <-> value conversion. Id throws std::out_of_range for unknown values */
+  node_id Id(const N& val) const;
+  const N& Value(node_id id) const { return nodes_[id]; }
+  std::size_t Degree(node_id id) const { return degrees_[id]; }
+  neighbour_range Neighbours(node_id id) const;
+
+  /* size reporting. AdjacencyBytes only counts the encoded neighbour data
+   * and the per node/per block indexes, not the node values */
+  std::size_t AdjacencyBytes() const;
+  double BytesPerEdge() const;
+
+ private:
+  struct Skip {
+    node_id first_;         // absolute id the block starts with
+    std::uint32_t offset_;  // byte offset of the block from the node's start
+  };
+
+  void Append(const std::vector<node_id>& neighbours);
+  std::size_t FindNode(const N& val) const;
+
+  std::vector<N> nodes_;
+  /* byte stream start for each node, plus one past the end */
+  std::vector<std::uint64_t> offsets_;
+  std::vector<std::uint32_t> degrees_;
+  /* index of each node's first skip entry, plus one past the end */
+  std::vector<std::uint32_t> skip_begin_;
+  std::vector<Skip> skips_;
+  std::vector<std::uint8_t> bytes_;
+  std::size_t num_edges_{0};
+};
+
+}  // namespace gdwg
+
+#include "assignments/dg/compressed_graph.tpp"
+
+#endif  // ASSIGNMENTS_DG_COMPRESSED_GRAPH_H_
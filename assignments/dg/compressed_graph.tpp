@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+template <typename N, typename E>
+gdwg::CompressedGraph<N, E>::CompressedGraph(const gdwg::Graph<N, E>& g) : nodes_{g.GetNodes()} {
+  offsets_.reserve(nodes_.size() + 1);
+  degrees_.reserve(nodes_.size());
+  skip_begin_.reserve(nodes_.size() + 1);
+
+  /* edges come out of the graph ordered by src then dst, and node ids are just
+   * the rank of the value, so every node's neighbours arrive already sorted and
+   * we can encode them in a single pass */
+  std::vector<node_id> neighbours{};
+  node_id src = 0;
+  for (const auto& [from, to, weight] : g) {
+    static_cast<void>(weight);
+    const auto from_id = static_cast<node_id>(FindNode(from));
+    /* flush every node up to (but not including) the new src */
+    for (; src < from_id; ++src) {
+      Append(neighbours);
+      neighbours.clear();
+    }
+    const auto to_id = static_cast<node_id>(FindNode(to));
+    /* parallel edges with different weights only connect the nodes once */
+    if (neighbours.empty() || neighbours.back() != to_id)
+      neighbours.push_back(to_id);
+  }
+  for (; src < nodes_.size(); ++src) {
+    Append(neighbours);
+    neighbours.clear();
+  }
+  offsets_.push_back(bytes_.size());
+  skip_begin_.push_back(static_cast<std::uint32_t>(skips_.size()));
+  bytes_.shrink_to_fit();
+  skips_.shrink_to_fit();
+}
+
+template <typename N, typename E>
+void gdwg::CompressedGraph<N, E>::Append(const std::vector<node_id>& neighbours) {
+  const auto start = bytes_.size();
+  offsets_.push_back(start);
+  degrees_.push_back(static_cast<std::uint32_t>(neighbours.size()));
+  skip_begin_.push_back(static_cast<std::uint32_t>(skips_.size()));
+  for (std::size_t i = 0; i < neighbours.size(); ++i) {
+    if (i % kBlockSize == 0) {
+      /* start of a block: record a skip entry and restart from an absolute id */
+      skips_.push_back({neighbours[i], static_cast<std::uint32_t>(bytes_.size() - start)});
+      detail::PutVarint(bytes_, neighbours[i]);
+    } else {
+      detail::PutVarint(bytes_, neighbours[i] - neighbours[i - 1]);
+    }
+  }
+  num_edges_ += neighbours.size();
+}
+
+template <typename N, typename E>
+std::size_t gdwg::CompressedGraph<N, E>::FindNode(const N& val) const {
+  /* ids are value ranks, so there is no ValueOrder to pass */
+  return detail::FindNode(nodes_, {}, val);
+}
+
+template <typename N, typename E>
+bool gdwg::CompressedGraph<N, E>::IsNode(const N& val) const {
+  return FindNode(val) != nodes_.size();
+}
+
+template <typename N, typename E>
+typename gdwg::CompressedGraph<N, E>::node_id gdwg::CompressedGraph<N, E>::Id(const N& val) const {
+  auto idx = FindNode(val);
+  if (idx == nodes_.size()) {
+    throw std::out_of_range("Cannot call CompressedGraph::Id on a node that doesn't exist");
+  }
+  return static_cast<node_id>(idx);
+}
+
+template <typename N, typename E>
+bool gdwg::CompressedGraph<N, E>::IsConnected(const N& src, const N& dst) const {
+  auto src_idx = FindNode(src);
+  auto dst_idx = FindNode(dst);
+  if (src_idx == nodes_.size() || dst_idx == nodes_.size()) {
+    throw std::runtime_error(
+        "Cannot call CompressedGraph::IsConnected if src or dst node don't exist in the graph");
+  }
+  return IsConnected(static_cast<node_id>(src_idx), static_cast<node_id>(dst_idx));
+}
+
+template <typename N, typename E>
+bool gdwg::CompressedGraph<N, E>::IsConnected(node_id src, node_id dst) const {
+  const auto skips_b = skips_.begin() + skip_begin_[src];
+  const auto skips_e = skips_.begin() + skip_begin_[src + 1];
+  /* find the last block whose first id is <= dst, nothing before it can match */
+  auto skip_it = std::upper_bound(skips_b, skips_e, dst,
+                                  [](node_id v, const Skip& s) { return v < s.first_; });
+  if (skip_it == skips_b)
+    return false;
+  --skip_it;
+  /* and then decode just that one block */
+  const auto block = static_cast<std::size_t>(skip_it - skips_b);
+  const auto index = block * kBlockSize;
+  const auto in_block = std::min<std::size_t>(kBlockSize, degrees_[src] - index);
+  neighbour_iterator it{bytes_.data() + offsets_[src] + skip_it->offset_, in_block, index};
+  for (neighbour_iterator end{}; it != end && *it <= dst; ++it) {
+    if (*it == dst)
+      return true;
+  }
+  return false;
+}
+
+template <typename N, typename E>
+std::vector<N> gdwg::CompressedGraph<N, E>::GetConnected(const N& src) const {
+  auto src_idx = FindNode(src);
+  if (src_idx == nodes_.size()) {
+    throw std::out_of_range(
+        "Cannot call CompressedGraph::GetConnected if src doesn't exist in the graph");
+  }
+  std::vector<N> connected{};
+  connected.reserve(degrees_[src_idx]);
+  for (auto id : Neighbours(static_cast<node_id>(src_idx))) {
+    connected.push_back(nodes_[id]);
+  }
+  return connected;
+}
+
+template <typename N, typename E>
+typename gdwg::CompressedGraph<N, E>::neighbour_range
+gdwg::CompressedGraph<N, E>::Neighbours(node_id id) const {
+  return {neighbour_iterator{bytes_.data() + offsets_[id], degrees_[id], 0}, neighbour_iterator{},
+          degrees_[id]};
+}
+
+template <typename N, typename E>
+std::size_t gdwg::CompressedGraph<N, E>::AdjacencyBytes() const {
+  return bytes_.size() * sizeof(std::uint8_t) + offsets_.size() * sizeof(std::uint64_t) +
+         degrees_.size() * sizeof(std::uint32_t) + skip_begin_.size() * sizeof(std::uint32_t) +
+         skips_.size() * sizeof(Skip);
+}
+
+template <typename N, typename E>
+double gdwg::CompressedGraph<N, E>::BytesPerEdge() const {
+  if (num_edges_ == 0)
+    return 0.0;
+  return static_cast<double>(AdjacencyBytes()) / static_cast<double>(num_edges_);
+}
+
+template <typename N, typename E>
+gdwg::CompressedGraph<N, E>::neighbour_iterator::neighbour_iterator(const std::uint8_t* pos,
+                                                                    std::size_t remaining,
+                                                                    std::size_t index)
+  : pos_{pos}, remaining_{remaining}, index_{index} {
+  if (remaining_ > 0)
+    current_ = static_cast<std::uint32_t>(detail::GetVarint(pos_));
+}
+
+template <typename N, typename E>
+typename gdwg::CompressedGraph<N, E>::neighbour_iterator&
+gdwg::CompressedGraph<N, E>::neighbour_iterator::operator++() {
+  --remaining_;
+  ++index_;
+  if (remaining_ == 0)
+    return *this;
+  /* blocks restart with an absolute id, everything else is a delta */
+  const auto v = static_cast<std::uint32_t>(detail::GetVarint(pos_));
+  current_ = index_ % kBlockSize == 0 ? v : current_ + v;
+  return *this;
+}
@@ -0,0 +1,96 @@
+#include "assignments/dg/compressed_graph.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+SCENARIO("compressing a small graph") {
+  GIVEN("a graph with parallel edges, a reflexive edge and an isolated node") {
+    std::vector<std::tuple<char, char, int>> edges{
+        {'a', 'b', 1}, {'a', 'b', 2}, {'a', 'c', 3}, {'c', 'a', 4}, {'c', 'c', 5}};
+    gdwg::Graph<char, int> g{edges.begin(), edges.end()};
+    g.InsertNode('d');
+    gdwg::CompressedGraph<char, int> cg{g};
+    THEN("it has the same nodes, and parallel edges only count once") {
+      REQUIRE(cg.GetNodes() == g.GetNodes());
+      REQUIRE(cg.NumNodes() == 4);
+      REQUIRE(cg.NumEdges() == 4);
+    }
+    THEN("connectivity queries agree with the graph") {
+      for (auto src : g.GetNodes()) {
+        REQUIRE(cg.GetConnected(src) == g.GetConnected(src));
+        for (auto dst : g.GetNodes()) {
+          REQUIRE(cg.IsConnected(src, dst) == g.IsConnected(src, dst));
+        }
+      }
+    }
+    THEN("querying nodes that don't exist throws like the graph does") {
+      REQUIRE_THROWS_WITH(
+          cg.IsConnected('a', 'z'),
+          "Cannot call CompressedGraph::IsConnected if src or dst node don't exist in the graph");
+      REQUIRE_THROWS_AS(cg.GetConnected('z'), std::out_of_range);
+      REQUIRE_THROWS_AS(cg.Id('z'), std::out_of_range);
+    }
+  }
+}
+
+SCENARIO("compressing a node with many blocks of neighbours") {
+  GIVEN("a hub connected to every third node of a large graph") {
+    gdwg::Graph<int, double> g{};
+    for (int i = 0; i < 1000; ++i) {
+      g.InsertNode(i);
+    }
+    for (int i = 0; i < 1000; i += 3) {
+      g.InsertEdge(0, i, 1.0);
+    }
+    gdwg::CompressedGraph<int, double> cg{g};
+    THEN("lookups that land in every block are answered correctly") {
+      for (int i = 0; i < 1000; ++i) {
+        REQUIRE(cg.IsConnected(0, i) == (i % 3 == 0));
+      }
+    }
+    THEN("iterating the neighbours decodes them all in order") {
+      std::vector<int> decoded{};
+      for (auto id : cg.Neighbours(cg.Id(0))) {
+        decoded.push_back(cg.Value(id));
+      }
+      REQUIRE(decoded == g.GetConnected(0));
+      REQUIRE(cg.Degree(cg.Id(0)) == decoded.size());
+    }
+  }
+}
+
+SCENARIO("compressing a dense graph") {
+  GIVEN("a graph where every node is connected to its next 50 nodes") {
+    gdwg::Graph<int, int> g{};
+    for (int i = 0; i < 200; ++i) {
+      g.InsertNode(i);
+    }
+    for (int i = 0; i < 200; ++i) {
+      for (int j = 1; j <= 50; ++j) {
+        g.InsertEdge(i, (i + j) % 200, j);
+      }
+    }
+    gdwg::CompressedGraph<int, int> cg{g};
+    THEN("it takes less space than a plain offset per node and id per edge") {
+      REQUIRE(cg.NumEdges() == 200 * 50);
+      REQUIRE(cg.BytesPerEdge() > 0.0);
+      REQUIRE(cg.AdjacencyBytes() <
+              cg.NumNodes() * sizeof(std::uint64_t) + cg.NumEdges() * sizeof(std::uint32_t));
+    }
+  }
+}
+
+SCENARIO("compressing an empty graph") {
+  gdwg::Graph<std::string, int> g{};
+  gdwg::CompressedGraph<std::string, int> cg{g};
+  REQUIRE(cg.NumNodes() == 0);
+  REQUIRE(cg.NumEdges() == 0);
+  REQUIRE(cg.BytesPerEdge() == 0.0);
+  REQUIRE(cg.IsNode("a") == false);
+}
@@ -0,0 +1,109 @@
+#ifndef ASSIGNMENTS_DG_CONTRACTION_HIERARCHY_H_
+#define ASSIGNMENTS_DG_CONTRACTION_HIERARCHY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/point_to_point.h"
+#include "assignments/dg/thread_pool.h"
+
+namespace gdwg {
+
+/* a contraction hierarchy: an index over a graph's (non negative) edge weights
+ * that answers shortest path queries by only ever searching "upwards".
+ * Building it removes (contracts) the nodes one at a time, least important
+ * first, and whenever removing x would break the shortest path u -> x -> v it
+ * adds a shortcut u -> v. Every node then keeps its arcs to the nodes contracted
+ * after it: up arcs for the forward search and down arcs (stored at their
+ * lower end) for the backward one. A query runs Dijkstra up from src and up
+ * the reversed down arcs from dst, and the shortest path meets at its highest
+ * node, so both searches only see a small part of the graph. Each search also
+ * stalls a node (doesn't relax its arcs) when a higher node it has reached has
+ * a shorter way down to it, since then no shortest path goes up through it
+ * (stall on demand). Shortcuts remember the node they skip, so paths are
+ * unpacked back into graph edges.
+ *
+ * Nodes are contracted in rounds. Each round scores every node whose
+ * neighbourhood changed by simulating its contraction (twice the shortcuts it
+ * would add less the arcs it would remove, plus its level: how deep the
+ * contractions around it already go), picks the nodes that score lower than
+ * all of their neighbours (no two of which are adjacent, so they can go at
+ * once), and contracts them. The scoring and the witness searches (a bounded
+ * Dijkstra looking for a path that makes a shortcut unnecessary) run in
+ * parallel on the pool. Witness searches give up after a few hundred nodes,
+ * which can only add shortcuts that weren't needed, never lose a path */
+template <typename N, typename E>
+class ContractionHierarchy {
+ public:
+  using node_id = std::uint32_t;
+
+  /* ctors. Throw std::domain_error if any weight is negative */
+  explicit ContractionHierarchy(const CsrSnapshot<N, E>& g,
+                                ThreadPool& pool = ThreadPool::Default());
+  explicit ContractionHierarchy(const Graph<N, E>& g, ThreadPool& pool = ThreadPool::Default())
+    : ContractionHierarchy(CsrSnapshot<N, E>{g}, pool) {}
+
+  /* methods */
+  /* the shortest path from src to dst, in graph nodes. Throws std::out_of_range
+   * if either isn't a node. Like PathFinder, queries reuse this thread's search
+   * state, and the out-parameter version also reuses out.nodes' storage */
+  ShortestPath<N, E> Query(const N& src, const N& dst) const;
+  void Query(const N& src, const N& dst, ShortestPath<N, E>& out) const;
+
+  std::size_t NumNodes() const { return nodes_.size(); }
+  /* up and down arcs, counting shortcuts */
+  std::size_t NumArcs() const { return up_.targets.size() + down_.targets.size(); }
+  std::size_t NumShortcuts() const;
+  /* the order nodes were contracted in: 0 first */
+  std::uint32_t Rank(const N& val) const { return rank_[Id(val)]; }
+
+  /* the index in the same value encoding as EncodePatch (graph_patch.h), so it
+   * can be built once and loaded by every process that queries it */
+  std::vector<std::uint8_t> Serialize() const;
+  /* throws std::invalid_argument if the bytes aren't a serialized hierarchy:
+   * besides the layout, the ranks have to be a permutation, every arc has to go
+   * up in rank, no weight can be negative, and every shortcut has to skip a node
+   * ranked below both its ends, with both of the arcs it stands for there */
+  static ContractionHierarchy Deserialize(const std::vector<std::uint8_t>& bytes);
+
+ private:
+  static constexpr node_id kNoVia = static_cast<node_id>(-1);
+  static constexpr std::size_t kNoArc = static_cast<std::size_t>(-1);
+
+  /* arcs by node, like CsrSnapshot. Each node's arcs are sorted by target, and
+   * via is the node a shortcut skips (kNoVia for an edge of the graph) */
+  struct ArcLists {
+    std::vector<std::size_t> offsets;
+    std::vector<node_id> targets;
+    std::vector<E> weights;
+    std::vector<node_id> via;
+  };
+
+  ContractionHierarchy() = default;
+
+  node_id Id(const N& val) const;
+  /* the arc a -> b, which is stored as an up arc of a if a was contracted first,
+   * and as a down arc of b otherwise. kNoArc if there isn't one */
+  std::size_t FindArc(node_id a, node_id b, const ArcLists*& lists) const;
+  /* appends the graph nodes after a on the way to b, last first if reversed */
+  void Unpack(node_id a, node_id b, bool reversed, std::vector<N>& out) const;
+
+  /* in the snapshot's id order, which needn't be value order (see
+   * detail::ValueOrder) */
+  std::vector<N> nodes_;
+  std::vector<node_id> by_value_;
+  std::vector<std::uint32_t> rank_;
+  ArcLists up_;
+  /* down_ lists, at each node v, the arcs u -> v from nodes contracted after v,
+   * with u in targets */
+  ArcLists down_;
+};
+
+}  // namespace gdwg
+
+#include "assignments/dg/contraction_hierarchy.tpp"
+
+#endif  // ASSIGNMENTS_DG_CONTRACTION_HIERARCHY_H_
@@ -0,0 +1,522 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/graph_patch.h"
+
+namespace gdwg {
+namespace detail {
+
+/* an arc between two nodes that haven't been contracted yet */
+template <typename E>
+struct OverlayArc {
+  std::uint32_t node;
+  E weight;
+  std::uint32_t via;
+};
+
+template <typename E>
+using Overlay = std::vector<std::vector<OverlayArc<E>>>;
+
+template <typename E>
+struct Shortcut {
+  std::uint32_t src;
+  std::uint32_t dst;
+  E weight;
+};
+
+/* bumped whenever the serialized layout changes */
+constexpr std::uint8_t kHierarchyFormat = 1;
+/* how many nodes a witness search may settle before giving up, when contracting
+ * a node and when only estimating how many shortcuts that would need */
+constexpr std::size_t kWitnessLimit = 500;
+constexpr std::size_t kEstimateLimit = 20;
+
+/* the shortcuts contracting x needs: for each in-arc u -> x, a bounded Dijkstra
+ * from u that never enters x or a node marked in skip looks for paths to x's
+ * out-neighbours v that are no longer than u -> x -> v. The backward side's
+ * stamps mark the vs still to be settled, so the search stops once it has them
+ * all */
+template <typename E>
+void FindShortcuts(std::uint32_t x,
+                   const Overlay<E>& out,
+                   const Overlay<E>& in,
+                   const std::vector<std::uint8_t>& skip,
+                   std::size_t settle_limit,
+                   std::vector<Shortcut<E>>& shortcuts) {
+  auto& state = ThreadSearchState<E>();
+  auto& side = state.Forward();
+  auto& targets = state.Backward();
+  for (const auto& in_arc : in[x]) {
+    const auto u = in_arc.node;
+    state.Begin(out.size());
+    /* nothing further than the longest path through x can matter */
+    std::size_t num_targets = 0;
+    E limit{};
+    for (const auto& out_arc : out[x]) {
+      if (out_arc.node == u)
+        continue;
+      if (num_targets == 0 || limit < in_arc.weight + out_arc.weight)
+        limit = in_arc.weight + out_arc.weight;
+      state.Set(targets, out_arc.node, E{}, x);
+      ++num_targets;
+    }
+    if (num_targets == 0)
+      continue;
+
+    state.Set(side, u, E{}, u);
+    side.heap.PushOrDecrease(u, E{});
+    for (std::size_t settled = 0; settled < settle_limit && !side.heap.Empty(); ++settled) {
+      const auto w = side.heap.Pop();
+      if (limit < side.dist[w])
+        break;
+      if (state.Seen(targets, w) && --num_targets == 0)
+        break;
+      for (const auto& arc : out[w]) {
+        if (arc.node == x || skip[arc.node])
+          continue;
+        const E dist = side.dist[w] + arc.weight;
+        if (state.Seen(side, arc.node) && !(dist < side.dist[arc.node]))
+          continue;
+        state.Set(side, arc.node, dist, w);
+        side.heap.PushOrDecrease(arc.node, dist);
+      }
+    }
+    /* any path the search found is a real one, even if it stopped early */
+    for (const auto& out_arc : out[x]) {
+      const auto v = out_arc.node;
+      const E through = in_arc.weight + out_arc.weight;
+      if (v != u && !(state.Seen(side, v) && !(through < side.dist[v])))
+        shortcuts.push_back({u, v, through});
+    }
+  }
+}
+
+/* sets the arc to node in arcs to weight (via via), unless it is already lighter */
+template <typename E>
+void AddArc(std::vector<OverlayArc<E>>& arcs,
+            std::uint32_t node,
+            const E& weight,
+            std::uint32_t via) {
+  for (auto& arc : arcs) {
+    if (arc.node == node) {
+      if (weight < arc.weight)
+        arc = {node, weight, via};
+      return;
+    }
+  }
+  arcs.push_back({node, weight, via});
+}
+
+template <typename E>
+void RemoveArc(std::vector<OverlayArc<E>>& arcs, std::uint32_t node) {
+  for (auto& arc : arcs) {
+    if (arc.node == node) {
+      arc = arcs.back();
+      arcs.pop_back();
+      return;
+    }
+  }
+}
+
+/* runs func(i) for i in [0, n) on pool, in a few chunks per thread */
+template <typename F>
+void ParallelChunks(std::size_t n, ThreadPool& pool, F func) {
+  const auto num_chunks = std::min(n, 8 * (pool.Size() + 1));
+  pool.ParallelFor(num_chunks, [&](std::size_t chunk) {
+    for (auto i = n * chunk / num_chunks; i < n * (chunk + 1) / num_chunks; ++i) {
+      func(i);
+    }
+  });
+}
+
+}  // namespace detail
+}  // namespace gdwg
+
+template <typename N, typename E>
+gdwg::ContractionHierarchy<N, E>::ContractionHierarchy(const CsrSnapshot<N, E>& g,
+                                                       ThreadPool& pool)
+  : nodes_{g.Nodes()}, rank_(g.NumNodes(), 0) {
+  for (const auto& w : g.Weights()) {
+    if (w < E{}) {
+      throw std::domain_error(
+          "Cannot make a ContractionHierarchy for a graph with negative weights");
+    }
+  }
+  by_value_ = detail::ValueOrder(nodes_);
+  const auto n = g.NumNodes();
+
+  /* the graph still being contracted, without reflexive edges and with only the
+   * lightest of any parallel edges */
+  detail::Overlay<E> out(n);
+  detail::Overlay<E> in(n);
+  for (node_id u = 0; u < n; ++u) {
+    for (auto e = g.Offsets()[u]; e < g.Offsets()[u + 1]; ++e) {
+      const auto v = g.Targets()[e];
+      if (v == u)
+        continue;
+      if (!out[u].empty() && out[u].back().node == v) {
+        out[u].back().weight = std::min(out[u].back().weight, g.Weights()[e]);
+      } else {
+        out[u].push_back({v, g.Weights()[e], kNoVia});
+      }
+    }
+    for (const auto& arc : out[u]) {
+      in[arc.node].push_back({u, arc.weight, kNoVia});
+    }
+  }
+
+  detail::Overlay<E> up(n);
+  detail::Overlay<E> down(n);
+  std::vector<std::int64_t> priority(n, 0);
+  /* one more than the highest level among a node's contracted neighbours, so
+   * nodes contracted on top of each other are put off, and the hierarchy stays
+   * shallow */
+  std::vector<std::int64_t> level(n, 0);
+  std::vector<std::uint8_t> dirty(n, 1);
+  std::vector<std::uint8_t> in_round(n, 0);
+  std::vector<node_id> remaining(n);
+  std::iota(remaining.begin(), remaining.end(), 0);
+  /* ties are broken by a scrambled id (odd multipliers are a bijection), so
+   * neighbouring ids don't all lose to each other */
+  auto before = [&priority](node_id a, node_id b) {
+    return priority[a] < priority[b] ||
+           (priority[a] == priority[b] && a * 2654435761u < b * 2654435761u);
+  };
+  std::uint32_t next_rank = 0;
+  while (!remaining.empty()) {
+    /* rescore the nodes whose neighbourhood changed last round */
+    detail::ParallelChunks(remaining.size(), pool, [&](std::size_t i) {
+      const auto x = remaining[i];
+      if (!dirty[x])
+        return;
+      std::vector<detail::Shortcut<E>> shortcuts{};
+      detail::FindShortcuts(x, out, in, in_round, detail::kEstimateLimit, shortcuts);
+      priority[x] = 2 * (static_cast<std::int64_t>(shortcuts.size()) -
+                         static_cast<std::int64_t>(in[x].size() + out[x].size())) +
+                    level[x];
+      dirty[x] = 0;
+    });
+
+    /* contract every node that scores lower than all of its neighbours. The
+     * lowest scoring node always does, so every round makes progress */
+    detail::ParallelChunks(remaining.size(), pool, [&](std::size_t i) {
+      const auto x = remaining[i];
+      auto lowest = [&](const auto& arcs) {
+        return std::all_of(arcs.begin(), arcs.end(),
+                           [&](const auto& arc) { return before(x, arc.node); });
+      };
+      in_round[x] = lowest(out[x]) && lowest(in[x]);
+    });
+    std::vector<node_id> round{};
+    for (auto x : remaining) {
+      if (in_round[x])
+        round.push_back(x);
+    }
+    /* witness searches skip the whole round, since it all goes at once */
+    std::vector<std::vector<detail::Shortcut<E>>> shortcuts(round.size());
+    detail::ParallelChunks(round.size(), pool, [&](std::size_t i) {
+      detail::FindShortcuts(round[i], out, in, in_round, detail::kWitnessLimit, shortcuts[i]);
+    });
+
+    for (std::size_t i = 0; i < round.size(); ++i) {
+      const auto x = round[i];
+      rank_[x] = next_rank++;
+      up[x] = std::move(out[x]);
+      down[x] = std::move(in[x]);
+      out[x].clear();
+      in[x].clear();
+      for (const auto& arc : up[x]) {
+        detail::RemoveArc(in[arc.node], x);
+        dirty[arc.node] = 1;
+        level[arc.node] = std::max(level[arc.node], level[x] + 1);
+      }
+      for (const auto& arc : down[x]) {
+        detail::RemoveArc(out[arc.node], x);
+        dirty[arc.node] = 1;
+        level[arc.node] = std::max(level[arc.node], level[x] + 1);
+      }
+      for (const auto& shortcut : shortcuts[i]) {
+        detail::AddArc(out[shortcut.src], shortcut.dst, shortcut.weight, x);
+        detail::AddArc(in[shortcut.dst], shortcut.src, shortcut.weight, x);
+      }
+    }
+    remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                   [&](node_id x) { return in_round[x]; }),
+                    remaining.end());
+    for (auto x : round) {
+      in_round[x] = 0;
+    }
+  }
+
+  /* flatten into sorted CSR arc lists */
+  for (auto [lists, arcs] : {std::make_pair(&up_, &up), std::make_pair(&down_, &down)}) {
+    lists->offsets.assign(1, 0);
+    for (node_id x = 0; x < n; ++x) {
+      auto& node_arcs = (*arcs)[x];
+      std::sort(node_arcs.begin(), node_arcs.end(),
+                [](const auto& a, const auto& b) { return a.node < b.node; });
+      for (const auto& arc : node_arcs) {
+        lists->targets.push_back(arc.node);
+        lists->weights.push_back(arc.weight);
+        lists->via.push_back(arc.via);
+      }
+      lists->offsets.push_back(lists->targets.size());
+    }
+  }
+}
+
+template <typename N, typename E>
+typename gdwg::ContractionHierarchy<N, E>::node_id
+gdwg::ContractionHierarchy<N, E>::Id(const N& val) const {
+  const auto id = detail::FindNode(nodes_, by_value_, val);
+  if (id == nodes_.size()) {
+    throw std::out_of_range("Cannot call ContractionHierarchy::Query on a node that doesn't exist");
+  }
+  return id;
+}
+
+template <typename N, typename E>
+gdwg::ShortestPath<N, E> gdwg::ContractionHierarchy<N, E>::Query(const N& src,
+                                                                 const N& dst) const {
+  ShortestPath<N, E> out{};
+  Query(src, dst, out);
+  return out;
+}
+
+template <typename N, typename E>
+void gdwg::ContractionHierarchy<N, E>::Query(const N& src,
+                                             const N& dst,
+                                             ShortestPath<N, E>& out) const {
+  const auto s = Id(src);
+  const auto t = Id(dst);
+  auto& state = detail::ThreadSearchState<E>();
+  state.Begin(NumNodes());
+  auto& fwd = state.Forward();
+  auto& bwd = state.Backward();
+  state.Set(fwd, s, E{}, s);
+  state.Set(bwd, t, E{}, t);
+  fwd.heap.PushOrDecrease(s, E{});
+  bwd.heap.PushOrDecrease(t, E{});
+
+  bool found = s == t;
+  E best{};
+  node_id meet = s;
+  /* a side is finished once it is empty or can't improve on best. Unlike plain
+   * bidirectional Dijkstra, neither can stop the other early, since the best
+   * path meets at its highest node and either side may still have to get there */
+  auto live = [&](const auto& side) {
+    return !side.heap.Empty() && !(found && !(side.heap.KeyOf(side.heap.Top()) < best));
+  };
+  while (true) {
+    const bool fwd_live = live(fwd);
+    const bool bwd_live = live(bwd);
+    if (!fwd_live && !bwd_live)
+      break;
+    const bool go_forward = fwd_live && (!bwd_live || !(bwd.heap.KeyOf(bwd.heap.Top()) <
+                                                        fwd.heap.KeyOf(fwd.heap.Top())));
+    auto& side = go_forward ? fwd : bwd;
+    auto& other = go_forward ? bwd : fwd;
+    const auto& lists = go_forward ? up_ : down_;
+    const auto u = side.heap.Pop();
+    /* stall on demand: if this side has reached a higher node v and the arc
+     * between v and u (which this side never relaxes, as it goes downwards)
+     * makes u nearer than it was settled at, u isn't on any shortest path up
+     * from here, so its arcs aren't worth relaxing */
+    const auto& downwards = go_forward ? down_ : up_;
+    bool stalled = false;
+    for (auto e = downwards.offsets[u]; e < downwards.offsets[u + 1] && !stalled; ++e) {
+      const auto v = downwards.targets[e];
+      stalled = state.Seen(side, v) && side.dist[v] + downwards.weights[e] < side.dist[u];
+    }
+    if (stalled)
+      continue;
+    for (auto e = lists.offsets[u]; e < lists.offsets[u + 1]; ++e) {
+      const auto v = lists.targets[e];
+      const E dist = side.dist[u] + lists.weights[e];
+      if (state.Seen(side, v) && !(dist < side.dist[v]))
+        continue;
+      state.Set(side, v, dist, u);
+      side.heap.PushOrDecrease(v, dist);
+      if (state.Seen(other, v) && (!found || dist + other.dist[v] < best)) {
+        found = true;
+        best = dist + other.dist[v];
+        meet = v;
+      }
+    }
+  }
+
+  out.found = found;
+  out.distance = best;
+  out.nodes.clear();
+  if (!found)
+    return;
+  /* the hierarchy's path is s ... meet along forward parents, then meet ... t
+   * along backward ones. The forward half is walked from meet, so it is
+   * unpacked back to front and flipped */
+  for (auto v = meet; v != s; v = fwd.parent[v]) {
+    Unpack(fwd.parent[v], v, true, out.nodes);
+  }
+  out.nodes.push_back(nodes_[s]);
+  std::reverse(out.nodes.begin(), out.nodes.end());
+  for (auto v = meet; v != t; v = bwd.parent[v]) {
+    Unpack(v, bwd.parent[v], false, out.nodes);
+  }
+}
+
+template <typename N, typename E>
+std::size_t gdwg::ContractionHierarchy<N, E>::FindArc(node_id a,
+                                                      node_id b,
+                                                      const ArcLists*& lists) const {
+  const bool is_up = rank_[a] < rank_[b];
+  lists = is_up ? &up_ : &down_;
+  const auto owner = is_up ? a : b;
+  const auto first = lists->targets.begin() + static_cast<std::ptrdiff_t>(lists->offsets[owner]);
+  const auto last = lists->targets.begin() + static_cast<std::ptrdiff_t>(lists->offsets[owner + 1]);
+  const auto target = is_up ? b : a;
+  const auto it = std::lower_bound(first, last, target);
+  if (it == last || *it != target)
+    return kNoArc;
+  return static_cast<std::size_t>(it - lists->targets.begin());
+}
+
+template <typename N, typename E>
+void gdwg::ContractionHierarchy<N, E>::Unpack(node_id a,
+                                              node_id b,
+                                              bool reversed,
+                                              std::vector<N>& out) const {
+  const ArcLists* lists = nullptr;
+  const auto arc = FindArc(a, b, lists);
+  const auto via = lists->via[arc];
+  if (via == kNoVia) {
+    out.push_back(nodes_[b]);
+  } else if (reversed) {
+    Unpack(via, b, true, out);
+    Unpack(a, via, true, out);
+  } else {
+    Unpack(a, via, false, out);
+    Unpack(via, b, false, out);
+  }
+}
+
+template <typename N, typename E>
+std::size_t gdwg::ContractionHierarchy<N, E>::NumShortcuts() const {
+  auto is_shortcut = [](node_id via) { return via != kNoVia; };
+  return static_cast<std::size_t>(std::count_if(up_.via.begin(), up_.via.end(), is_shortcut) +
+                                  std::count_if(down_.via.begin(), down_.via.end(), is_shortcut));
+}
+
+/* format byte, node count, the nodes, their ranks, then for up and down in turn
+ * each node's arc count and its arcs as (target, weight, via + 1, so graph edges
+ * are 0) */
+template <typename N, typename E>
+std::vector<std::uint8_t> gdwg::ContractionHierarchy<N, E>::Serialize() const {
+  std::vector<std::uint8_t> bytes{detail::kHierarchyFormat};
+  EncodeVarint(bytes, nodes_.size());
+  for (const auto& node : nodes_) {
+    EncodeValue(bytes, node);
+  }
+  for (auto rank : rank_) {
+    EncodeVarint(bytes, rank);
+  }
+  for (const auto* lists : {&up_, &down_}) {
+    for (std::size_t x = 0; x < nodes_.size(); ++x) {
+      EncodeVarint(bytes, lists->offsets[x + 1] - lists->offsets[x]);
+      for (auto e = lists->offsets[x]; e < lists->offsets[x + 1]; ++e) {
+        EncodeVarint(bytes, lists->targets[e]);
+        EncodeValue(bytes, lists->weights[e]);
+        EncodeVarint(bytes, static_cast<node_id>(lists->via[e] + 1));
+      }
+    }
+  }
+  return bytes;
+}
+
+template <typename N, typename E>
+gdwg::ContractionHierarchy<N, E> gdwg::ContractionHierarchy<N, E>::Deserialize(
+    const std::vector<std::uint8_t>& bytes) {
+  auto fail = []() {
+    throw std::invalid_argument(
+        "Cannot call ContractionHierarchy::Deserialize on bytes that aren't a hierarchy");
+  };
+  PatchReader reader{bytes.data(), bytes.data() + bytes.size()};
+  if (reader.Byte() != detail::kHierarchyFormat)
+    fail();
+  ContractionHierarchy ch{};
+  const auto n = reader.Varint();
+  if (n > bytes.size())
+    fail();
+  ch.nodes_.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    ch.nodes_.emplace_back();
+    DecodeValue(reader, ch.nodes_.back());
+  }
+  ch.by_value_ = detail::ValueOrder(ch.nodes_);
+  auto same = [&ch](node_id a, node_id b) { return !(ch.nodes_[a] < ch.nodes_[b]); };
+  if (ch.by_value_.empty()) {
+    for (std::size_t i = 1; i < n; ++i) {
+      if (same(static_cast<node_id>(i - 1), static_cast<node_id>(i)))
+        fail();
+    }
+  } else if (std::adjacent_find(ch.by_value_.begin(), ch.by_value_.end(), same) !=
+             ch.by_value_.end()) {
+    fail();
+  }
+  ch.rank_.reserve(n);
+  std::vector<std::uint8_t> ranked(n, 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto rank = reader.Varint();
+    if (rank >= n || ranked[rank])
+      fail();
+    ranked[rank] = 1;
+    ch.rank_.push_back(static_cast<std::uint32_t>(rank));
+  }
+  for (auto* lists : {&ch.up_, &ch.down_}) {
+    lists->offsets.assign(1, 0);
+    for (std::size_t x = 0; x < n; ++x) {
+      const auto num_arcs = reader.Varint();
+      if (num_arcs > n)
+        fail();
+      for (std::size_t e = 0; e < num_arcs; ++e) {
+        const auto target = reader.Varint();
+        E weight{};
+        DecodeValue(reader, weight);
+        const auto via = reader.Varint();
+        if (target >= n || via > n || (e > 0 && !(lists->targets.back() < target)) ||
+            weight < E{} || !(ch.rank_[x] < ch.rank_[target])) {
+          fail();
+        }
+        lists->targets.push_back(static_cast<node_id>(target));
+        lists->weights.push_back(std::move(weight));
+        lists->via.push_back(static_cast<node_id>(via - 1));
+      }
+      lists->offsets.push_back(lists->targets.size());
+    }
+  }
+  if (!reader.AtEnd())
+    fail();
+  /* every arc goes up in rank, so a shortcut whose via is ranked lower still and
+   * whose two halves are there unpacks in fewer steps than there are ranks */
+  for (const auto* lists : {&ch.up_, &ch.down_}) {
+    const bool is_up = lists == &ch.up_;
+    for (node_id x = 0; x < n; ++x) {
+      for (auto e = lists->offsets[x]; e < lists->offsets[x + 1]; ++e) {
+        const auto via = lists->via[e];
+        if (via == kNoVia)
+          continue;
+        const auto a = is_up ? x : lists->targets[e];
+        const auto b = is_up ? lists->targets[e] : x;
+        const ArcLists* half = nullptr;
+        if (!(ch.rank_[via] < ch.rank_[x]) || ch.FindArc(a, via, half) == kNoArc ||
+            ch.FindArc(via, b, half) == kNoArc) {
+          fail();
+        }
+      }
+    }
+  }
+  return ch;
+}
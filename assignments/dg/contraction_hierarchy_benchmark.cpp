@@ -0,0 +1,81 @@
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/contraction_hierarchy.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/point_to_point.h"
+
+/* contraction hierarchy build time and query latency percentiles against
+ * bidirectional Dijkstra, for random (src, dst) pairs on a side x side grid of
+ * string nodes with random weights of 1..100 both ways between neighbours.
+ * usage: contraction_hierarchy_benchmark [side (default 300)] [num_queries (default 1000)] */
+int main(int argc, char** argv) {
+  const auto side = static_cast<int>(gdwg::benchmark::Arg(argc, argv, 1, 300));
+  const auto num_queries = gdwg::benchmark::Arg(argc, argv, 2, 1000);
+
+  std::mt19937 rng{6772};
+  std::uniform_real_distribution<double> weight{1, 100};
+  auto name = [](int v) { return "n" + std::to_string(v); };
+  std::vector<std::tuple<std::string, std::string, double>> edges{};
+  for (int r = 0; r < side; ++r) {
+    for (int c = 0; c < side; ++c) {
+      const int v = r * side + c;
+      if (c + 1 < side) {
+        edges.emplace_back(name(v), name(v + 1), weight(rng));
+        edges.emplace_back(name(v + 1), name(v), weight(rng));
+      }
+      if (r + 1 < side) {
+        edges.emplace_back(name(v), name(v + side), weight(rng));
+        edges.emplace_back(name(v + side), name(v), weight(rng));
+      }
+    }
+  }
+  gdwg::Graph<std::string, double> g{edges.cbegin(), edges.cend()};
+  gdwg::PathFinder<std::string, double> finder{g};
+  gdwg::benchmark::Stopwatch build_timer{};
+  gdwg::ContractionHierarchy<std::string, double> ch{g};
+  gdwg::benchmark::Report("ContractionHierarchy build", edges.size(), build_timer.Seconds());
+  std::cout << "  " << ch.NumArcs() << " arcs, " << ch.NumShortcuts() << " of them shortcuts\n";
+
+  gdwg::benchmark::Stopwatch serialize_timer{};
+  const auto bytes = ch.Serialize();
+  const auto loaded = gdwg::ContractionHierarchy<std::string, double>::Deserialize(bytes);
+  gdwg::benchmark::Report("serialize and deserialize", loaded.NumArcs(), serialize_timer.Seconds());
+  std::cout << "  " << bytes.size() << " bytes\n";
+
+  std::uniform_int_distribution<int> node{0, side * side - 1};
+  std::vector<std::pair<std::string, std::string>> queries{};
+  for (std::size_t i = 0; i < num_queries; ++i) {
+    queries.emplace_back(name(node(rng)), name(node(rng)));
+  }
+
+  gdwg::ShortestPath<std::string, double> result{};
+  std::vector<double> bidirectional{};
+  std::vector<double> hierarchy{};
+  long long mismatches = 0;
+  for (const auto& [src, dst] : queries) {
+    gdwg::benchmark::Stopwatch bidirectional_timer{};
+    finder.BidirectionalDijkstra(src, dst, result);
+    bidirectional.push_back(bidirectional_timer.Seconds());
+    const auto expected = result.distance;
+
+    gdwg::benchmark::Stopwatch hierarchy_timer{};
+    loaded.Query(src, dst, result);
+    hierarchy.push_back(hierarchy_timer.Seconds());
+    /* the two may add the same weights up in a different order */
+    mismatches +=
+        result.distance < expected * (1 - 1e-9) || expected * (1 + 1e-9) < result.distance;
+  }
+  gdwg::benchmark::ReportLatencies("bidirectional dijkstra", bidirectional);
+  gdwg::benchmark::ReportLatencies("contraction hierarchy", hierarchy);
+  if (mismatches != 0) {
+    std::cerr << mismatches << " queries disagreed on the distance\n";
+    return 1;
+  }
+}
@@ -0,0 +1,195 @@
+#include "assignments/dg/contraction_hierarchy.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "assignments/dg/point_to_point.h"
+#include "assignments/dg/thread_pool.h"
+#include "catch.h"
+
+namespace {
+
+/* the total weight of a path, taking the lightest edge between each pair */
+template <typename N, typename E>
+E PathWeight(const gdwg::Graph<N, E>& g, const std::vector<N>& path) {
+  E total{};
+  for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+    auto weights = g.GetWeights(path[i], path[i + 1]);
+    REQUIRE(!weights.empty());
+    total += *std::min_element(weights.begin(), weights.end());
+  }
+  return total;
+}
+
+/* every query on ch agrees with bidirectional Dijkstra on g, and its path is a
+ * real one of the same weight */
+template <typename N, typename E>
+void RequireSameAsDijkstra(const gdwg::Graph<N, E>& g, const gdwg::ContractionHierarchy<N, E>& ch) {
+  gdwg::PathFinder<N, E> finder{g};
+  const auto nodes = g.GetNodes();
+  gdwg::ShortestPath<N, E> path{};
+  for (const auto& src : nodes) {
+    for (const auto& dst : nodes) {
+      const auto expected = finder.BidirectionalDijkstra(src, dst);
+      ch.Query(src, dst, path);
+      REQUIRE(path.found == expected.found);
+      if (!expected.found) {
+        REQUIRE(path.nodes.empty());
+        continue;
+      }
+      REQUIRE(path.distance == expected.distance);
+      REQUIRE(path.nodes.front() == src);
+      REQUIRE(path.nodes.back() == dst);
+      REQUIRE(PathWeight(g, path.nodes) == expected.distance);
+    }
+  }
+}
+
+}  // namespace
+
+SCENARIO("ContractionHierarchy on a small graph") {
+  GIVEN("a graph with a short cut that looks long") {
+    std::vector<std::tuple<std::string, std::string, double>> edges{
+        {"a", "b", 1}, {"b", "c", 1}, {"c", "d", 1}, {"a", "d", 5}, {"d", "e", 1},
+        {"a", "e", 2.5}, {"e", "a", 1}, {"f", "a", 1}, {"c", "c", 0}, {"b", "c", 3}};
+    gdwg::Graph<std::string, double> g{edges.begin(), edges.end()};
+    gdwg::ContractionHierarchy<std::string, double> ch{g};
+    const std::vector<std::string> path_a_d{"a", "b", "c", "d"};
+    THEN("queries find the shortest path in graph nodes") {
+      auto path = ch.Query("a", "d");
+      REQUIRE(path.found);
+      REQUIRE(path.distance == Approx(3));
+      REQUIRE(path.nodes == path_a_d);
+      REQUIRE(ch.Query("b", "a").nodes == std::vector<std::string>{"b", "c", "d", "e", "a"});
+      REQUIRE(ch.Query("c", "c").nodes == std::vector<std::string>{"c"});
+      REQUIRE(!ch.Query("a", "f").found);
+      RequireSameAsDijkstra(g, ch);
+    }
+    THEN("every node has its own rank") {
+      std::vector<std::uint32_t> ranks{};
+      for (const auto& node : g.GetNodes()) {
+        ranks.push_back(ch.Rank(node));
+      }
+      std::sort(ranks.begin(), ranks.end());
+      REQUIRE(ranks == std::vector<std::uint32_t>{0, 1, 2, 3, 4, 5});
+      REQUIRE(ch.NumNodes() == 6);
+    }
+    THEN("unknown nodes throw") {
+      REQUIRE_THROWS_AS(ch.Query("a", "z"), std::out_of_range);
+      REQUIRE_THROWS_AS(ch.Rank("z"), std::out_of_range);
+    }
+    WHEN("it is serialized and read back") {
+      const auto bytes = ch.Serialize();
+      auto copy = gdwg::ContractionHierarchy<std::string, double>::Deserialize(bytes);
+      THEN("it is the same index") {
+        REQUIRE(copy.Serialize() == bytes);
+        REQUIRE(copy.NumArcs() == ch.NumArcs());
+        RequireSameAsDijkstra(g, copy);
+      }
+      THEN("bad bytes throw") {
+        auto cut = bytes;
+        cut.pop_back();
+        using Hierarchy = gdwg::ContractionHierarchy<std::string, double>;
+        REQUIRE_THROWS_AS(Hierarchy::Deserialize(cut), std::invalid_argument);
+        auto extra = bytes;
+        extra.push_back(0);
+        REQUIRE_THROWS_AS(Hierarchy::Deserialize(extra), std::invalid_argument);
+        auto wrong_format = bytes;
+        wrong_format[0] = 0;
+        REQUIRE_THROWS_AS(Hierarchy::Deserialize(wrong_format), std::invalid_argument);
+      }
+      THEN("any one byte changed either throws or still gives an index queries finish on") {
+        using Hierarchy = gdwg::ContractionHierarchy<std::string, double>;
+        const auto nodes = g.GetNodes();
+        for (std::size_t i = 1; i < bytes.size(); ++i) {
+          for (int delta : {1, 2, 0x7f, 0xff}) {
+            auto changed = bytes;
+            changed[i] = static_cast<std::uint8_t>(changed[i] + delta);
+            try {
+              const auto index = Hierarchy::Deserialize(changed);
+              for (const auto& src : nodes) {
+                for (const auto& dst : nodes) {
+                  index.Query(src, dst);
+                }
+              }
+            } catch (const std::invalid_argument&) {
+            } catch (const std::out_of_range&) {
+              /* a node's value changed, so one of nodes isn't in it */
+            }
+          }
+        }
+      }
+    }
+    WHEN("it is built from a snapshot in some other node order") {
+      auto permuted = gdwg::CsrSnapshot<std::string, double>{g}.Permuted({5, 3, 0, 4, 1, 2});
+      gdwg::ContractionHierarchy<std::string, double> from_permuted{permuted};
+      THEN("it finds the same paths") {
+        REQUIRE(from_permuted.Query("a", "d").nodes == path_a_d);
+        RequireSameAsDijkstra(g, from_permuted);
+        auto copy = gdwg::ContractionHierarchy<std::string, double>::Deserialize(
+            from_permuted.Serialize());
+        RequireSameAsDijkstra(g, copy);
+      }
+    }
+  }
+  GIVEN("a graph with a negative weight") {
+    std::vector<std::tuple<int, int, int>> edges{{1, 2, -1}};
+    gdwg::Graph<int, int> g{edges.begin(), edges.end()};
+    REQUIRE_THROWS_AS((gdwg::ContractionHierarchy<int, int>{g}), std::domain_error);
+  }
+}
+
+SCENARIO("ContractionHierarchy on bigger graphs") {
+  gdwg::ThreadPool pool{3};
+  GIVEN("a grid with random weights both ways between neighbours") {
+    const int side = 10;
+    std::mt19937 rng{37};
+    std::vector<std::tuple<int, int, int>> edges{};
+    for (int r = 0; r < side; ++r) {
+      for (int c = 0; c < side; ++c) {
+        const int v = r * side + c;
+        if (c + 1 < side) {
+          edges.emplace_back(v, v + 1, 1 + static_cast<int>(rng() % 9));
+          edges.emplace_back(v + 1, v, 1 + static_cast<int>(rng() % 9));
+        }
+        if (r + 1 < side) {
+          edges.emplace_back(v, v + side, 1 + static_cast<int>(rng() % 9));
+          edges.emplace_back(v + side, v, 1 + static_cast<int>(rng() % 9));
+        }
+      }
+    }
+    gdwg::Graph<int, int> g{edges.begin(), edges.end()};
+    gdwg::ContractionHierarchy<int, int> ch{g, pool};
+    THEN("every query matches Dijkstra, shortcuts included") {
+      REQUIRE(ch.NumShortcuts() > 0);
+      RequireSameAsDijkstra(g, ch);
+    }
+    THEN("building it on one thread gives an index that answers the same") {
+      gdwg::ThreadPool single{0};
+      gdwg::ContractionHierarchy<int, int> sequential{g, single};
+      RequireSameAsDijkstra(g, sequential);
+    }
+  }
+  GIVEN("a sparse random directed graph with zero weights, parallel edges and loops") {
+    const int n = 60;
+    std::mt19937 rng{370};
+    std::vector<std::tuple<int, int, int>> edges{};
+    for (int i = 0; i < 150; ++i) {
+      edges.emplace_back(static_cast<int>(rng() % n), static_cast<int>(rng() % n),
+                         static_cast<int>(rng() % 6));
+    }
+    gdwg::Graph<int, int> g{edges.begin(), edges.end()};
+    gdwg::ContractionHierarchy<int, int> ch{g, pool};
+    THEN("every query matches Dijkstra, including unreachable pairs") {
+      RequireSameAsDijkstra(g, ch);
+      RequireSameAsDijkstra(g, gdwg::ContractionHierarchy<int, int>::Deserialize(ch.Serialize()));
+    }
+  }
+}
@@ -0,0 +1,77 @@
+#ifndef ASSIGNMENTS_DG_CSR_SNAPSHOT_H_
+#define ASSIGNMENTS_DG_CSR_SNAPSHOT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+
+namespace gdwg {
+namespace detail {
+
+/* for anything that keeps node values by dense id: the ids in value order, or
+ * nothing if the ids already are in value order */
+template <typename N>
+std::vector<std::uint32_t> ValueOrder(const std::vector<N>& nodes);
+/* val's id, given nodes and their ValueOrder, or nodes.size() if it isn't there */
+template <typename N>
+std::uint32_t FindNode(const std::vector<N>& nodes,
+                       const std::vector<std::uint32_t>& by_value,
+                       const N& val);
+
+}  // namespace detail
+
+/* an immutable compressed sparse row copy of a Graph, for the algorithms that
+ * want flat arrays indexed by node instead of sets of smart pointers.
+ * Nodes get dense ids 0..NumNodes()-1 (their rank in the sorted node order,
+ * unless the snapshot has been Permuted), and node v's outgoing edges are the
+ * edge indexes [Offsets()[v], Offsets()[v + 1]), with their dst in Targets() and
+ * weight in Weights(). Within a node, edges are ordered by (dst id, w) */
+template <typename N, typename E>
+class CsrSnapshot {
+ public:
+  using node_id = std::uint32_t;
+
+  /* ctors */
+  explicit CsrSnapshot(const gdwg::Graph<N, E>& g);
+
+  /* methods */
+  std::size_t NumNodes() const { return nodes_.size(); }
+  std::size_t NumEdges() const { return targets_.size(); }
+  const std::vector<N>& Nodes() const { return nodes_; }
+  const N& Value(node_id id) const { return nodes_[id]; }
+  /* throws std::out_of_range if val isn't a node of the snapshot */
+  node_id Id(const N& val) const;
+  bool IsNode(const N& val) const;
+  std::size_t Degree(node_id id) const { return offsets_[id + 1] - offsets_[id]; }
+
+  const std::vector<std::size_t>& Offsets() const { return offsets_; }
+  const std::vector<node_id>& Targets() const { return targets_; }
+  const std::vector<E>& Weights() const { return weights_; }
+
+  /* the same graph with every edge flipped, i.e. Offsets()/Targets() of the
+   * result list each node's incoming edges and their srcs */
+  CsrSnapshot Transposed() const;
+  /* the same graph laid out in a different node order: node order[i] of this
+   * snapshot becomes node i of the result (see partition.h for orders that put
+   * nodes near the nodes they share edges with). Throws std::invalid_argument
+   * if order isn't a permutation of the ids */
+  CsrSnapshot Permuted(const std::vector<node_id>& order) const;
+
+ private:
+  CsrSnapshot() = default;
+
+  std::vector<N> nodes_;
+  /* the ids in value order, once Permuted has taken them out of it */
+  std::vector<node_id> by_value_;
+  std::vector<std::size_t> offsets_;
+  std::vector<node_id> targets_;
+  std::vector<E> weights_;
+};
+
+}  // namespace gdwg
+
+#include "assignments/dg/csr_snapshot.tpp"
+
+#endif  // ASSIGNMENTS_DG_CSR_SNAPSHOT_H_
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+template <typename N>
+std::vector<std::uint32_t> gdwg::detail::ValueOrder(const std::vector<N>& nodes) {
+  std::vector<std::uint32_t> by_value{};
+  if (std::is_sorted(nodes.begin(), nodes.end()))
+    return by_value;
+  by_value.resize(nodes.size());
+  std::iota(by_value.begin(), by_value.end(), 0);
+  std::sort(by_value.begin(), by_value.end(),
+            [&nodes](std::uint32_t a, std::uint32_t b) { return nodes[a] < nodes[b]; });
+  return by_value;
+}
+
+template <typename N>
+std::uint32_t gdwg::detail::FindNode(const std::vector<N>& nodes,
+                                     const std::vector<std::uint32_t>& by_value,
+                                     const N& val) {
+  const auto n = static_cast<std::uint32_t>(nodes.size());
+  if (by_value.empty()) {
+    auto it = std::lower_bound(nodes.begin(), nodes.end(), val);
+    return it == nodes.end() || val < *it ? n : static_cast<std::uint32_t>(it - nodes.begin());
+  }
+  auto it = std::lower_bound(by_value.begin(), by_value.end(), val,
+                             [&nodes](std::uint32_t id, const N& v) { return nodes[id] < v; });
+  return it == by_value.end() || val < nodes[*it] ? n : *it;
+}
+
+template <typename N, typename E>
+gdwg::CsrSnapshot<N, E>::CsrSnapshot(const gdwg::Graph<N, E>& g) : nodes_{g.GetNodes()} {
+  offsets_.assign(nodes_.size() + 1, 0);
+  /* edges come out ordered by src then dst, so each node's edges are already
+   * contiguous and sorted. We only need to turn values into ids */
+  for (const auto& [src, dst, w] : g) {
+    ++offsets_[Id(src) + 1];
+    targets_.push_back(Id(dst));
+    weights_.push_back(w);
+  }
+  /* turn the per node counts into running offsets */
+  for (std::size_t i = 1; i < offsets_.size(); ++i) {
+    offsets_[i] += offsets_[i - 1];
+  }
+}
+
+template <typename N, typename E>
+typename gdwg::CsrSnapshot<N, E>::node_id gdwg::CsrSnapshot<N, E>::Id(const N& val) const {
+  const auto id = detail::FindNode(nodes_, by_value_, val);
+  if (id == nodes_.size()) {
+    throw std::out_of_range("Cannot call CsrSnapshot::Id on a node that doesn't exist");
+  }
+  return id;
+}
+
+template <typename N, typename E>
+bool gdwg::CsrSnapshot<N, E>::IsNode(const N& val) const {
+  return detail::FindNode(nodes_, by_value_, val) != nodes_.size();
+}
+
+template <typename N, typename E>
+gdwg::CsrSnapshot<N, E> gdwg::CsrSnapshot<N, E>::Transposed() const {
+  CsrSnapshot t{};
+  t.nodes_ = nodes_;
+  t.by_value_ = by_value_;
+  t.offsets_.assign(nodes_.size() + 1, 0);
+  for (auto dst : targets_) {
+    ++t.offsets_[dst + 1];
+  }
+  for (std::size_t i = 1; i < t.offsets_.size(); ++i) {
+    t.offsets_[i] += t.offsets_[i - 1];
+  }
+  /* a counting sort by dst. Walking the srcs in order keeps every transposed
+   * node's edges sorted by (new dst, w) just like the original */
+  t.targets_.resize(targets_.size());
+  t.weights_.resize(weights_.size());
+  std::vector<std::size_t> next{t.offsets_.begin(), t.offsets_.end() - 1};
+  for (node_id src = 0; src < nodes_.size(); ++src) {
+    for (auto e = offsets_[src]; e < offsets_[src + 1]; ++e) {
+      auto slot = next[targets_[e]]++;
+      t.targets_[slot] = src;
+      t.weights_[slot] = weights_[e];
+    }
+  }
+  return t;
+}
+
+template <typename N, typename E>
+gdwg::CsrSnapshot<N, E> gdwg::CsrSnapshot<N, E>::Permuted(const std::vector<node_id>& order) const {
+  const auto n = nodes_.size();
+  /* new_id[old] = new, which also checks every id turns up exactly once */
+  std::vector<node_id> new_id(n, static_cast<node_id>(n));
+  if (order.size() == n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (order[i] < n && new_id[order[i]] == n)
+        new_id[order[i]] = static_cast<node_id>(i);
+    }
+  }
+  if (order.size() != n || std::find(new_id.begin(), new_id.end(), n) != new_id.end()) {
+    throw std::invalid_argument("Cannot call CsrSnapshot::Permuted with an order that isn't a "
+                                "permutation of the node ids");
+  }
+
+  CsrSnapshot p{};
+  p.nodes_.reserve(n);
+  p.offsets_.reserve(n + 1);
+  p.offsets_.push_back(0);
+  p.targets_.reserve(targets_.size());
+  p.weights_.reserve(weights_.size());
+  std::vector<std::size_t> edges{};
+  for (auto old : order) {
+    p.nodes_.push_back(nodes_[old]);
+    /* the node's edges, reordered by their new dst (a stable sort keeps the
+     * weights of parallel edges in order) */
+    edges.resize(offsets_[old + 1] - offsets_[old]);
+    std::iota(edges.begin(), edges.end(), offsets_[old]);
+    std::stable_sort(edges.begin(), edges.end(), [&](std::size_t a, std::size_t b) {
+      return new_id[targets_[a]] < new_id[targets_[b]];
+    });
+    for (auto e : edges) {
+      p.targets_.push_back(new_id[targets_[e]]);
+      p.weights_.push_back(weights_[e]);
+    }
+    p.offsets_.push_back(p.targets_.size());
+  }
+  /* this snapshot's ids in value order, mapped to their new ids */
+  p.by_value_.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    p.by_value_[i] = new_id[by_value_.empty() ? i : by_value_[i]];
+  }
+  if (std::is_sorted(p.by_value_.begin(), p.by_value_.end()))
+    p.by_value_.clear();
+  return p;
+}
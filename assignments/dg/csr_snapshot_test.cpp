@@ -0,0 +1,74 @@
+#include "assignments/dg/csr_snapshot.h"
+
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+SCENARIO("taking a CSR snapshot of a graph") {
+  GIVEN("a graph with parallel edges, a reflexive edge and an isolated node") {
+    std::vector<std::tuple<std::string, std::string, int>> edges{
+        {"a", "b", 2}, {"a", "b", 1}, {"a", "c", 3}, {"c", "a", 4}, {"c", "c", 5}};
+    gdwg::Graph<std::string, int> g{edges.begin(), edges.end()};
+    g.InsertNode("d");
+    gdwg::CsrSnapshot<std::string, int> csr{g};
+    THEN("nodes get their rank as an id") {
+      REQUIRE(csr.Nodes() == g.GetNodes());
+      REQUIRE(csr.Id("c") == 2);
+      REQUIRE(csr.Value(3) == "d");
+      REQUIRE(csr.IsNode("d"));
+      REQUIRE(!csr.IsNode("z"));
+      REQUIRE_THROWS_AS(csr.Id("z"), std::out_of_range);
+    }
+    THEN("every edge is kept, grouped by src and ordered by (dst, w)") {
+      REQUIRE(csr.NumEdges() == 5);
+      REQUIRE(csr.Offsets() == std::vector<std::size_t>{0, 3, 3, 5, 5});
+      REQUIRE(csr.Targets() == std::vector<std::uint32_t>{1, 1, 2, 0, 2});
+      REQUIRE(csr.Weights() == std::vector<int>{1, 2, 3, 4, 5});
+      REQUIRE(csr.Degree(0) == 3);
+      REQUIRE(csr.Degree(3) == 0);
+    }
+    WHEN("we transpose it") {
+      auto t = csr.Transposed();
+      THEN("each node lists its incoming edges by src") {
+        REQUIRE(t.Nodes() == csr.Nodes());
+        REQUIRE(t.Offsets() == std::vector<std::size_t>{0, 1, 3, 5, 5});
+        REQUIRE(t.Targets() == std::vector<std::uint32_t>{2, 0, 0, 0, 2});
+        REQUIRE(t.Weights() == std::vector<int>{4, 1, 2, 3, 5});
+      }
+    }
+    WHEN("we lay it out in a different order") {
+      auto p = csr.Permuted({3, 2, 0, 1});
+      THEN("nodes take their place in the order, and can still be looked up") {
+        REQUIRE(p.Nodes() == std::vector<std::string>{"d", "c", "a", "b"});
+        REQUIRE(p.Id("a") == 2);
+        REQUIRE(p.Id("b") == 3);
+        REQUIRE(p.Id("d") == 0);
+        REQUIRE(!p.IsNode("z"));
+        REQUIRE_THROWS_AS(p.Id("z"), std::out_of_range);
+      }
+      THEN("edges follow their nodes, ordered by (new dst, w)") {
+        REQUIRE(p.Offsets() == std::vector<std::size_t>{0, 0, 2, 5, 5});
+        REQUIRE(p.Targets() == std::vector<std::uint32_t>{1, 2, 1, 3, 3});
+        REQUIRE(p.Weights() == std::vector<int>{5, 4, 3, 1, 2});
+      }
+      THEN("transposing keeps the new ids, and permuting back gives the original") {
+        REQUIRE(p.Transposed().Id("a") == 2);
+        auto back = p.Permuted({2, 3, 1, 0});
+        REQUIRE(back.Nodes() == csr.Nodes());
+        REQUIRE(back.Offsets() == csr.Offsets());
+        REQUIRE(back.Targets() == csr.Targets());
+        REQUIRE(back.Weights() == csr.Weights());
+        REQUIRE(back.Id("c") == 2);
+      }
+    }
+    THEN("an order that isn't a permutation can't be used") {
+      REQUIRE_THROWS_AS(csr.Permuted({0, 1, 2}), std::invalid_argument);
+      REQUIRE_THROWS_AS(csr.Permuted({0, 1, 1, 3}), std::invalid_argument);
+      REQUIRE_THROWS_AS(csr.Permuted({0, 1, 2, 4}), std::invalid_argument);
+    }
+  }
+}
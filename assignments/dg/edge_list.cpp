@@ -0,0 +1,60 @@
+#include "assignments/dg/edge_list.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+gdwg::detail::MappedFile::MappedFile(const std::string& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot call LoadEdgeList on a file that can't be opened: " + path);
+  }
+  struct stat info {};
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("Cannot call LoadEdgeList on a file that can't be read: " + path);
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  /* an empty file can't be mapped, but doesn't need to be either */
+  if (size_ > 0) {
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Cannot call LoadEdgeList on a file that can't be mapped: " + path);
+    }
+    data_ = static_cast<const char*>(data);
+  }
+  /* the mapping keeps the file alive on its own */
+  close(fd);
+}
+
+gdwg::detail::MappedFile::~MappedFile() {
+  if (data_ != nullptr)
+    munmap(const_cast<char*>(data_), size_);
+}
+
+std::vector<std::string_view> gdwg::detail::SplitAtLines(std::string_view text,
+                                                         std::size_t num_chunks) {
+  num_chunks = std::max<std::size_t>(num_chunks, 1);
+  std::vector<std::string_view> chunks{};
+  std::size_t first = 0;
+  for (std::size_t i = 1; i <= num_chunks && first < text.size(); ++i) {
+    auto last = std::max(first, text.size() * i / num_chunks);
+    /* move the cut to just after the end of the line it falls in */
+    if (last < text.size()) {
+      const auto newline = text.find('\n', last);
+      last = newline == std::string_view::npos ? text.size() : newline + 1;
+    }
+    chunks.push_back(text.substr(first, last - first));
+    first = last;
+  }
+  return chunks;
+}
@@ -0,0 +1,73 @@
+#ifndef ASSIGNMENTS_DG_EDGE_LIST_H_
+#define ASSIGNMENTS_DG_EDGE_LIST_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+
+/* loading graphs from text edge lists: one "src dst weight" edge per line,
+ * separated by any spaces or tabs, where src and dst are node names and weight
+ * is a number. Blank lines and lines starting with '#' are skipped, and '\r'
+ * counts as a space, so Windows line endings are fine */
+namespace gdwg {
+
+/* an edge list after parsing: every distinct node name, sorted, and every
+ * distinct edge as (src, dst, weight) with src and dst indexes into nodes,
+ * sorted too. That's exactly what Graph::FromSortedIds wants */
+template <typename E>
+struct ParsedEdgeList {
+  std::vector<std::string> nodes;
+  std::vector<std::tuple<std::uint32_t, std::uint32_t, E>> edges;
+};
+
+namespace detail {
+
+/* a file mapped read only into memory for as long as this lives */
+class MappedFile {
+ public:
+  /* throws std::runtime_error if the file can't be opened or mapped */
+  explicit MappedFile(const std::string& path);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  std::string_view Text() const { return {data_, size_}; }
+
+ private:
+  const char* data_{nullptr};
+  std::size_t size_{0};
+};
+
+/* cuts text into at most num_chunks pieces of about the same size, each ending
+ * just after a '\n' (apart from the last), so no line is split */
+std::vector<std::string_view> SplitAtLines(std::string_view text, std::size_t num_chunks);
+
+}  // namespace detail
+
+/* parses text in chunks on pool. Each chunk turns its lines into edges between
+ * chunk-local node ids, reading weights with std::from_chars and interning names
+ * as views into text (so no strings are made per line). The names are then
+ * merged and sorted once to give global ids, and the edges remapped, sorted and
+ * deduplicated. E has to be an arithmetic type. Throws std::invalid_argument
+ * naming the first line that isn't an edge */
+template <typename E>
+ParsedEdgeList<E> ParseEdgeList(std::string_view text, ThreadPool& pool = ThreadPool::Default());
+
+/* maps the file at path into memory, parses it with ParseEdgeList and builds the
+ * graph with Graph::FromSortedIds. Throws std::runtime_error if the file can't
+ * be read */
+template <typename E>
+Graph<std::string, E> LoadEdgeList(const std::string& path,
+                                   ThreadPool& pool = ThreadPool::Default());
+
+}  // namespace gdwg
+
+#include "assignments/dg/edge_list.tpp"
+
+#endif  // ASSIGNMENTS_DG_EDGE_LIST_H_
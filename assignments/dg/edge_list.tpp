@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/parallel_sort.h"
+
+namespace gdwg {
+namespace detail {
+
+/* below this much text per chunk, splitting costs more than it saves */
+constexpr std::size_t kMinChunkBytes = 1 << 16;
+
+/* one chunk's edges, between ids that only mean something within the chunk */
+template <typename E>
+struct ChunkEdges {
+  /* local id -> name, as a view into the text */
+  std::vector<std::string_view> names;
+  std::vector<std::tuple<std::uint32_t, std::uint32_t, E>> edges;
+  std::size_t num_lines{0};
+  /* the chunk's first line (counting from 1) that isn't an edge, or 0 */
+  std::size_t bad_line{0};
+};
+
+inline bool IsEdgeListSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+/* the token of line starting at or after pos, moving pos past it. Empty once
+ * the line has run out */
+inline std::string_view NextToken(std::string_view line, std::size_t& pos) {
+  while (pos < line.size() && IsEdgeListSpace(line[pos]))
+    ++pos;
+  const auto first = pos;
+  while (pos < line.size() && !IsEdgeListSpace(line[pos]))
+    ++pos;
+  return line.substr(first, pos - first);
+}
+
+/* parses every line of text, stopping at the first one that isn't an edge */
+template <typename E>
+ChunkEdges<E> ParseChunk(std::string_view text) {
+  ChunkEdges<E> chunk{};
+  std::unordered_map<std::string_view, std::uint32_t> ids{};
+  auto intern = [&](std::string_view name) {
+    auto [it, inserted] = ids.try_emplace(name, static_cast<std::uint32_t>(chunk.names.size()));
+    if (inserted)
+      chunk.names.push_back(name);
+    return it->second;
+  };
+  std::size_t pos = 0;
+  while (pos < text.size()) {
+    auto eol = text.find('\n', pos);
+    if (eol == std::string_view::npos)
+      eol = text.size();
+    const auto line = text.substr(pos, eol - pos);
+    pos = eol + 1;
+    ++chunk.num_lines;
+
+    std::size_t at = 0;
+    const auto src = NextToken(line, at);
+    if (src.empty() || src.front() == '#')
+      continue;
+    const auto dst = NextToken(line, at);
+    const auto weight = NextToken(line, at);
+    E w{};
+    bool ok = !dst.empty() && !weight.empty();
+    if (ok) {
+      const auto last = weight.data() + weight.size();
+      const auto [end, ec] = std::from_chars(weight.data(), last, w);
+      ok = ec == std::errc{} && end == last && NextToken(line, at).empty();
+    }
+    if (!ok) {
+      chunk.bad_line = chunk.num_lines;
+      break;
+    }
+    chunk.edges.emplace_back(intern(src), intern(dst), w);
+  }
+  return chunk;
+}
+
+}  // namespace detail
+}  // namespace gdwg
+
+template <typename E>
+gdwg::ParsedEdgeList<E> gdwg::ParseEdgeList(std::string_view text, ThreadPool& pool) {
+  static_assert(std::is_arithmetic<E>::value && !std::is_same<E, bool>::value,
+                "edge list weights are read with std::from_chars, so must be numbers");
+  /* a few chunks per thread, so one slow chunk doesn't hold the rest up */
+  const auto max_chunks = 4 * (pool.Size() + 1);
+  const auto num_chunks =
+      std::clamp<std::size_t>(text.size() / detail::kMinChunkBytes, 1, max_chunks);
+  const auto pieces = detail::SplitAtLines(text, num_chunks);
+  std::vector<detail::ChunkEdges<E>> chunks(pieces.size());
+  pool.ParallelFor(pieces.size(),
+                   [&](std::size_t i) { chunks[i] = detail::ParseChunk<E>(pieces[i]); });
+  std::size_t lines_before = 0;
+  for (const auto& chunk : chunks) {
+    if (chunk.bad_line != 0) {
+      throw std::invalid_argument("Cannot call ParseEdgeList on text whose line " +
+                                  std::to_string(lines_before + chunk.bad_line) +
+                                  " isn't \"src dst weight\"");
+    }
+    lines_before += chunk.num_lines;
+  }
+
+  /* every chunk's names merged and sorted once, so a name's rank is its id */
+  std::vector<std::string_view> names{};
+  for (const auto& chunk : chunks) {
+    names.insert(names.end(), chunk.names.begin(), chunk.names.end());
+  }
+  ParallelSort(names.begin(), names.end(), std::less<>{}, pool);
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+
+  ParsedEdgeList<E> parsed{};
+  parsed.nodes.resize(names.size());
+  pool.ParallelFor(pieces.size(), [&](std::size_t i) {
+    for (auto v = names.size() * i / pieces.size(); v < names.size() * (i + 1) / pieces.size();
+         ++v) {
+      parsed.nodes[v] = std::string{names[v]};
+    }
+  });
+
+  /* each chunk's edges, renumbered, go into their own stretch of parsed.edges */
+  std::vector<std::size_t> offsets{0};
+  for (const auto& chunk : chunks) {
+    offsets.push_back(offsets.back() + chunk.edges.size());
+  }
+  parsed.edges.resize(offsets.back());
+  pool.ParallelFor(chunks.size(), [&](std::size_t i) {
+    const auto& chunk = chunks[i];
+    std::vector<std::uint32_t> global(chunk.names.size());
+    for (std::size_t local = 0; local < global.size(); ++local) {
+      global[local] = static_cast<std::uint32_t>(
+          std::lower_bound(names.begin(), names.end(), chunk.names[local]) - names.begin());
+    }
+    auto out = parsed.edges.begin() + static_cast<std::ptrdiff_t>(offsets[i]);
+    for (const auto& [src, dst, w] : chunk.edges) {
+      *out++ = {global[src], global[dst], w};
+    }
+  });
+  ParallelSort(parsed.edges.begin(), parsed.edges.end(), std::less<>{}, pool);
+  parsed.edges.erase(std::unique(parsed.edges.begin(), parsed.edges.end()), parsed.edges.end());
+  return parsed;
+}
+
+template <typename E>
+gdwg::Graph<std::string, E> gdwg::LoadEdgeList(const std::string& path, ThreadPool& pool) {
+  detail::MappedFile file{path};
+  auto parsed = ParseEdgeList<E>(file.Text(), pool);
+  return Graph<std::string, E>::FromSortedIds(std::move(parsed.nodes), std::move(parsed.edges));
+}
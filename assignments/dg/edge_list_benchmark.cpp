@@ -0,0 +1,67 @@
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/edge_list.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+
+/* loads a random edge list of num_edges "n<src> n<dst> <weight>" lines, first
+ * the obvious way (std::istream >> into tuples, then Graph's range constructor),
+ * then with ParseEdgeList plus FromSortedIds on text already in memory, then with
+ * LoadEdgeList straight from the file. Reports edges per second and MB/s.
+ * usage: edge_list_benchmark [num_nodes (default 100000)] [num_edges (default 2000000)] */
+int main(int argc, char** argv) {
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 1, 100000);
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 2, 2000000);
+  const char* dir = std::getenv("TEST_TMPDIR");
+  const auto path = std::string{dir != nullptr ? dir : "/tmp"} + "/edge_list_benchmark.txt";
+
+  std::string text{};
+  for (const auto& [src, dst, w] : gdwg::benchmark::RandomEdges(num_nodes, num_edges)) {
+    text += "n" + std::to_string(src) + " n" + std::to_string(dst) + " " + std::to_string(w) + "\n";
+  }
+  std::ofstream{path} << text;
+  const auto megabytes = static_cast<double>(text.size()) / (1 << 20);
+  gdwg::benchmark::JsonResults json{};
+  auto report = [&](const std::string& name, std::size_t edges, double seconds) {
+    gdwg::benchmark::Report(name, edges, seconds);
+    std::cout << "  " << megabytes / seconds << " MB/s\n";
+    json.Add(name, {{"bytes", std::to_string(text.size())}}, edges, seconds);
+  };
+
+  gdwg::benchmark::Stopwatch stream_timer{};
+  std::ifstream in{path};
+  std::vector<std::tuple<std::string, std::string, int>> edges{};
+  for (std::tuple<std::string, std::string, int> e{};
+       in >> std::get<0>(e) >> std::get<1>(e) >> std::get<2>(e);) {
+    edges.push_back(e);
+  }
+  const gdwg::Graph<std::string, int> streamed{edges.cbegin(), edges.cend()};
+  report("istream + range constructor", edges.size(), stream_timer.Seconds());
+
+  gdwg::benchmark::Stopwatch parse_timer{};
+  auto parsed = gdwg::ParseEdgeList<int>(text);
+  const auto num_parsed = parsed.edges.size();
+  const auto built = gdwg::Graph<std::string, int>::FromSortedIds(std::move(parsed.nodes),
+                                                                 std::move(parsed.edges));
+  report("ParseEdgeList + FromSortedIds", num_parsed, parse_timer.Seconds());
+
+  gdwg::benchmark::Stopwatch load_timer{};
+  const auto loaded = gdwg::LoadEdgeList<int>(path);
+  report("LoadEdgeList", num_parsed, load_timer.Seconds());
+
+  std::remove(path.c_str());
+  if (!(built == streamed) || !(loaded == streamed)) {
+    std::cerr << "the loaders disagree\n";
+    return 1;
+  }
+  json.Write(std::cout);
+}
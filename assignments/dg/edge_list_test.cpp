@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/edge_list.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+#include "catch.h"
+
+namespace {
+
+/* a scratch file path, under bazel's TEST_TMPDIR when there is one */
+std::string TempPath(const std::string& name) {
+  const char* dir = std::getenv("TEST_TMPDIR");
+  return std::string{dir != nullptr ? dir : "/tmp"} + "/" + name;
+}
+
+/* lines "n<src> n<dst> <weight>" for a small ring with chords, repeated until
+ * the text is at least min_bytes long */
+std::string ManyLines(std::size_t min_bytes) {
+  std::string text{};
+  for (int i = 0; text.size() < min_bytes; ++i) {
+    const auto src = i % 997;
+    const auto dst = (i * 31 + 7) % 997;
+    text += "n" + std::to_string(src) + "\tn" + std::to_string(dst) + " " +
+            std::to_string(i % 13 - 6) + "\n";
+  }
+  return text;
+}
+
+}  // namespace
+
+SCENARIO("SplitAtLines") {
+  GIVEN("a few lines of different lengths") {
+    const std::string_view text{"a b 1\nccccccccc d 2\n\ne f 3\ng h 4"};
+    THEN("the pieces put back together are the text, and only the last doesn't end a line") {
+      for (std::size_t n = 1; n < 10; ++n) {
+        const auto pieces = gdwg::detail::SplitAtLines(text, n);
+        REQUIRE(!pieces.empty());
+        REQUIRE(pieces.size() <= n);
+        std::string joined{};
+        for (std::size_t i = 0; i < pieces.size(); ++i) {
+          REQUIRE(!pieces[i].empty());
+          if (i + 1 < pieces.size())
+            REQUIRE(pieces[i].back() == '\n');
+          joined += pieces[i];
+        }
+        REQUIRE(joined == text);
+      }
+    }
+    THEN("empty text has no pieces") { REQUIRE(gdwg::detail::SplitAtLines("", 4).empty()); }
+  }
+}
+
+SCENARIO("ParseEdgeList") {
+  gdwg::ThreadPool pool{3};
+  GIVEN("a small edge list with comments, blank lines, tabs, CRLF and a repeated edge") {
+    const std::string text{
+        "# a comment\n"
+        "b a 2\r\n"
+        "\n"
+        "  a\tb   1\n"
+        "a b 1\n"
+        "   # an indented comment\n"
+        "c c -4"};
+    WHEN("it is parsed") {
+      const auto parsed = gdwg::ParseEdgeList<int>(text, pool);
+      THEN("the names come out sorted, and the edges sorted and deduplicated") {
+        REQUIRE(parsed.nodes == std::vector<std::string>{"a", "b", "c"});
+        using Edge = std::tuple<std::uint32_t, std::uint32_t, int>;
+        REQUIRE(parsed.edges == std::vector<Edge>{{0, 1, 1}, {1, 0, 2}, {2, 2, -4}});
+      }
+    }
+    THEN("weights can be floating point too") {
+      const auto parsed = gdwg::ParseEdgeList<double>("x y 0.25\ny x -1e3\n", pool);
+      REQUIRE(parsed.nodes == std::vector<std::string>{"x", "y"});
+      REQUIRE(std::get<2>(parsed.edges[0]) == 0.25);
+      REQUIRE(std::get<2>(parsed.edges[1]) == -1000.0);
+    }
+  }
+
+  GIVEN("lines that aren't edges") {
+    THEN("the first one is named in the exception") {
+      auto line_of = [&pool](const std::string& text) -> std::string {
+        try {
+          gdwg::ParseEdgeList<int>(text, pool);
+        } catch (const std::invalid_argument& e) {
+          return e.what();
+        }
+        return "";
+      };
+      REQUIRE(line_of("a b 1\na b\n") ==
+              "Cannot call ParseEdgeList on text whose line 2 isn't \"src dst weight\"");
+      REQUIRE(line_of("# x\n\na b 1x\n").find("line 3 ") != std::string::npos);
+      REQUIRE(line_of("a b 1 2\n").find("line 1 ") != std::string::npos);
+      REQUIRE(line_of("a b 1.5\n").find("line 1 ") != std::string::npos);
+      REQUIRE(line_of("a b 99999999999\n").find("line 1 ") != std::string::npos);
+    }
+    THEN("lines are counted across chunks") {
+      auto text = ManyLines(1 << 20);
+      const auto num_lines = static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n'));
+      text += "n1 n2\n" + ManyLines(1 << 18);
+      try {
+        gdwg::ParseEdgeList<int>(text, pool);
+        FAIL("a bad line was accepted");
+      } catch (const std::invalid_argument& e) {
+        const std::string expected = "line " + std::to_string(num_lines + 1) + " ";
+        REQUIRE(std::string{e.what()}.find(expected) != std::string::npos);
+      }
+    }
+  }
+
+  GIVEN("an edge list long enough to be parsed in many chunks") {
+    const auto text = ManyLines(1 << 20);
+    WHEN("it is parsed and built with FromSortedIds") {
+      auto parsed = gdwg::ParseEdgeList<int>(text, pool);
+      const auto g = gdwg::Graph<std::string, int>::FromSortedIds(parsed.nodes, parsed.edges);
+      THEN("it's the same graph as one built an edge at a time") {
+        std::vector<std::tuple<std::string, std::string, int>> edges{};
+        std::size_t pos = 0;
+        while (pos < text.size()) {
+          const auto eol = text.find('\n', pos);
+          std::size_t at = 0;
+          const std::string_view line{text.data() + pos, eol - pos};
+          const auto src = gdwg::detail::NextToken(line, at);
+          const auto dst = gdwg::detail::NextToken(line, at);
+          const auto weight = gdwg::detail::NextToken(line, at);
+          edges.emplace_back(src, dst, std::stoi(std::string{weight}));
+          pos = eol + 1;
+        }
+        const gdwg::Graph<std::string, int> expected{edges.cbegin(), edges.cend()};
+        REQUIRE((g == expected));
+        REQUIRE(parsed.nodes.size() == 997);
+      }
+    }
+  }
+}
+
+SCENARIO("LoadEdgeList") {
+  GIVEN("an edge list in a file") {
+    const auto path = TempPath("edge_list_test.txt");
+    {
+      std::ofstream out{path};
+      out << "# from a file\nsydney melbourne 5\nmelbourne sydney 5\nsydney perth 20\n";
+    }
+    WHEN("it is loaded") {
+      const auto g = gdwg::LoadEdgeList<int>(path);
+      THEN("the graph has its nodes and edges") {
+        REQUIRE(g.GetNodes() == std::vector<std::string>{"melbourne", "perth", "sydney"});
+        REQUIRE(g.GetWeights("sydney", "perth") == std::vector<int>{20});
+        REQUIRE(g.IsConnected("melbourne", "sydney"));
+      }
+    }
+    std::remove(path.c_str());
+  }
+  GIVEN("an empty file") {
+    const auto path = TempPath("edge_list_test_empty.txt");
+    std::ofstream{path};
+    THEN("it loads as an empty graph") {
+      const auto g = gdwg::LoadEdgeList<int>(path);
+      REQUIRE(g.GetNodes().empty());
+    }
+    std::remove(path.c_str());
+  }
+  GIVEN("a file that doesn't exist") {
+    THEN("loading it throws") {
+      REQUIRE_THROWS_AS(gdwg::LoadEdgeList<int>(TempPath("edge_list_test_missing.txt")),
+                        std::runtime_error);
+    }
+  }
+}
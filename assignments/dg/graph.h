@@ -1,8 +1,12 @@
 #ifndef ASSIGNMENTS_DG_GRAPH_H_
 #define ASSIGNMENTS_DG_GRAPH_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <memory>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <tuple>
@@ -10,15 +14,180 @@
 #include <utility>
 #include <vector>
 
+#include "assignments/dg/instrumentation.h"
+#include "assignments/dg/memory_usage.h"
+#include "assignments/dg/thread_pool.h"
+
 namespace gdwg {
 
+/* the changes that turn one graph into another, as made by Diff (graph_patch.h)
+ * and applied by Graph::Apply. Diff leaves out the edges of removed nodes, as
+ * removing the node takes them with it */
+template <typename N, typename E>
+struct GraphPatch {
+  std::vector<N> removed_nodes;
+  std::vector<std::tuple<N, N, E>> removed_edges;
+  std::vector<N> added_nodes;
+  std::vector<std::tuple<N, N, E>> added_edges;
+};
+
 template <typename N, typename E>
 class Graph {
  private:
-  /* forward declarations so iterator knows about these types */
+  /* forward declarations so the comparator and iterator know about these types */
   struct Edge;
   struct Node;
 
+  /* R is a resource (N or E), smart_ptr is any of the smart
+  pointers to one of the wrapper structs (Node or Edge) */
+  template <typename R, typename smart_ptr>
+  struct WrapperComp {
+    using is_transparent = R;
+    bool operator()(const smart_ptr& a, const smart_ptr& b) const {
+      GDWG_COUNT(kComparisons);
+      /* if we want to compare edges then we need to compare src, dst, w, in that order
+       * std::tie lets us easily do this */
+      if constexpr (std::is_same<smart_ptr, std::shared_ptr<Edge>>::value) {
+        return std::tie(a->src_->value_, a->dst_->value_, a->value_) <
+               std::tie(b->src_->value_, b->dst_->value_, b->value_);
+      } else if constexpr (std::is_same<smart_ptr, std::weak_ptr<Edge>>::value) {
+        /* if it's a weak pointer to an edge then we must promote it to a shared
+         * pointer first before comparing */
+        if (a.expired() || b.expired()) { /* expired shouldn't give any ordering */
+          GDWG_COUNT(kExpiredSeen);
+          return false;
+        }
+        auto a_sp = a.lock();
+        auto b_sp = b.lock();
+        return std::tie(a_sp->src_->value_, a_sp->dst_->value_, a_sp->value_) <
+               std::tie(b_sp->src_->value_, b_sp->dst_->value_, b_sp->value_);
+      } else {
+        /* Nodes are only compared by their value (and we are guaranteed to be
+         * using unique pointers here for a and b as that's what nodes use) */
+        return a->value_ < b->value_;
+      }
+    }
+    /* allows for using non-keys/pseudo keys in our sets */
+    bool operator()(const smart_ptr& a, const R& value) const {
+      GDWG_COUNT(kComparisons);
+      return a->value_ < value;
+    }
+    bool operator()(const R& value, const smart_ptr& b) const {
+      GDWG_COUNT(kComparisons);
+      return value < b->value_;
+    }
+    /* allows for looking up an edge by its (src, dst, w) values, so edges_ can be
+     * searched in O(log E) without having to construct an Edge first */
+    bool operator()(const smart_ptr& a, const std::tuple<const N&, const N&, const E&>& b) const {
+      GDWG_COUNT(kComparisons);
+      return std::tie(a->src_->value_, a->dst_->value_, a->value_) < b;
+    }
+    bool operator()(const std::tuple<const N&, const N&, const E&>& a, const smart_ptr& b) const {
+      GDWG_COUNT(kComparisons);
+      return a < std::tie(b->src_->value_, b->dst_->value_, b->value_);
+    }
+  };
+
+  /* a Node's incoming or outgoing edges, ordered like edges_ (src, dst, w) */
+  using AdjacencySet = std::set<std::weak_ptr<Edge>, WrapperComp<E, std::weak_ptr<Edge>>>;
+
+  /* a wrapper for N's. This is to keep the N, and its associated incoming and outgoing
+   * edges all in the one place */
+  struct Node {
+    explicit Node(N val) : value_{std::move(val)} {};
+    /* builds value_ straight from args, for EmplaceNode */
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args&&... args) : value_(std::forward<Args>(args)...) {}
+    /* the set of 0..* incoming edges */
+    AdjacencySet incoming_;
+    /* the set of 0..* outgoing edges */
+    AdjacencySet outgoing_;
+    N value_;
+  };
+
+  /* a wrapper for E's. This is so we can have each E associated with its
+   * src and dst node */
+  struct Edge {
+    Edge(Node* src, Node* dst, E value) : src_{src}, dst_{dst}, value_{std::move(value)} {}
+    Node* src_;  // exactly 1
+    Node* dst_;  // exactly 1
+    E value_;
+  };
+
+  /* the sets of all Nodes and all Edges (see nodes_ and edges_ below) */
+  using NodeSet = std::set<std::unique_ptr<Node>, WrapperComp<N, std::unique_ptr<Node>>>;
+  using EdgeSet = std::set<std::shared_ptr<Edge>, WrapperComp<E, std::shared_ptr<Edge>>>;
+
+  /* orders edges by (w, src, dst), and can also compare them to a bare weight,
+   * so a weight range is a lower_bound and an upper_bound away */
+  struct WeightOrder {
+    using is_transparent = E;
+    bool operator()(const Edge* a, const Edge* b) const {
+      return std::tie(a->value_, a->src_->value_, a->dst_->value_) <
+             std::tie(b->value_, b->src_->value_, b->dst_->value_);
+    }
+    bool operator()(const Edge* a, const E& w) const { return a->value_ < w; }
+    bool operator()(const E& w, const Edge* b) const { return w < b->value_; }
+  };
+  /* orders edges by (src, w, dst), and can also compare them to a bare src or to
+   * a (src, w) pair, so each src's edges are a run in weight order */
+  struct SourceWeightOrder {
+    using is_transparent = N;
+    using Key = std::tuple<const N&, const E&>;
+    bool operator()(const Edge* a, const Edge* b) const {
+      return std::tie(a->src_->value_, a->value_, a->dst_->value_) <
+             std::tie(b->src_->value_, b->value_, b->dst_->value_);
+    }
+    bool operator()(const Edge* a, const N& src) const { return a->src_->value_ < src; }
+    bool operator()(const N& src, const Edge* b) const { return src < b->src_->value_; }
+    bool operator()(const Edge* a, const Key& key) const {
+      return std::tie(a->src_->value_, a->value_) < key;
+    }
+    bool operator()(const Key& key, const Edge* b) const {
+      return key < std::tie(b->src_->value_, b->value_);
+    }
+  };
+  /* the optional secondary index on edge weights (see EnableWeightIndex) */
+  struct WeightIndex {
+    std::set<const Edge*, WeightOrder> by_weight;
+    std::set<const Edge*, SourceWeightOrder> by_source;
+  };
+
+  /* an edge taken out of edges_, both adjacency sets and (if there is one) the
+   * weight index, as set nodes, so it can go back in without allocating */
+  struct UnlinkedEdge {
+    typename EdgeSet::node_type owner;
+    typename AdjacencySet::node_type out;
+    typename AdjacencySet::node_type in;
+    typename decltype(WeightIndex::by_weight)::node_type by_weight;
+    typename decltype(WeightIndex::by_source)::node_type by_source;
+  };
+  /* one change made while a Transaction is open, with what it takes to undo it */
+  struct UndoRecord {
+    enum class Kind {
+      kInsertNode,
+      kEraseNode,
+      kInsertEdge,
+      kEraseEdge,
+      kRenameNode,
+      kEnableIndex,
+      kDisableIndex,
+    };
+    Kind kind;
+    /* the node inserted or renamed, or the edge inserted. Null if the change
+     * threw before it was made */
+    Node* node{nullptr};
+    const Edge* edge{nullptr};
+    /* an erased node or edge, still owned rather than destroyed */
+    typename NodeSet::node_type erased_node{};
+    UnlinkedEdge erased_edge{};
+    /* a renamed node's old value, and room for its edges while it is renamed
+     * back, so undoing it neither copies nor allocates */
+    std::optional<N> old_value{};
+    std::vector<UnlinkedEdge> unlinked{};
+    std::unique_ptr<WeightIndex> weight_index{};
+  };
+
  public:
   class const_iterator {
    public:
@@ -28,46 +197,84 @@ class Graph {
     using pointer = void;
     using difference_type = int;
 
-    reference operator*() const;
-    const_iterator& operator++();
+    const_iterator() = default;
+
+    /* the owning shared pointer is right there in edges_, so dereferencing is
+     * just following raw pointers (no weak_ptr::lock, no refcount traffic) */
+    reference operator*() const {
+      const Edge& edge = **edge_it_;
+      return {edge.src_->value_, edge.dst_->value_, edge.value_};
+    }
+    const_iterator& operator++() {
+      ++edge_it_;
+      return *this;
+    }
     const_iterator operator++(int) {
       auto copy{*this};
       ++(*this);
       return copy;
     }
-    const_iterator& operator--();
+    const_iterator& operator--() {
+      --edge_it_;
+      return *this;
+    }
     const_iterator operator--(int) {
       auto copy{*this};
       --(*this);
       return copy;
     }
 
-    /* the iterators are only equal if their node iterator (outside) is equal,
-     * and the node iterators are either both the end() or they aren't and
-     * in that case they are then only equal if they are up to the same edge */
     friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
-      return lhs.node_it_ == rhs.node_it_ &&
-             (lhs.node_it_ == lhs.node_end_it_ || lhs.edge_it_ == rhs.edge_it_);
+      return lhs.edge_it_ == rhs.edge_it_;
     }
     friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
       return !(lhs == rhs);
     }
 
    private:
-    /* we need an outer, inner, way of tracking end of outer, and
-     * way of tracking reverse end of outer */
-    typename std::set<std::unique_ptr<Node>>::iterator node_it_;
-    typename std::set<std::weak_ptr<Edge>>::iterator edge_it_;
-    const typename std::set<std::unique_ptr<Node>>::iterator node_end_it_;
-    const typename std::set<std::unique_ptr<Node>>::iterator node_rend_it_;
+    /* edges_ is ordered by src, then dst, then weight, which is exactly the order
+     * we iterate in, so a single iterator into it is all we need */
+    typename EdgeSet::const_iterator edge_it_;
 
     friend class Graph;
-    const_iterator(const decltype(node_it_)& node_it,
-                   const decltype(edge_it_)& edge_it,
-                   const decltype(node_end_it_)& node_end_it,
-                   const decltype(node_rend_it_)& node_rend_it)
-      : node_it_{node_it}, edge_it_{edge_it}, node_end_it_{node_end_it}, node_rend_it_{
-                                                                             node_rend_it} {}
+    explicit const_iterator(const decltype(edge_it_)& edge_it) : edge_it_{edge_it} {}
+  };
+
+  /* an all or nothing scope for a run of edits. Every change made to the graph
+   * while it is open goes into an undo log, and unless Commit is called first,
+   * Rollback (or the destructor) plays the log backwards, which costs O(changes)
+   * rather than O(graph) for a copy taken beforehand. Erased nodes and edges are
+   * kept aside instead of destroyed, so they go straight back (no copies), and
+   * Commit just drops the log. Transactions nest: an inner one only rolls back
+   * its own changes, and committing it hands them to the outer one. An inner
+   * one still open when the outer one ends has nothing left to do, so closing
+   * it does nothing. The graph has to outlive it, and not be moved or assigned
+   * to while it is open */
+  class Transaction {
+   public:
+    explicit Transaction(Graph& g);
+    Transaction(const Transaction&) = delete;
+    Transaction& operator=(const Transaction&) = delete;
+    /* rolls back, unless committed. If that throws, the exception is swallowed
+     * and whatever wasn't undone yet stays as it is; call Rollback to see it */
+    ~Transaction() noexcept;
+
+    /* keeps the changes. Does nothing once committed or rolled back */
+    void Commit();
+    /* undoes every change made since the transaction opened. Does nothing once
+     * committed or rolled back */
+    void Rollback();
+
+   private:
+    Graph& graph_;
+    /* the log, if this is the outermost transaction (inner ones share it) */
+    std::vector<UndoRecord> log_;
+    /* how long the log was when this opened */
+    std::size_t mark_;
+    /* the graph's undo_generation_ when this opened */
+    std::uint64_t generation_;
+    bool outermost_;
+    bool open_{true};
   };
 
   /* ctors and dtor */
@@ -79,6 +286,13 @@ class Graph {
   Graph<N, E>(const gdwg::Graph<N, E>& orig);
   Graph<N, E>(gdwg::Graph<N, E>&& recyclee);
   ~Graph<N, E>() = default;
+  /* bulk construction, for loaders that have already sorted everything: node i
+   * is nodes[i], and each edge is (src id, dst id, w). nodes has to be strictly
+   * increasing, and edges strictly increasing by (src, dst, w), so that every
+   * set can be built in order with end hints, in linear time instead of a lookup
+   * per insert. Throws std::invalid_argument if they aren't */
+  static Graph FromSortedIds(std::vector<N> nodes,
+                             std::vector<std::tuple<std::uint32_t, std::uint32_t, E>> edges);
 
   /* operators */
   Graph<N, E>& operator=(const gdwg::Graph<N, E>& other);
@@ -86,8 +300,25 @@ class Graph {
 
   /* methods */
   bool InsertNode(const N& val);
+  /* moves val into the graph if it isn't a node yet (and leaves it alone if it is) */
+  bool InsertNode(N&& val);
+  /* constructs the node's value from args in place, like std::set::emplace. The
+   * value has to be built before it can be looked up, so if it is already a
+   * node that work (and one allocation) is thrown away */
+  template <typename... Args>
+  bool EmplaceNode(Args&&... args);
   bool InsertEdge(const N& src, const N& dst, const E& w);
+  /* moves w into the graph if the edge is new (and leaves it alone if it isn't) */
+  bool InsertEdge(const N& src, const N& dst, E&& w);
   bool DeleteNode(const N& deletee);
+  /* like DeleteNode, but moves the node's value out to the caller, the way
+   * std::set::extract does. Empty if val isn't a node */
+  std::optional<N> ExtractNode(const N& val);
+  /* deletes every node in deletees that is in the graph, with all their edges.
+   * Fewer than one deletee per 16 nodes are each looked up in nodes_; more than
+   * that, and they are sorted and merged with one walk along nodes_ instead.
+   * Returns how many nodes were deleted */
+  std::size_t DeleteNodes(std::vector<N> deletees);
   bool Replace(const N& old_data, const N& new_data);
   void MergeReplace(const N& replacee, const N& replacer);
   void Clear();
@@ -96,9 +327,22 @@ class Graph {
   std::vector<N> GetNodes() const;
   std::vector<N> GetConnected(const N& src) const;
   std::vector<E> GetWeights(const N& src, const N& dst) const;
+  /* how many edges come into or go out of val (parallel edges count separately,
+   * and a reflexive edge counts both ways), read off its adjacency sets without
+   * visiting any edges. Throw std::out_of_range if val isn't a node */
+  std::size_t InDegree(const N& val) const;
+  std::size_t OutDegree(const N& val) const;
+  /* every node's InDegree or OutDegree, in the order of GetNodes */
+  std::vector<std::size_t> InDegrees() const;
+  std::vector<std::size_t> OutDegrees() const;
   const_iterator find(const N&, const N&, const E&) const;
   bool erase(const N& src, const N& dst, const E& w);
   const_iterator erase(const_iterator it);
+  /* removes the patch's edges and nodes, then adds its nodes and edges. The whole
+   * patch is checked first, and if it doesn't fit this graph (something to remove
+   * is missing, something to add is already there, or an added edge has an end
+   * that won't exist) it throws std::runtime_error and the graph is untouched */
+  void Apply(const GraphPatch<N, E>& patch);
 
   /* iterator methods */
   /* auto generate our reverse iterator from normal iterator */
@@ -112,24 +356,57 @@ class Graph {
   const_reverse_iterator rbegin() const { return crbegin(); }
   const_reverse_iterator rend() const { return crend(); }
 
+  /* weight index */
+  /* builds a secondary index on edge weights, in O(E log E), which every later
+   * insert and erase keeps up to date (in O(log E) each). Copies of the graph
+   * get one too. Without it the queries below still work, by scanning */
+  void EnableWeightIndex();
+  void DisableWeightIndex();
+  bool HasWeightIndex() const { return weight_index_ != nullptr; }
+  /* every edge with lo <= w <= hi, lightest first (then by src and dst). With
+   * the index this is O(log E + k) for k edges, without it O(E) */
+  std::vector<std::tuple<N, N, E>> EdgesWithWeightIn(const E& lo, const E& hi) const;
+  /* the same, but only src's outgoing edges. O(log E + k) with the index, and
+   * a sort of src's outgoing edges without. Throws std::out_of_range if src
+   * isn't a node */
+  std::vector<std::tuple<N, N, E>> EdgesWithWeightIn(const N& src, const E& lo, const E& hi) const;
+  /* the k heaviest edges, heaviest first. O(log E + k) with the index, and
+   * O(E log k) without */
+  std::vector<std::tuple<N, N, E>> HeaviestEdges(std::size_t k) const;
+  /* the k heaviest of src's outgoing edges, heaviest first. O(log E + k) with the
+   * index. Throws std::out_of_range if src isn't a node */
+  std::vector<std::tuple<N, N, E>> HeaviestOutgoingEdges(const N& src, std::size_t k) const;
+
+  /* memory */
+  /* an estimate of the heap the graph uses, from its node and edge counts and
+   * the sizes of the objects involved (see memory_usage.h), so it costs O(1).
+   * With count_owned, whatever the node and edge values own on the heap is
+   * added up too (see HeapBytes), which means visiting every one of them */
+  MemoryBreakdown MemoryUsage(bool count_owned = false) const;
+
+  /* parallel iteration */
+  /* splits the edges into at most n contiguous [first, last) ranges, balanced by
+   * out-degree. Ranges are only cut between src nodes, so all of a node's outgoing
+   * edges end up in the same range */
+  std::vector<std::pair<const_iterator, const_iterator>> EdgeRanges(std::size_t n) const;
+  /* calls func(src, dst, w) for every edge, running the ranges from EdgeRanges on
+   * pool. Calls happen concurrently, so func must be safe to run on several threads */
+  template <typename F>
+  void ParallelForEachEdge(F func, ThreadPool& pool = ThreadPool::Default()) const;
+
   /* friend methods */
   friend bool operator==(const gdwg::Graph<N, E>& lhs, const gdwg::Graph<N, E>& rhs) {
-    /* first see if they have the same nodes */
-    if (lhs.GetNodes() != rhs.GetNodes())
-      return false;
-    /* now, for each edge in lhs, find it in rhs */
-    for (auto lhs_it = lhs.cbegin(); lhs_it != lhs.cend(); ++lhs_it) {
-      auto [src, dst, w] = *lhs_it;
-      if (rhs.find(src, dst, w) == rhs.cend())
-        return false;
-    }
-    /* and the same for rhs to lhs */
-    for (auto rhs_it = rhs.cbegin(); rhs_it != rhs.cend(); ++rhs_it) {
-      auto [src, dst, w] = *rhs_it;
-      if (lhs.find(src, dst, w) == lhs.cend())
-        return false;
-    }
-    return true;
+    /* nodes_ and edges_ are both sorted, so the graphs are equal exactly when the
+     * two sets hold the same values in the same order: one linear pass each */
+    auto same_node = [](const auto& a, const auto& b) { return a->value_ == b->value_; };
+    auto same_edge = [](const auto& a, const auto& b) {
+      return a->src_->value_ == b->src_->value_ && a->dst_->value_ == b->dst_->value_ &&
+             a->value_ == b->value_;
+    };
+    return std::equal(lhs.nodes_.begin(), lhs.nodes_.end(), rhs.nodes_.begin(), rhs.nodes_.end(),
+                      same_node) &&
+           std::equal(lhs.edges_.begin(), lhs.edges_.end(), rhs.edges_.begin(), rhs.edges_.end(),
+                      same_edge);
   }
   friend bool operator!=(const gdwg::Graph<N, E>& lhs, const gdwg::Graph<N, E>& rhs) {
     return !(lhs == rhs);
@@ -140,12 +417,9 @@ class Graph {
     for (auto& node_up : g.nodes_) {
       ss << node_up->value_ << " (\n";
       /* now for each outgoing edge that node has, print it out */
-      for (auto edge_wp : node_up->outgoing_) {
-        /* but only if the edge isn't expired */
-        if (!edge_wp.expired()) {
-          auto edge_sp = edge_wp.lock();
-          ss << "  " << edge_sp->dst_->value_ << " | " << edge_sp->value_ << "\n";
-        }
+      for (const auto& edge_wp : node_up->outgoing_) {
+        auto edge_sp = edge_wp.lock();
+        ss << "  " << edge_sp->dst_->value_ << " | " << edge_sp->value_ << "\n";
       }
       ss << ")\n";
     }
@@ -154,64 +428,68 @@ class Graph {
   }
 
  private:
-  /* R is a resource (N or E), smart_ptr is any of the smart
-  pointers to one of the wrapper structs (Node or Edge) */
-  template <typename R, typename smart_ptr>
-  struct WrapperComp {
-    using is_transparent = R;
-    bool operator()(const smart_ptr& a, const smart_ptr& b) const {
-      /* if we want to compare edges then we need to compare src, dst, w, in that order
-       * std::tie lets us easily do this */
-      if constexpr (std::is_same<smart_ptr, std::shared_ptr<Edge>>::value) {
-        return std::tie(a->src_->value_, a->dst_->value_, a->value_) <
-               std::tie(b->src_->value_, b->dst_->value_, b->value_);
-      } else if constexpr (std::is_same<smart_ptr, std::weak_ptr<Edge>>::value) {
-        /* if it's a weak pointer to an edge then we must promote it to a shared
-         * pointer first before comparing */
-        if (a.expired() || b.expired()) /* expired shouldn't give any ordering */
-          return false;
-        auto a_sp = a.lock();
-        auto b_sp = b.lock();
-        return std::tie(a_sp->src_->value_, a_sp->dst_->value_, a_sp->value_) <
-               std::tie(b_sp->src_->value_, b_sp->dst_->value_, b_sp->value_);
-      } else {
-        /* Nodes are only compared by their value (and we are guaranteed to be
-         * using unique pointers here for a and b as that's what nodes use) */
-        return a->value_ < b->value_;
-      }
-    }
-    /* allows for using non-keys/pseudo keys in our sets */
-    bool operator()(const smart_ptr& a, const R& value) const { return a->value_ < value; }
-    bool operator()(const R& value, const smart_ptr& b) const { return value < b->value_; }
-  };
+  /* the read-only views walk nodes_, edges_ and the adjacency sets directly */
+  template <typename, typename>
+  friend class ReverseView;
+  template <typename, typename, typename>
+  friend class InducedSubgraphView;
+  template <typename, typename, typename>
+  friend class EdgeFilterView;
+  /* as do the lazy traversals */
+  template <typename, typename>
+  friend class BfsRange;
+  template <typename, typename>
+  friend class DfsRange;
+  template <typename, typename>
+  friend class TopologicalRange;
 
-  /* a wrapper for N's. This is to keep the N, and its associated incoming and outgoing
-   * edges all in the one place */
-  struct Node {
-    explicit Node(N val) : value_{val} {};
-    /* the set of 0..* incoming edges */
-    std::set<std::weak_ptr<Edge>, WrapperComp<E, std::weak_ptr<Edge>>> incoming_;
-    /* the set of 0..* outgoing edges */
-    std::set<std::weak_ptr<Edge>, WrapperComp<E, std::weak_ptr<Edge>>> outgoing_;
-    N value_;
-  };
-
-  /* a wrapper for E's. This is so we can have each E associated with its
-   * src and dst node */
-  struct Edge {
-    Edge(Node* src, Node* dst, E value) : src_{src}, dst_{dst}, value_{value} {}
-    Node* src_;  // exactly 1
-    Node* dst_;  // exactly 1
-    E value_;
-  };
+  /* removes an edge from edges_ and from its src and dst adjacency sets, so the
+   * weak pointers in outgoing_/incoming_ never outlive the edge they refer to.
+   * Returns the iterator following the erased edge */
+  typename EdgeSet::const_iterator EraseEdge(typename EdgeSet::const_iterator edge_it);
+  /* InsertEdge for either kind of weight. w is forwarded into the new Edge, so
+   * an rvalue is moved rather than copied */
+  template <typename W>
+  bool AddEdge(const N& src, const N& dst, W&& w);
+  /* removes a node and every edge in or out of it, found through its adjacency
+   * sets rather than by scanning edges_. The node is handed back, in case its
+   * value is wanted, unless an open transaction keeps it (then it is null) */
+  std::unique_ptr<Node> EraseNode(typename NodeSet::const_iterator node_it);
+  /* gives a node a value that isn't a node yet. Every set it or its edges are in
+   * is ordered by value, so they all come out (as set nodes, so no edge is
+   * reallocated or copied) and go back in once it is renamed. new_data is copied
+   * before anything comes out, so if that throws the graph is untouched */
+  void RenameNode(typename NodeSet::const_iterator node_it, const N& new_data);
+  /* takes the node and its edges out of their sets, swaps value into the node,
+   * and puts them all back. unlinked holds the edges meanwhile, and has to be
+   * empty with room for all of them, so none of this can throw */
+  void RekeyNode(typename NodeSet::const_iterator node_it,
+                 N& value,
+                 std::vector<UnlinkedEdge>& unlinked);
+  /* takes an edge out of every set it is in, or puts it back */
+  UnlinkedEdge UnlinkEdge(typename EdgeSet::const_iterator edge_it);
+  void LinkEdge(UnlinkedEdge&& edge);
+  /* appends a record to the open transaction's log before a change is made, so
+   * that making room for it can't fail afterwards. Null if there is no log */
+  UndoRecord* NewUndoRecord(typename UndoRecord::Kind kind);
+  /* undoes logged changes, latest first, until the log is mark long */
+  void Undo(std::size_t mark);
 
   /* set of all Nodes, which are owned by unique pointers. This instantiation of
    * WrapperComp compares Nodes (orders) solely based on the Node value N. */
-  std::set<std::unique_ptr<Node>, WrapperComp<N, std::unique_ptr<Node>>> nodes_;
+  NodeSet nodes_;
   /* set of all Edges, owned by shared pointers. Note that there is only ever
    * 1 shared pointer per Edge in this set. This instantiation of WrapperComp
    * compares Edges (orders) based on src, then dst, then edge weight */
-  std::set<std::shared_ptr<Edge>, WrapperComp<E, std::shared_ptr<Edge>>> edges_;
+  EdgeSet edges_;
+  /* null unless EnableWeightIndex has been called. AddEdge, EraseEdge and
+   * RenameNode keep it in step with edges_ */
+  std::unique_ptr<WeightIndex> weight_index_;
+  /* the open Transaction's log, which every change is recorded in, or null */
+  std::vector<UndoRecord>* undo_log_{nullptr};
+  /* bumped whenever an outermost Transaction ends, so an inner one outliving it
+   * can tell its log is gone */
+  std::uint64_t undo_generation_{0};
 };
 
 }  // namespace gdwg
@@ -1,8 +1,13 @@
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <set>
+#include <stdexcept>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -20,7 +25,7 @@ gdwg::Graph<N, E>::Graph(typename std::vector<std::tuple<N, N, E>>::const_iterat
                          typename std::vector<std::tuple<N, N, E>>::const_iterator e) {
   for (; b != e; ++b) {
     /* unpack the current tuple */
-    auto [src, dst, weight] = *b;
+    const auto& [src, dst, weight] = *b;
     /* add the nodes if they don't already exist */
     InsertNode(src);
     InsertNode(dst);
@@ -31,13 +36,14 @@ gdwg::Graph<N, E>::Graph(typename std::vector<std::tuple<N, N, E>>::const_iterat
 
 template <typename N, typename E>
 gdwg::Graph<N, E>::Graph(std::initializer_list<N> il) {
-  for (auto it : il) {
+  for (const auto& it : il) {
     InsertNode(it);
   }
 }
 
 template <typename N, typename E>
 gdwg::Graph<N, E>::Graph(const gdwg::Graph<N, E>& orig) {
+  GDWG_TIME_OP(kCopy);
   /* deep copy because we have unique ptrs inside graphs which cannot be copied
    * constructed or copy assigned */
 
@@ -47,8 +53,12 @@ gdwg::Graph<N, E>::Graph(const gdwg::Graph<N, E>& orig) {
    * empty (We cannot copy those because the Edge struct
    * pointers (addresses) refer to Nodes in orig, not this (new graph)) */
   for (auto on_it = orig.nodes_.begin(); on_it != orig.nodes_.end(); ++on_it) {
+    GDWG_COUNT(kNodeAllocations);
     nodes_.insert(std::make_unique<Node>((*on_it)->value_));
   }
+  /* an index on the original means one on the copy, which InsertEdge fills */
+  if (orig.weight_index_)
+    weight_index_ = std::make_unique<WeightIndex>();
   /* now copy the edges. It isn't sufficient to just call this
    * and skip above because then isolated nodes would not be in the graph */
   for (auto oe_it = orig.edges_.begin(); oe_it != orig.edges_.end(); ++oe_it) {
@@ -60,17 +70,61 @@ template <typename N, typename E>
 gdwg::Graph<N, E>::Graph(gdwg::Graph<N, E>&& recyclee) {
   nodes_ = std::move(recyclee.nodes_);
   edges_ = std::move(recyclee.edges_);
+  weight_index_ = std::move(recyclee.weight_index_);
+}
+
+template <typename N, typename E>
+gdwg::Graph<N, E>
+gdwg::Graph<N, E>::FromSortedIds(std::vector<N> nodes,
+                                 std::vector<std::tuple<std::uint32_t, std::uint32_t, E>> edges) {
+  auto not_increasing = [](const auto& a, const auto& b) { return !(a < b); };
+  const auto n = nodes.size();
+  auto bad_id = [n](const auto& edge) { return std::get<0>(edge) >= n || std::get<1>(edge) >= n; };
+  if (std::adjacent_find(nodes.begin(), nodes.end(), not_increasing) != nodes.end() ||
+      std::adjacent_find(edges.begin(), edges.end(), not_increasing) != edges.end() ||
+      std::any_of(edges.begin(), edges.end(), bad_id)) {
+    throw std::invalid_argument(
+        "Cannot call Graph::FromSortedIds with nodes or edges that aren't strictly increasing ids");
+  }
+
+  /* everything arrives in set order, so each insert goes straight in at the end */
+  Graph g{};
+  std::vector<Node*> by_id{};
+  by_id.reserve(n);
+  for (auto& val : nodes) {
+    GDWG_COUNT(kNodeAllocations);
+    by_id.push_back(g.nodes_.insert(g.nodes_.end(), std::make_unique<Node>(std::move(val)))->get());
+  }
+  /* a node's incoming edges are ordered by src first, which is also the order
+   * they turn up in here */
+  for (auto& [src, dst, w] : edges) {
+    GDWG_COUNT(kEdgeAllocations);
+    Node* src_node = by_id[src];
+    Node* dst_node = by_id[dst];
+    const auto& edge_sp =
+        *g.edges_.insert(g.edges_.end(), std::make_shared<Edge>(src_node, dst_node, std::move(w)));
+    src_node->outgoing_.insert(src_node->outgoing_.end(), std::weak_ptr<Edge>(edge_sp));
+    dst_node->incoming_.insert(dst_node->incoming_.end(), std::weak_ptr<Edge>(edge_sp));
+  }
+  return g;
 }
 
 template <typename N, typename E>
 gdwg::Graph<N, E>& gdwg::Graph<N, E>::operator=(const gdwg::Graph<N, E>& other) {
+  GDWG_TIME_OP(kCopy);
   /* this is essentially the same as the copy ctor, and
    * I am doing the same thing for the same reasons so
    * see it's comment :) */
   /* deep copy nodes */
   for (auto on_it = other.nodes_.begin(); on_it != other.nodes_.end(); ++on_it) {
+    GDWG_COUNT(kNodeAllocations);
     nodes_.insert(std::make_unique<Node>((*on_it)->value_));
   }
+  /* the index is there afterwards if and only if other has one */
+  if (other.weight_index_)
+    EnableWeightIndex();
+  else
+    DisableWeightIndex();
   /* deep copy edges */
   for (auto oe_it = other.edges_.begin(); oe_it != other.edges_.end(); ++oe_it) {
     InsertEdge((*oe_it)->src_->value_, (*oe_it)->dst_->value_, (*oe_it)->value_);
@@ -82,19 +136,71 @@ template <typename N, typename E>
 gdwg::Graph<N, E>& gdwg::Graph<N, E>::operator=(gdwg::Graph<N, E>&& recyclee) {
   nodes_ = std::move(recyclee.nodes_);
   edges_ = std::move(recyclee.edges_);
+  weight_index_ = std::move(recyclee.weight_index_);
   return *this;
 }
 
 template <typename N, typename E>
 bool gdwg::Graph<N, E>::InsertNode(const N& val) {
+  GDWG_TIME_OP(kInsertNode);
   /* if the graph doesn't already contain this node then insert */
   if (IsNode(val))
     return false;
-  return this->nodes_.insert(std::make_unique<Node>(val)).second;
+  auto* record = NewUndoRecord(UndoRecord::Kind::kInsertNode);
+  GDWG_COUNT(kNodeAllocations);
+  auto node_it = this->nodes_.insert(std::make_unique<Node>(val)).first;
+  if (record)
+    record->node = node_it->get();
+  return true;
+}
+
+template <typename N, typename E>
+bool gdwg::Graph<N, E>::InsertNode(N&& val) {
+  GDWG_TIME_OP(kInsertNode);
+  if (IsNode(val))
+    return false;
+  auto* record = NewUndoRecord(UndoRecord::Kind::kInsertNode);
+  GDWG_COUNT(kNodeAllocations);
+  auto node_it = this->nodes_.insert(std::make_unique<Node>(std::move(val))).first;
+  if (record)
+    record->node = node_it->get();
+  return true;
+}
+
+template <typename N, typename E>
+template <typename... Args>
+bool gdwg::Graph<N, E>::EmplaceNode(Args&&... args) {
+  GDWG_TIME_OP(kInsertNode);
+  GDWG_COUNT(kNodeAllocations);
+  auto node = std::make_unique<Node>(std::in_place, std::forward<Args>(args)...);
+  Node* node_ptr = node.get();
+  auto* record = NewUndoRecord(UndoRecord::Kind::kInsertNode);
+  /* if the value is already there, insert leaves the new node to be freed */
+  const bool inserted = nodes_.insert(std::move(node)).second;
+  if (record) {
+    if (inserted) {
+      record->node = node_ptr;
+    } else {
+      undo_log_->pop_back();
+    }
+  }
+  return inserted;
 }
 
 template <typename N, typename E>
 bool gdwg::Graph<N, E>::InsertEdge(const N& src, const N& dst, const E& w) {
+  return AddEdge(src, dst, w);
+}
+
+template <typename N, typename E>
+bool gdwg::Graph<N, E>::InsertEdge(const N& src, const N& dst, E&& w) {
+  return AddEdge(src, dst, std::move(w));
+}
+
+template <typename N, typename E>
+template <typename W>
+bool gdwg::Graph<N, E>::AddEdge(const N& src, const N& dst, W&& w) {
+  GDWG_TIME_OP(kInsertEdge);
   /* see if both nodes exists in the graph, if not throw */
   auto src_it = this->nodes_.find(src);
   auto dst_it = this->nodes_.find(dst);
@@ -107,40 +213,88 @@ bool gdwg::Graph<N, E>::InsertEdge(const N& src, const N& dst, const E& w) {
     return false;
 
   /* otherwise add the edge to the graphs edges_ set */
-  auto new_edge_it = edges_.insert(std::make_shared<Edge>(src_it->get(), dst_it->get(), w)).first;
+  auto* record = NewUndoRecord(UndoRecord::Kind::kInsertEdge);
+  GDWG_COUNT(kEdgeAllocations);
+  auto new_edge_it =
+      edges_.insert(std::make_shared<Edge>(src_it->get(), dst_it->get(), std::forward<W>(w)))
+          .first;
+  if (record)
+    record->edge = new_edge_it->get();
   /* and now update the book-keeping on the Nodes edges sets (outgoing for src and incoming for dst)
    */
   bool out_succ = (*src_it)->outgoing_.insert(std::weak_ptr<Edge>(*new_edge_it)).second;
   bool in_succ = (*dst_it)->incoming_.insert(std::weak_ptr<Edge>(*new_edge_it)).second;
+  if (weight_index_) {
+    const Edge* edge = new_edge_it->get();
+    weight_index_->by_weight.insert(edge);
+    weight_index_->by_source.insert(edge);
+  }
   return (out_succ && in_succ);
 }
 
 template <typename N, typename E>
 bool gdwg::Graph<N, E>::DeleteNode(const N& deletee) {
-  /* no point looping all edges below if the node doesn't even exist */
-  if (!IsNode(deletee))
+  GDWG_TIME_OP(kDeleteNode);
+  auto deletee_it = nodes_.find(deletee);
+  if (deletee_it == nodes_.end())
     return false;
+  EraseNode(deletee_it);
+  return true;
+}
 
-  /* node exists, so firstly need to delete the nodes edges */
-  for (auto edges_it = edges_.begin(); edges_it != edges_.end();) {
-    /* if the deletee node is part of this edge then delete it */
-    if ((*edges_it)->src_->value_ == deletee || (*edges_it)->dst_->value_ == deletee) {
-      edges_it = edges_.erase(edges_it);
-    } else {  // otherwise just continue
-      ++edges_it;
-    }
+template <typename N, typename E>
+std::optional<N> gdwg::Graph<N, E>::ExtractNode(const N& val) {
+  GDWG_TIME_OP(kDeleteNode);
+  auto node_it = nodes_.find(val);
+  if (node_it == nodes_.end())
+    return std::nullopt;
+  /* an open transaction keeps the node, so its value can only be copied out */
+  if (undo_log_) {
+    std::optional<N> value{(*node_it)->value_};
+    EraseNode(node_it);
+    return value;
   }
+  return std::move(EraseNode(node_it)->value_);
+}
 
-  /* now delete the node */
-  auto deletee_it = this->nodes_.find(deletee);
-  if (deletee_it == this->nodes_.end())
-    return false; /* this shouldn't occur but do it for safety */
-  nodes_.erase(deletee_it);
-  return true;
+template <typename N, typename E>
+std::size_t gdwg::Graph<N, E>::DeleteNodes(std::vector<N> deletees) {
+  GDWG_TIME_OP(kDeleteNode);
+  std::sort(deletees.begin(), deletees.end());
+  deletees.erase(std::unique(deletees.begin(), deletees.end()), deletees.end());
+  /* a few deletees are each looked up, but once they are a good fraction of
+   * the graph a single walk along nodes_ beside them is cheaper */
+  std::size_t num_deleted = 0;
+  if (deletees.size() * 16 < nodes_.size()) {
+    for (const auto& deletee : deletees) {
+      auto node_it = nodes_.find(deletee);
+      if (node_it != nodes_.end()) {
+        EraseNode(node_it);
+        ++num_deleted;
+      }
+    }
+    return num_deleted;
+  }
+  auto node_it = nodes_.cbegin();
+  for (const auto& deletee : deletees) {
+    while (node_it != nodes_.cend() && (*node_it)->value_ < deletee)
+      ++node_it;
+    if (node_it == nodes_.cend())
+      break;
+    if (deletee < (*node_it)->value_)
+      continue;
+    /* EraseNode only invalidates the iterator to the node it erases */
+    auto next = std::next(node_it);
+    EraseNode(node_it);
+    node_it = next;
+    ++num_deleted;
+  }
+  return num_deleted;
 }
 
 template <typename N, typename E>
 bool gdwg::Graph<N, E>::Replace(const N& old_data, const N& new_data) {
+  GDWG_TIME_OP(kReplace);
   /* if a node with old_data doesn't even exist then throw */
   auto old_node = nodes_.find(old_data);
   if (old_node == nodes_.end()) {
@@ -149,41 +303,15 @@ bool gdwg::Graph<N, E>::Replace(const N& old_data, const N& new_data) {
   /* if there is already a node with new data, return false */
   if (IsNode(new_data))
     return false;
-  /* otherwise create a new node with the new data */
-  InsertNode(new_data);
-  /* now get the same outgoing edges as the old node */
-  for (auto edge_wp : (*old_node)->outgoing_) {
-    /* only get the edge if it isn't expired */
-    if (!edge_wp.expired()) {
-      auto edge_sp = edge_wp.lock();
-      /* reflexive edges must be reflexive on new node and
-       * not be an edge between new node and old node */
-      if (edge_sp->dst_->value_ == old_data) {
-        InsertEdge(new_data, new_data, edge_sp->value_);
-      } else {
-        InsertEdge(new_data, edge_sp->dst_->value_, edge_sp->value_);
-      }
-    }
-  }
-  /* and now the same for the incoming edges */
-  for (auto edge_wp : (*old_node)->incoming_) {
-    /* only get the edge if it isn't expired */
-    if (!edge_wp.expired()) {
-      auto edge_sp = edge_wp.lock();
-      /* if we encounter a reflexive edge here, because we
-       * already handled it above, we just skip it */
-      if (edge_sp->src_->value_ == old_data)
-        continue;
-      InsertEdge(edge_sp->src_->value_, new_data, edge_sp->value_);
-    }
-  }
-  /* now delete the old node */
-  DeleteNode(old_data);
+  /* otherwise rename the node in place. Its edges come along as they are, so
+   * no weights are copied */
+  RenameNode(old_node, new_data);
   return true;
 }
 
 template <typename N, typename E>
 void gdwg::Graph<N, E>::MergeReplace(const N& replacee, const N& replacer) {
+  GDWG_TIME_OP(kMergeReplace);
   /* try find both the replacer and replacee nodes, if either doesn't exist then throw */
   auto replacee_it = nodes_.find(replacee);
   auto replacer_it = nodes_.find(replacer);
@@ -191,43 +319,53 @@ void gdwg::Graph<N, E>::MergeReplace(const N& replacee, const N& replacer) {
     throw std::runtime_error(
         "Cannot call Graph::MergeReplace on old or new data if they don't exist in the graph");
   }
+  /* if any step throws, the ones before it are undone */
+  Transaction transaction{*this};
   /* loop through the outgoing edges of replacer and add them to
    * replacee (removing dupes as necessary) */
-  for (auto edge_wp : (*replacer_it)->outgoing_) {
-    /* only get the edge if it isn't expired */
-    if (!edge_wp.expired()) {
-      auto edge_sp = edge_wp.lock();
-      InsertEdge(replacee, edge_sp->dst_->value_, edge_sp->value_);
-    }
+  for (const auto& edge_wp : (*replacer_it)->outgoing_) {
+    auto edge_sp = edge_wp.lock();
+    InsertEdge(replacee, edge_sp->dst_->value_, edge_sp->value_);
   }
   /* now do the same but for incoming edges of replacer */
-  for (auto edge_wp : (*replacer_it)->incoming_) {
-    /* only get the edge if it isn't expired */
-    if (!edge_wp.expired()) {
-      auto edge_sp = edge_wp.lock();
-      InsertEdge(edge_sp->src_->value_, replacee, edge_sp->value_);
-    }
+  for (const auto& edge_wp : (*replacer_it)->incoming_) {
+    auto edge_sp = edge_wp.lock();
+    InsertEdge(edge_sp->src_->value_, replacee, edge_sp->value_);
   }
   /* now delete replacer from the graph */
   DeleteNode(replacer);
   /* and now, Replace replacee's value with replacer */
   Replace(replacee, replacer);
+  transaction.Commit();
 }
 
 template <typename N, typename E>
 void gdwg::Graph<N, E>::Clear() {
+  GDWG_TIME_OP(kClear);
+  /* an open transaction needs every node and edge logged */
+  if (undo_log_) {
+    while (!nodes_.empty())
+      EraseNode(nodes_.begin());
+    return;
+  }
   nodes_.clear();
   edges_.clear();
+  if (weight_index_) {
+    weight_index_->by_weight.clear();
+    weight_index_->by_source.clear();
+  }
 }
 
 template <typename N, typename E>
 bool gdwg::Graph<N, E>::IsNode(const N& val) const {
+  GDWG_TIME_OP(kIsNode);
   auto node_it = this->nodes_.find(val);
   return node_it != this->nodes_.end();
 }
 
 template <typename N, typename E>
 bool gdwg::Graph<N, E>::IsConnected(const N& src, const N& dst) const {
+  GDWG_TIME_OP(kIsConnected);
   /* see if both nodes exists in the graph, if not throw */
   auto src_it = this->nodes_.find(src);
   auto dst_it = this->nodes_.find(dst);
@@ -236,17 +374,11 @@ bool gdwg::Graph<N, E>::IsConnected(const N& src, const N& dst) const {
         "Cannot call Graph::IsConnected if src or dst node don't exist in the graph");
   }
   /* loop through all the outgoing edges of src */
-  for (auto oe_it = (*src_it)->outgoing_.begin(); oe_it != (*src_it)->outgoing_.end(); ++oe_it) {
-    /* may as well erase and expired edges whilst we are at it */
-    if (oe_it->expired()) {
-      oe_it = (*src_it)->outgoing_.erase(oe_it);
-      continue;
-    } else {
-      auto edge_sp = oe_it->lock();
-      /* if we find an edge that connects the two nodes then return true */
-      if (edge_sp->dst_->value_ == dst) {
-        return true;
-      }
+  for (const auto& edge_wp : (*src_it)->outgoing_) {
+    auto edge_sp = edge_wp.lock();
+    /* if we find an edge that connects the two nodes then return true */
+    if (edge_sp->dst_->value_ == dst) {
+      return true;
     }
   }
   return false; /* didn't find any connecting edges */
@@ -254,6 +386,7 @@ bool gdwg::Graph<N, E>::IsConnected(const N& src, const N& dst) const {
 
 template <typename N, typename E>
 std::vector<N> gdwg::Graph<N, E>::GetNodes() const {
+  GDWG_TIME_OP(kGetNodes);
   std::vector<N> node_vec{};
   for (auto& node : nodes_) {
     node_vec.push_back(node->value_);
@@ -263,6 +396,7 @@ std::vector<N> gdwg::Graph<N, E>::GetNodes() const {
 
 template <typename N, typename E>
 std::vector<N> gdwg::Graph<N, E>::GetConnected(const N& src) const {
+  GDWG_TIME_OP(kGetConnected);
   /* see if the src node even exists, throw if not */
   auto src_it = this->nodes_.find(src);
   if (src_it == this->nodes_.end()) {
@@ -271,16 +405,10 @@ std::vector<N> gdwg::Graph<N, E>::GetConnected(const N& src) const {
   /* I use a set so that N's are only added once and are ordered implicitly */
   std::set<N> node_set{};
   /* loop through all the outgoing edges of src */
-  for (auto oe_it = (*src_it)->outgoing_.begin(); oe_it != (*src_it)->outgoing_.end(); ++oe_it) {
-    /* may as well erase whilst i am looping */
-    if (oe_it->expired()) {
-      oe_it = (*src_it)->outgoing_.erase(oe_it);
-      continue;
-    } else {
-      auto edge_sp = oe_it->lock();
-      /* add the node value of this connected node */
-      node_set.insert(edge_sp->dst_->value_);
-    }
+  for (const auto& edge_wp : (*src_it)->outgoing_) {
+    auto edge_sp = edge_wp.lock();
+    /* add the node value of this connected node */
+    node_set.insert(edge_sp->dst_->value_);
   }
   /* return a vector of the set values */
   return std::vector<N>{node_set.begin(), node_set.end()};
@@ -288,6 +416,7 @@ std::vector<N> gdwg::Graph<N, E>::GetConnected(const N& src) const {
 
 template <typename N, typename E>
 std::vector<E> gdwg::Graph<N, E>::GetWeights(const N& src, const N& dst) const {
+  GDWG_TIME_OP(kGetWeights);
   /* see if both nodes exists in the graph, if not throw */
   auto src_it = this->nodes_.find(src);
   if (src_it == this->nodes_.end() || !IsNode(dst)) {
@@ -297,36 +426,65 @@ std::vector<E> gdwg::Graph<N, E>::GetWeights(const N& src, const N& dst) const {
   /* using a set so E's are only added once */
   std::set<E> edge_set{};
   /* loop through all the outgoing edges of src */
-  for (auto oe_it = (*src_it)->outgoing_.begin(); oe_it != (*src_it)->outgoing_.end(); ++oe_it) {
-    if (oe_it->expired()) {
-      oe_it = (*src_it)->outgoing_.erase(oe_it);
-      continue;
-    } else {
-      auto edge_sp = oe_it->lock();
-      if (edge_sp->dst_->value_ == dst) {
-        /* add the edge value of this edge to the connected node */
-        edge_set.insert(edge_sp->value_);
-      }
+  for (const auto& edge_wp : (*src_it)->outgoing_) {
+    auto edge_sp = edge_wp.lock();
+    if (edge_sp->dst_->value_ == dst) {
+      /* add the edge value of this edge to the connected node */
+      edge_set.insert(edge_sp->value_);
     }
   }
   return std::vector<E>{edge_set.begin(), edge_set.end()};
 }
 
+template <typename N, typename E>
+std::size_t gdwg::Graph<N, E>::InDegree(const N& val) const {
+  auto node_it = nodes_.find(val);
+  if (node_it == nodes_.end()) {
+    throw std::out_of_range("Cannot call Graph::InDegree if the node doesn't exist in the graph");
+  }
+  return (*node_it)->incoming_.size();
+}
+
+template <typename N, typename E>
+std::size_t gdwg::Graph<N, E>::OutDegree(const N& val) const {
+  auto node_it = nodes_.find(val);
+  if (node_it == nodes_.end()) {
+    throw std::out_of_range("Cannot call Graph::OutDegree if the node doesn't exist in the graph");
+  }
+  return (*node_it)->outgoing_.size();
+}
+
+template <typename N, typename E>
+std::vector<std::size_t> gdwg::Graph<N, E>::InDegrees() const {
+  std::vector<std::size_t> degrees{};
+  degrees.reserve(nodes_.size());
+  for (const auto& node_up : nodes_) {
+    degrees.push_back(node_up->incoming_.size());
+  }
+  return degrees;
+}
+
+template <typename N, typename E>
+std::vector<std::size_t> gdwg::Graph<N, E>::OutDegrees() const {
+  std::vector<std::size_t> degrees{};
+  degrees.reserve(nodes_.size());
+  for (const auto& node_up : nodes_) {
+    degrees.push_back(node_up->outgoing_.size());
+  }
+  return degrees;
+}
+
 template <typename N, typename E>
 typename gdwg::Graph<N, E>::const_iterator
 gdwg::Graph<N, E>::find(const N& src, const N& dst, const E& w) const {
-  /* use the edge iterater to iterate over all edges in the graph */
-  for (auto it = cbegin(); it != cend(); ++it) {
-    /* if we find a matching edge, return iterator to it */
-    if (src == std::get<0>(*it) && dst == std::get<1>(*it) && w == std::get<2>(*it)) {
-      return it;
-    }
-  }
-  return cend(); /* didn't find edge so return end */
+  GDWG_TIME_OP(kFind);
+  /* edges_ is ordered by (src, dst, w) so we can look the edge straight up */
+  return const_iterator{edges_.find(std::tie(src, dst, w))};
 }
 
 template <typename N, typename E>
 bool gdwg::Graph<N, E>::erase(const N& src, const N& dst, const E& w) {
+  GDWG_TIME_OP(kErase);
   /* try find the edge */
   auto edge_it = find(src, dst, w);
   if (edge_it == cend())
@@ -338,148 +496,522 @@ bool gdwg::Graph<N, E>::erase(const N& src, const N& dst, const E& w) {
 
 template <typename N, typename E>
 typename gdwg::Graph<N, E>::const_iterator gdwg::Graph<N, E>::erase(const_iterator it) {
+  GDWG_TIME_OP(kErase);
   /* trying to erase end so just return end */
   if (it == end())
     return end();
-  /* save a copy of the current iterator as we need to delete it,
-   * and increment it because we need to return it */
-  auto deletee_it = it++;
-  /* now search the set of shared_ptr to Edges until we find this
-   * edge, then delete it */
-  for (auto edge_it = edges_.begin(); edge_it != edges_.end(); ++edge_it) {
-    /* get the current edge values (src, dst, w) */
-    auto src = (*edge_it)->src_->value_;
-    auto dst = (*edge_it)->dst_->value_;
-    auto w = (*edge_it)->value_;
-    /* if it's a match, erase the owning shared pointer */
-    if (src == std::get<0>(*deletee_it) && dst == std::get<1>(*deletee_it) &&
-        w == std::get<2>(*deletee_it)) {
-      edges_.erase(edge_it);
-      break;
-    }
+  /* the iterator already refers to the owning pointer in edges_, so erase it
+   * directly and hand back an iterator to the edge after it */
+  return const_iterator{EraseEdge(it.edge_it_)};
+}
+
+template <typename N, typename E>
+typename gdwg::Graph<N, E>::EdgeSet::const_iterator
+gdwg::Graph<N, E>::EraseEdge(typename EdgeSet::const_iterator edge_it) {
+  if (auto* record = NewUndoRecord(UndoRecord::Kind::kEraseEdge)) {
+    auto next = std::next(edge_it);
+    record->erased_edge = UnlinkEdge(edge_it);
+    return next;
+  }
+  const auto& edge_sp = *edge_it;
+  /* the edge is still alive here, so it can be found in the adjacency sets */
+  std::weak_ptr<Edge> edge_wp{edge_sp};
+  edge_sp->src_->outgoing_.erase(edge_wp);
+  GDWG_COUNT(kAdjacencyCleanups);
+  edge_sp->dst_->incoming_.erase(edge_wp);
+  GDWG_COUNT(kAdjacencyCleanups);
+  if (weight_index_) {
+    const Edge* edge = edge_sp.get();
+    weight_index_->by_weight.erase(edge);
+    weight_index_->by_source.erase(edge);
   }
-  return it;
+  return edges_.erase(edge_it);
 }
 
 template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator gdwg::Graph<N, E>::cbegin() const {
-  /* loop through the graph nodes (because we can only start at an un-isolated node) */
-  for (auto nodes_it = nodes_.begin(); nodes_it != nodes_.end(); ++nodes_it) {
-    auto edges_it = (*nodes_it)->outgoing_.begin();
-    auto edges_end = (*nodes_it)->outgoing_.end();
-
-    /* loop through the current nodes outgoing edges */
-    while (edges_it != edges_end) {
-      /* remove any expired wp's as we iterate through */
-      if (edges_it->expired()) {
-        edges_it = ((*nodes_it)->outgoing_).erase(edges_it);
-        continue;
-      } else { /* not expired, so this is the first valid edge */
-        /* create a new iterator at this edge and return it */
-        return {nodes_it, edges_it, nodes_.end(), nodes_.begin()};
+std::unique_ptr<typename gdwg::Graph<N, E>::Node>
+gdwg::Graph<N, E>::EraseNode(typename NodeSet::const_iterator node_it) {
+  /* EraseEdge takes each edge out of these sets, so just keep erasing the first
+   * one until they are empty (a reflexive edge leaves both at once) */
+  const Node& node = **node_it;
+  while (!node.outgoing_.empty()) {
+    auto edge_sp = node.outgoing_.begin()->lock();
+    EraseEdge(edges_.find(edge_sp));
+  }
+  while (!node.incoming_.empty()) {
+    auto edge_sp = node.incoming_.begin()->lock();
+    EraseEdge(edges_.find(edge_sp));
+  }
+  if (auto* record = NewUndoRecord(UndoRecord::Kind::kEraseNode)) {
+    record->erased_node = nodes_.extract(node_it);
+    return nullptr;
+  }
+  return std::move(nodes_.extract(node_it).value());
+}
+
+template <typename N, typename E>
+void gdwg::Graph<N, E>::RenameNode(typename NodeSet::const_iterator node_it, const N& new_data) {
+  Node& node = **node_it;
+  auto* record = NewUndoRecord(UndoRecord::Kind::kRenameNode);
+  /* copying new_data and making room for the edges are all that can throw, so
+   * they come before the node or its edges leave any set. In a transaction the
+   * record keeps both, so undoing the rename can't throw either */
+  std::optional<N> local_value{};
+  std::vector<UnlinkedEdge> local_unlinked{};
+  auto& value = record ? record->old_value : local_value;
+  auto& unlinked = record ? record->unlinked : local_unlinked;
+  unlinked.reserve(node.outgoing_.size() + node.incoming_.size());
+  value.emplace(new_data);
+  RekeyNode(node_it, *value, unlinked);
+  if (record)
+    record->node = &node;
+}
+
+template <typename N, typename E>
+void gdwg::Graph<N, E>::RekeyNode(typename NodeSet::const_iterator node_it,
+                                  N& value,
+                                  std::vector<UnlinkedEdge>& unlinked) {
+  Node& node = **node_it;
+  /* each edge touching the node comes out of every set it is in. A reflexive
+   * edge leaves both of the node's sets at once, as in EraseNode */
+  while (!node.outgoing_.empty()) {
+    unlinked.push_back(UnlinkEdge(edges_.find(node.outgoing_.begin()->lock())));
+  }
+  while (!node.incoming_.empty()) {
+    unlinked.push_back(UnlinkEdge(edges_.find(node.incoming_.begin()->lock())));
+  }
+
+  auto node_handle = nodes_.extract(node_it);
+  /* moved rather than copied, so the old value comes back out in value */
+  using std::swap;
+  swap(node_handle.value()->value_, value);
+  nodes_.insert(std::move(node_handle));
+  for (auto& edge : unlinked) {
+    LinkEdge(std::move(edge));
+  }
+  unlinked.clear();
+}
+
+template <typename N, typename E>
+typename gdwg::Graph<N, E>::UnlinkedEdge
+gdwg::Graph<N, E>::UnlinkEdge(typename EdgeSet::const_iterator edge_it) {
+  const Edge* edge = edge_it->get();
+  std::weak_ptr<Edge> edge_wp{*edge_it};
+  UnlinkedEdge unlinked{};
+  unlinked.out = edge->src_->outgoing_.extract(edge_wp);
+  unlinked.in = edge->dst_->incoming_.extract(edge_wp);
+  if (weight_index_) {
+    unlinked.by_weight = weight_index_->by_weight.extract(edge);
+    unlinked.by_source = weight_index_->by_source.extract(edge);
+  }
+  unlinked.owner = edges_.extract(edge_it);
+  return unlinked;
+}
+
+template <typename N, typename E>
+void gdwg::Graph<N, E>::LinkEdge(UnlinkedEdge&& edge) {
+  const auto& edge_sp = edge.owner.value();
+  edge_sp->src_->outgoing_.insert(std::move(edge.out));
+  edge_sp->dst_->incoming_.insert(std::move(edge.in));
+  if (weight_index_) {
+    weight_index_->by_weight.insert(std::move(edge.by_weight));
+    weight_index_->by_source.insert(std::move(edge.by_source));
+  }
+  edges_.insert(std::move(edge.owner));
+}
+
+template <typename N, typename E>
+typename gdwg::Graph<N, E>::UndoRecord*
+gdwg::Graph<N, E>::NewUndoRecord(typename UndoRecord::Kind kind) {
+  if (!undo_log_)
+    return nullptr;
+  auto& record = undo_log_->emplace_back();
+  record.kind = kind;
+  return &record;
+}
+
+template <typename N, typename E>
+void gdwg::Graph<N, E>::Undo(std::size_t mark) {
+  /* the log is set aside, so undoing a change doesn't log anything itself */
+  auto* log = std::exchange(undo_log_, nullptr);
+  try {
+    while (log->size() > mark) {
+      auto& record = log->back();
+      switch (record.kind) {
+        case UndoRecord::Kind::kInsertNode:
+          /* anything added to it later has already been undone */
+          if (record.node)
+            nodes_.erase(nodes_.find(record.node->value_));
+          break;
+        case UndoRecord::Kind::kEraseNode:
+          nodes_.insert(std::move(record.erased_node));
+          break;
+        case UndoRecord::Kind::kInsertEdge:
+          if (record.edge) {
+            const Edge& edge = *record.edge;
+            EraseEdge(edges_.find(std::tie(edge.src_->value_, edge.dst_->value_, edge.value_)));
+          }
+          break;
+        case UndoRecord::Kind::kEraseEdge:
+          LinkEdge(std::move(record.erased_edge));
+          break;
+        case UndoRecord::Kind::kRenameNode:
+          /* the old value is swapped (moved) back in, and the edges go through
+           * the room kept for them, so this can't throw */
+          if (record.node)
+            RekeyNode(nodes_.find(record.node->value_), *record.old_value, record.unlinked);
+          break;
+        case UndoRecord::Kind::kEnableIndex:
+          weight_index_.reset();
+          break;
+        case UndoRecord::Kind::kDisableIndex:
+          weight_index_ = std::move(record.weight_index);
+          break;
       }
-      ++edges_it;
+      log->pop_back();
     }
+  } catch (...) {
+    /* left open, so the log is still there for whatever handles this */
+    undo_log_ = log;
+    throw;
   }
-  return cend(); /* no edges, return end */
+  undo_log_ = log;
 }
 
 template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator gdwg::Graph<N, E>::cend() const {
-  /* node it (outer) is end, thus edge it (inner) is just an empty iterator
-   * and the sentinals are always the end and begin no matter what */
-  return {nodes_.end(), {}, nodes_.end(), nodes_.begin()};
-}
-
-template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator& gdwg::Graph<N, E>::const_iterator::operator++() {
-  /* increment the edge iterator */
-  ++edge_it_;
-
-  /* it is now possible that edge_it_ is actually the end() iterator
-   * of the current edges container (i.e. node->outgoing set) we are up
-   * to OR it is an expired edge (weak pointer it refers to is expired) */
-  while (edge_it_ == (*node_it_)->outgoing_.end() || edge_it_->expired()) {
-    /* if we got to the end of current outgoing edges set, go to next nodes one */
-    if (edge_it_ == (*node_it_)->outgoing_.end()) {
-      ++node_it_;
-      /* if there was no next node, return equivalent of empty iterator */
-      if (node_it_ == node_end_it_) {
-        edge_it_ = typename std::set<std::weak_ptr<Edge>>::iterator{};
-        return *this;
-      }
-      /* otherwise set the edge iterator to be the begin of the new edges set */
-      edge_it_ = (*node_it_)->outgoing_.begin();
-    } else { /* we got an expired edge, erase it and continue search */
-      edge_it_ = (*node_it_)->outgoing_.erase(edge_it_);
+void gdwg::Graph<N, E>::Apply(const GraphPatch<N, E>& patch) {
+  GDWG_TIME_OP(kApply);
+  /* check the whole patch before changing anything. Sorted copies of the node
+   * lists answer "will this node be gone / be new" without a set per lookup */
+  std::vector<N> removed{patch.removed_nodes};
+  std::vector<N> added{patch.added_nodes};
+  std::sort(removed.begin(), removed.end());
+  std::sort(added.begin(), added.end());
+  auto exists_after = [&](const N& val) {
+    return std::binary_search(added.begin(), added.end(), val) ||
+           (IsNode(val) && !std::binary_search(removed.begin(), removed.end(), val));
+  };
+  bool fits = true;
+  for (const auto& val : removed) {
+    fits = fits && IsNode(val);
+  }
+  for (const auto& [src, dst, w] : patch.removed_edges) {
+    fits = fits && edges_.find(std::tie(src, dst, w)) != edges_.end();
+  }
+  for (const auto& val : added) {
+    fits = fits && !IsNode(val);
+  }
+  for (const auto& [src, dst, w] : patch.added_edges) {
+    fits = fits && exists_after(src) && exists_after(dst) &&
+           (find(src, dst, w) == cend() ||
+            std::binary_search(removed.begin(), removed.end(), src) ||
+            std::binary_search(removed.begin(), removed.end(), dst));
+  }
+  if (!fits) {
+    throw std::runtime_error("Cannot call Graph::Apply with a patch that doesn't fit this graph");
+  }
+
+  /* a patch that repeats itself is harmless: anything already gone is skipped
+   * and inserting something twice is a no-op */
+  for (const auto& [src, dst, w] : patch.removed_edges) {
+    auto edge_it = edges_.find(std::tie(src, dst, w));
+    if (edge_it != edges_.end())
+      EraseEdge(edge_it);
+  }
+  for (const auto& val : removed) {
+    auto node_it = nodes_.find(val);
+    if (node_it != nodes_.end())
+      EraseNode(node_it);
+  }
+  for (const auto& val : added) {
+    InsertNode(val);
+  }
+  for (const auto& [src, dst, w] : patch.added_edges) {
+    InsertEdge(src, dst, w);
+  }
+}
+
+template <typename N, typename E>
+void gdwg::Graph<N, E>::EnableWeightIndex() {
+  if (weight_index_)
+    return;
+  NewUndoRecord(UndoRecord::Kind::kEnableIndex);
+  weight_index_ = std::make_unique<WeightIndex>();
+  for (const auto& edge_sp : edges_) {
+    weight_index_->by_weight.insert(edge_sp.get());
+    weight_index_->by_source.insert(edge_sp.get());
+  }
+}
+
+template <typename N, typename E>
+void gdwg::Graph<N, E>::DisableWeightIndex() {
+  if (!weight_index_)
+    return;
+  /* an open transaction keeps the index, in case it is rolled back */
+  if (auto* record = NewUndoRecord(UndoRecord::Kind::kDisableIndex)) {
+    record->weight_index = std::move(weight_index_);
+  } else {
+    weight_index_.reset();
+  }
+}
+
+template <typename N, typename E>
+gdwg::Graph<N, E>::Transaction::Transaction(Graph& g)
+  : graph_{g},
+    mark_{g.undo_log_ ? g.undo_log_->size() : 0},
+    generation_{g.undo_generation_},
+    outermost_{g.undo_log_ == nullptr} {
+  if (outermost_)
+    graph_.undo_log_ = &log_;
+}
+
+template <typename N, typename E>
+gdwg::Graph<N, E>::Transaction::~Transaction() noexcept {
+  /* a destructor can't throw, so if undoing a change does (putting something
+   * back can allocate), the rest of the log is left undone. The log goes with
+   * this, so the graph mustn't keep pointing at it */
+  try {
+    Rollback();
+  } catch (...) {
+    if (outermost_ && open_) {
+      graph_.undo_log_ = nullptr;
+      ++graph_.undo_generation_;
     }
   }
-  return *this;
 }
 
 template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator& gdwg::Graph<N, E>::const_iterator::operator--() {
-  /* if we were off the end, then restore to valid state */
-  if (node_it_ == node_end_it_) {
-    --node_it_;
-    /* skip empty edge sets and return equivalent of end if we
-     * make it to node reverse end */
-    while ((*node_it_)->outgoing_.begin() == (*node_it_)->outgoing_.end()) {
-      /* no more nodes (outers), so we return equivalent of end() */
-      if (node_it_ == node_rend_it_) {
-        edge_it_ = typename std::set<std::weak_ptr<Edge>>::iterator{};
-        return *this;
-      }
-      --node_it_;
+void gdwg::Graph<N, E>::Transaction::Commit() {
+  if (!open_)
+    return;
+  open_ = false;
+  /* an outer transaction has already ended, and taken this one's changes with it */
+  if (generation_ != graph_.undo_generation_)
+    return;
+  /* an inner transaction's changes stay in the log, for the outer one */
+  if (outermost_) {
+    graph_.undo_log_ = nullptr;
+    ++graph_.undo_generation_;
+    log_.clear();
+  }
+}
+
+template <typename N, typename E>
+void gdwg::Graph<N, E>::Transaction::Rollback() {
+  if (!open_ || generation_ != graph_.undo_generation_) {
+    open_ = false;
+    return;
+  }
+  graph_.Undo(mark_);
+  open_ = false;
+  if (outermost_) {
+    graph_.undo_log_ = nullptr;
+    ++graph_.undo_generation_;
+  }
+}
+
+template <typename N, typename E>
+std::vector<std::tuple<N, N, E>> gdwg::Graph<N, E>::EdgesWithWeightIn(const E& lo,
+                                                                      const E& hi) const {
+  std::vector<std::tuple<N, N, E>> found{};
+  if (hi < lo)
+    return found;
+  if (weight_index_) {
+    const auto& by_weight = weight_index_->by_weight;
+    const auto last = by_weight.upper_bound(hi);
+    for (auto it = by_weight.lower_bound(lo); it != last; ++it) {
+      found.emplace_back((*it)->src_->value_, (*it)->dst_->value_, (*it)->value_);
     }
-    edge_it_ = (*node_it_)->outgoing_.end();
-  }
-  /* at this stage it is guaranteed that we either returned
-   * the equivlent of end() OR both the node it and edge it
-   * are valid (but edge it could be pointing to end()) */
-  if (edge_it_ != (*node_it_)->outgoing_.begin()) {
-    --edge_it_;
-    if (!edge_it_->expired())
-      return *this;
-  }
-
-  /* only need to keep decrementing if we have an expired edge or we're
-  at the beginning of an edge set */
-  while (edge_it_->expired() || edge_it_ == (*node_it_)->outgoing_.begin()) {
-    if (edge_it_ == (*node_it_)->outgoing_.begin()) {
-      /* try find the prev node edge set */
-      do {
-        /* if there is no previous nodes, return equivalent of end() */
-        if (node_it_ == node_rend_it_) {
-          edge_it_ = typename std::set<std::weak_ptr<Edge>>::iterator{};
-          return *this;
-        }
-        /* otherwise go to previous node */
-        --node_it_;
-      } while ((*node_it_)->outgoing_.begin() == (*node_it_)->outgoing_.end());
-      /* got a previous node without an empty out edge set, set edge it to its last edge */
-      edge_it_ = --((*node_it_)->outgoing_.end());
-      if (!edge_it_->expired())
-        return *this;
-    } else { /* got an expired edge (not beginning though, so keep searching) */
-      edge_it_ = --((*node_it_)->outgoing_.erase(edge_it_));
+    return found;
+  }
+  for (const auto& edge_sp : edges_) {
+    if (!(edge_sp->value_ < lo) && !(hi < edge_sp->value_))
+      found.emplace_back(edge_sp->src_->value_, edge_sp->dst_->value_, edge_sp->value_);
+  }
+  /* stable, so equal weights stay in (src, dst) order */
+  std::stable_sort(found.begin(), found.end(),
+                   [](const auto& a, const auto& b) { return std::get<2>(a) < std::get<2>(b); });
+  return found;
+}
+
+template <typename N, typename E>
+std::vector<std::tuple<N, N, E>>
+gdwg::Graph<N, E>::EdgesWithWeightIn(const N& src, const E& lo, const E& hi) const {
+  auto src_it = nodes_.find(src);
+  if (src_it == nodes_.end()) {
+    throw std::out_of_range(
+        "Cannot call Graph::EdgesWithWeightIn if src doesn't exist in the graph");
+  }
+  std::vector<std::tuple<N, N, E>> found{};
+  if (hi < lo)
+    return found;
+  if (weight_index_) {
+    const auto& by_source = weight_index_->by_source;
+    using Key = typename SourceWeightOrder::Key;
+    const auto last = by_source.upper_bound(Key{src, hi});
+    for (auto it = by_source.lower_bound(Key{src, lo}); it != last; ++it) {
+      found.emplace_back((*it)->src_->value_, (*it)->dst_->value_, (*it)->value_);
     }
+    return found;
   }
-  return *this;
+  for (const auto& edge_wp : (*src_it)->outgoing_) {
+    const auto edge_sp = edge_wp.lock();
+    if (!(edge_sp->value_ < lo) && !(hi < edge_sp->value_))
+      found.emplace_back(src, edge_sp->dst_->value_, edge_sp->value_);
+  }
+  std::stable_sort(found.begin(), found.end(),
+                   [](const auto& a, const auto& b) { return std::get<2>(a) < std::get<2>(b); });
+  return found;
+}
+
+template <typename N, typename E>
+std::vector<std::tuple<N, N, E>> gdwg::Graph<N, E>::HeaviestEdges(std::size_t k) const {
+  std::vector<std::tuple<N, N, E>> found{};
+  if (weight_index_) {
+    const auto& by_weight = weight_index_->by_weight;
+    for (auto it = by_weight.rbegin(); it != by_weight.rend() && found.size() < k; ++it) {
+      found.emplace_back((*it)->src_->value_, (*it)->dst_->value_, (*it)->value_);
+    }
+    return found;
+  }
+  /* without the index, keep the k heaviest seen so far in a min heap */
+  auto heavier = [](const Edge* a, const Edge* b) { return WeightOrder{}(b, a); };
+  std::vector<const Edge*> heap{};
+  for (const auto& edge_sp : edges_) {
+    if (heap.size() < k) {
+      heap.push_back(edge_sp.get());
+      std::push_heap(heap.begin(), heap.end(), heavier);
+    } else if (k > 0 && WeightOrder{}(heap.front(), edge_sp.get())) {
+      std::pop_heap(heap.begin(), heap.end(), heavier);
+      heap.back() = edge_sp.get();
+      std::push_heap(heap.begin(), heap.end(), heavier);
+    }
+  }
+  std::sort_heap(heap.begin(), heap.end(), heavier);
+  for (const auto* edge : heap) {
+    found.emplace_back(edge->src_->value_, edge->dst_->value_, edge->value_);
+  }
+  return found;
+}
+
+template <typename N, typename E>
+std::vector<std::tuple<N, N, E>> gdwg::Graph<N, E>::HeaviestOutgoingEdges(const N& src,
+                                                                          std::size_t k) const {
+  auto src_it = nodes_.find(src);
+  if (src_it == nodes_.end()) {
+    throw std::out_of_range(
+        "Cannot call Graph::HeaviestOutgoingEdges if src doesn't exist in the graph");
+  }
+  std::vector<std::tuple<N, N, E>> found{};
+  if (weight_index_) {
+    /* src's run of by_source ends just before upper_bound(src), heaviest last */
+    const auto& by_source = weight_index_->by_source;
+    const auto first = by_source.lower_bound(src);
+    for (auto it = by_source.upper_bound(src); it != first && found.size() < k;) {
+      --it;
+      found.emplace_back((*it)->src_->value_, (*it)->dst_->value_, (*it)->value_);
+    }
+    return found;
+  }
+  std::vector<const Edge*> edges{};
+  for (const auto& edge_wp : (*src_it)->outgoing_) {
+    edges.push_back(edge_wp.lock().get());
+  }
+  const auto num_found = std::min(k, edges.size());
+  auto heavier = [](const Edge* a, const Edge* b) { return WeightOrder{}(b, a); };
+  std::partial_sort(edges.begin(), edges.begin() + static_cast<std::ptrdiff_t>(num_found),
+                    edges.end(), heavier);
+  for (std::size_t i = 0; i < num_found; ++i) {
+    found.emplace_back(src, edges[i]->dst_->value_, edges[i]->value_);
+  }
+  return found;
+}
+
+template <typename N, typename E>
+gdwg::MemoryBreakdown gdwg::Graph<N, E>::MemoryUsage(bool count_owned) const {
+  using detail::AllocatorOverhead;
+  using detail::TreeNodeBytes;
+  const auto num_nodes = nodes_.size();
+  const auto num_edges = edges_.size();
+  /* each node is its Node plus an entry in nodes_. Each edge is one make_shared
+   * block (control block then Edge), an entry in edges_ and one in each of two
+   * adjacency sets */
+  const auto node_entry = TreeNodeBytes(sizeof(std::unique_ptr<Node>));
+  const auto edge_entry = TreeNodeBytes(sizeof(std::shared_ptr<Edge>));
+  const auto adjacency_entry = TreeNodeBytes(sizeof(std::weak_ptr<Edge>));
+  const auto edge_block = detail::kControlBlockBytes + sizeof(Edge);
+  MemoryBreakdown usage{};
+  usage.nodes = num_nodes * (sizeof(Node) + node_entry);
+  usage.edges = num_edges * (sizeof(Edge) + edge_entry);
+  usage.adjacency = 2 * num_edges * adjacency_entry;
+  usage.control_blocks = num_edges * detail::kControlBlockBytes;
+  usage.allocator_overhead = AllocatorOverhead(num_nodes, sizeof(Node)) +
+                             AllocatorOverhead(num_nodes, node_entry) +
+                             AllocatorOverhead(num_edges, edge_block) +
+                             AllocatorOverhead(num_edges, edge_entry) +
+                             AllocatorOverhead(2 * num_edges, adjacency_entry);
+  if (weight_index_) {
+    const auto index_entry = TreeNodeBytes(sizeof(const Edge*));
+    usage.weight_index = sizeof(WeightIndex) + 2 * num_edges * index_entry;
+    usage.allocator_overhead +=
+        AllocatorOverhead(1, sizeof(WeightIndex)) + AllocatorOverhead(2 * num_edges, index_entry);
+  }
+  if (count_owned) {
+    for (const auto& node : nodes_) {
+      usage.owned += HeapBytes(node->value_);
+    }
+    for (const auto& edge : edges_) {
+      usage.owned += HeapBytes(edge->value_);
+    }
+  }
+  return usage;
+}
+
+template <typename N, typename E>
+std::vector<std::pair<typename gdwg::Graph<N, E>::const_iterator,
+                      typename gdwg::Graph<N, E>::const_iterator>>
+gdwg::Graph<N, E>::EdgeRanges(std::size_t n) const {
+  std::vector<std::pair<const_iterator, const_iterator>> ranges{};
+  if (edges_.empty() || n == 0)
+    return ranges;
+  /* every range but the last gets at least target edges, so there are never more than n */
+  const auto target = (edges_.size() + n - 1) / n;
+  auto first = cbegin();
+  std::size_t taken = 0;
+  for (const auto& node : nodes_) {
+    /* cut in front of this node once the current range is full. The node's first
+     * outgoing edge is where its edges start in edges_ */
+    if (taken >= target && !node->outgoing_.empty()) {
+      const_iterator cut{edges_.find(node->outgoing_.begin()->lock())};
+      ranges.emplace_back(first, cut);
+      first = cut;
+      taken = 0;
+    }
+    taken += node->outgoing_.size();
+  }
+  ranges.emplace_back(first, cend());
+  return ranges;
+}
+
+template <typename N, typename E>
+template <typename F>
+void gdwg::Graph<N, E>::ParallelForEachEdge(F func, ThreadPool& pool) const {
+  /* a few ranges per thread so one heavy range doesn't leave the rest idle */
+  const auto ranges = EdgeRanges(4 * (pool.Size() + 1));
+  pool.ParallelFor(ranges.size(), [&](std::size_t i) {
+    for (auto it = ranges[i].first; it != ranges[i].second; ++it) {
+      const auto& [src, dst, w] = *it;
+      func(src, dst, w);
+    }
+  });
+}
+
+template <typename N, typename E>
+typename gdwg::Graph<N, E>::const_iterator gdwg::Graph<N, E>::cbegin() const {
+  return const_iterator{edges_.cbegin()};
 }
 
 template <typename N, typename E>
-typename gdwg::Graph<N, E>::const_iterator::reference gdwg::Graph<N, E>::const_iterator::
-operator*() const {
-  /* get the src value from the node iterator */
-  const N& src_val = (*node_it_)->value_;
-  /* now promote the weak pointer the edge iterator is up to to a shared pointer so we can extract
-   * the edge values */
-  auto edge_sp = (*edge_it_).lock();
-  /* dst is the edges destination nodes value */
-  const N& dst_val = edge_sp->dst_->value_;
-  /* src is the edges source nodes value */
-  const E& edge_val = edge_sp->value_;
-  /* return a tuple of this */
-  return {src_val, dst_val, edge_val};
+typename gdwg::Graph<N, E>::const_iterator gdwg::Graph<N, E>::cend() const {
+  return const_iterator{edges_.cend()};
 }
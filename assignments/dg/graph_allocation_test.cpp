@@ -0,0 +1,200 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+/* counts every allocation made through operator new, so this test lives in its
+ * own binary. The array and nothrow forms are all replaced too, so everything
+ * that is allocated here is freed here */
+namespace {
+std::atomic<std::size_t> num_allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+  ++num_allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc{};
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  ++num_allocations;
+  return std::malloc(size == 0 ? 1 : size);
+}
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+  return operator new(size, tag);
+}
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+
+namespace {
+
+/* how many allocations have happened since it was made. Catch's assertions
+ * allocate too, so read it before checking anything */
+class AllocationCounter {
+ public:
+  AllocationCounter() : start_{num_allocations.load()} {}
+  std::size_t Count() const { return num_allocations.load() - start_; }
+
+ private:
+  std::size_t start_;
+};
+
+/* too long for the small string optimisation, so every copy allocates */
+std::string Name(char c) {
+  return std::string(40, c);
+}
+
+using Weight = std::vector<int>;
+using HeavyGraph = gdwg::Graph<std::string, Weight>;
+
+}  // namespace
+
+SCENARIO("inserting nodes allocates the node and its place in the graph, plus any copy") {
+  GIVEN("an empty graph and a node value that allocates") {
+    HeavyGraph g{};
+    auto a = Name('a');
+    WHEN("it is copied in") {
+      AllocationCounter counter{};
+      const auto inserted = g.InsertNode(a);
+      const auto allocations = counter.Count();
+      THEN("the node, its set entry and the copy allocate") {
+        REQUIRE(inserted);
+        REQUIRE(allocations == 3);
+      }
+    }
+    WHEN("it is moved in") {
+      AllocationCounter counter{};
+      const auto inserted = g.InsertNode(std::move(a));
+      const auto allocations = counter.Count();
+      THEN("only the node and its set entry allocate") {
+        REQUIRE(inserted);
+        REQUIRE(allocations == 2);
+        REQUIRE(g.IsNode(Name('a')));
+      }
+    }
+    WHEN("it is built in place") {
+      AllocationCounter counter{};
+      const auto inserted = g.EmplaceNode(40, 'b');
+      const auto allocations = counter.Count();
+      THEN("the value is made once, inside the node") {
+        REQUIRE(inserted);
+        REQUIRE(allocations == 3);
+        REQUIRE(g.IsNode(Name('b')));
+      }
+    }
+    WHEN("moving in a value that is already a node") {
+      g.InsertNode(a);
+      AllocationCounter counter{};
+      const auto inserted = g.InsertNode(std::move(a));
+      const auto allocations = counter.Count();
+      THEN("nothing is allocated, and the value is left alone") {
+        REQUIRE(!inserted);
+        REQUIRE(allocations == 0);
+        REQUIRE(a == Name('a'));
+        REQUIRE(!g.EmplaceNode(40, 'a'));
+      }
+    }
+  }
+}
+
+SCENARIO("inserting edges with a heavy weight") {
+  GIVEN("two nodes") {
+    HeavyGraph g{Name('a'), Name('b')};
+    const auto a = Name('a');
+    const auto b = Name('b');
+    Weight w(100, 1);
+    WHEN("the same weight is copied in and then moved in") {
+      AllocationCounter copy_counter{};
+      const auto copy_inserted = g.InsertEdge(a, b, w);
+      const auto copy_allocations = copy_counter.Count();
+      w.push_back(2);
+      AllocationCounter move_counter{};
+      const auto move_inserted = g.InsertEdge(a, b, std::move(w));
+      const auto move_allocations = move_counter.Count();
+      THEN("moving saves the copy of the weight") {
+        REQUIRE(copy_inserted);
+        REQUIRE(move_inserted);
+        REQUIRE(move_allocations + 1 == copy_allocations);
+        REQUIRE(w.empty());
+        REQUIRE(g.GetWeights(a, b).size() == 2);
+      }
+    }
+    WHEN("moving in an edge that already exists") {
+      g.InsertEdge(Name('a'), Name('b'), w);
+      REQUIRE(!g.InsertEdge(Name('a'), Name('b'), std::move(w)));
+      THEN("the weight is left alone") { REQUIRE(w.size() == 100); }
+    }
+  }
+}
+
+SCENARIO("Replace and ExtractNode don't copy weights") {
+  GIVEN("a hub with heavy edges both ways, a reflexive edge, and an edge elsewhere") {
+    HeavyGraph g{};
+    HeavyGraph expected{};
+    g.InsertNode(Name('x'));
+    expected.InsertNode(Name('z'));
+    for (char c = 'a'; c < 'k'; ++c) {
+      for (auto* graph : {&g, &expected}) {
+        const auto hub = graph == &g ? Name('x') : Name('z');
+        graph->InsertNode(Name(c));
+        graph->InsertEdge(hub, Name(c), Weight(50, c));
+        graph->InsertEdge(Name(c), hub, Weight(50, c));
+      }
+    }
+    for (auto* graph : {&g, &expected}) {
+      const auto hub = graph == &g ? Name('x') : Name('z');
+      graph->InsertEdge(hub, hub, Weight(50, 0));
+      graph->InsertEdge(Name('a'), Name('b'), Weight(50, 0));
+    }
+    const auto old_name = Name('x');
+    const auto new_name = Name('z');
+    WHEN("the hub is renamed") {
+      AllocationCounter counter{};
+      const auto replaced = g.Replace(old_name, new_name);
+      const auto allocations = counter.Count();
+      THEN("only a list of its edges, and the copy of the new value, allocate") {
+        REQUIRE(replaced);
+        REQUIRE(allocations == 2);
+        REQUIRE((g == expected));
+      }
+    }
+    WHEN("the hub is extracted") {
+      AllocationCounter counter{};
+      const auto hub = g.ExtractNode(old_name);
+      const auto allocations = counter.Count();
+      THEN("its value comes out without allocating, and its edges are gone") {
+        REQUIRE(allocations == 0);
+        REQUIRE(hub == old_name);
+        REQUIRE(!g.IsNode(Name('x')));
+        REQUIRE(g.GetConnected(Name('a')) == std::vector<std::string>{Name('b')});
+        REQUIRE(!g.ExtractNode(Name('x')).has_value());
+      }
+    }
+  }
+}
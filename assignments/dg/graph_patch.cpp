@@ -0,0 +1,45 @@
+#include "assignments/dg/graph_patch.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "assignments/dg/varint.h"
+
+std::uint8_t gdwg::PatchReader::Byte() {
+  return *Bytes(1);
+}
+
+std::uint64_t gdwg::PatchReader::Varint() {
+  std::uint64_t v = 0;
+  if (!detail::GetVarint([this] { return Byte(); }, v)) {
+    throw std::invalid_argument("Cannot decode a GraphPatch with a varint longer than 64 bits");
+  }
+  return v;
+}
+
+const std::uint8_t* gdwg::PatchReader::Bytes(std::size_t n) {
+  if (static_cast<std::size_t>(last_ - pos_) < n) {
+    throw std::invalid_argument("Cannot decode a GraphPatch that has been cut short");
+  }
+  const auto* first = pos_;
+  pos_ += n;
+  return first;
+}
+
+void gdwg::EncodeVarint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+  detail::PutVarint(out, v);
+}
+
+void gdwg::EncodeValue(std::vector<std::uint8_t>& out, const std::string& value) {
+  EncodeVarint(out, value.size());
+  out.insert(out.end(), value.begin(), value.end());
+}
+
+void gdwg::DecodeValue(PatchReader& in, std::string& value) {
+  const auto size = in.Varint();
+  const auto* first = in.Bytes(static_cast<std::size_t>(size));
+  value.assign(reinterpret_cast<const char*>(first), static_cast<std::size_t>(size));
+}
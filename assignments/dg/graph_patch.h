@@ -0,0 +1,69 @@
+#ifndef ASSIGNMENTS_DG_GRAPH_PATCH_H_
+#define ASSIGNMENTS_DG_GRAPH_PATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+
+namespace gdwg {
+
+/* the patch that turns from into to, so that from.Apply(Diff(from, to)) == to.
+ * Nodes and edges are both walked once in sorted order, side by side, so this is
+ * linear in the size of the two graphs. Every list in the result is sorted */
+template <typename N, typename E>
+GraphPatch<N, E> Diff(const Graph<N, E>& from, const Graph<N, E>& to);
+
+/* the binary form of a patch: a format byte, then each list as a varint count
+ * followed by its values. Edge lists are grouped by src, so a src is written once
+ * for all of its edges. Values are written with EncodeValue and read back with
+ * DecodeValue (below); for any other N or E, declare both next to the type so
+ * that argument dependent lookup finds them */
+template <typename N, typename E>
+std::vector<std::uint8_t> EncodePatch(const GraphPatch<N, E>& patch);
+/* the reverse of EncodePatch, e.g. DecodePatch<std::string, int>(bytes). Throws
+ * std::invalid_argument if the bytes are cut short or aren't a patch */
+template <typename N, typename E>
+GraphPatch<N, E> DecodePatch(const std::vector<std::uint8_t>& bytes);
+
+/* reads the values of an encoded patch, throwing std::invalid_argument instead of
+ * running off the end */
+class PatchReader {
+ public:
+  /* ctors */
+  PatchReader(const std::uint8_t* first, const std::uint8_t* last) : pos_{first}, last_{last} {}
+
+  /* methods */
+  bool AtEnd() const { return pos_ == last_; }
+  std::uint8_t Byte();
+  std::uint64_t Varint();
+  /* the next n bytes, which stay valid as long as the encoded patch does */
+  const std::uint8_t* Bytes(std::size_t n);
+
+ private:
+  const std::uint8_t* pos_;
+  const std::uint8_t* last_;
+};
+
+/* a varint, as in varint.h */
+void EncodeVarint(std::vector<std::uint8_t>& out, std::uint64_t v);
+
+/* integers are varints (signed ones zigzagged, so small negatives stay short),
+ * floating point values are their bits in little endian order, and strings are
+ * a varint length then the characters */
+template <typename T>
+std::enable_if_t<std::is_arithmetic<T>::value> EncodeValue(std::vector<std::uint8_t>& out,
+                                                           const T& value);
+template <typename T>
+std::enable_if_t<std::is_arithmetic<T>::value> DecodeValue(PatchReader& in, T& value);
+void EncodeValue(std::vector<std::uint8_t>& out, const std::string& value);
+void DecodeValue(PatchReader& in, std::string& value);
+
+}  // namespace gdwg
+
+#include "assignments/dg/graph_patch.tpp"
+
+#endif  // ASSIGNMENTS_DG_GRAPH_PATCH_H_
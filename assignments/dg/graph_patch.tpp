@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+namespace detail {
+
+/* bumped whenever the layout below changes */
+constexpr std::uint8_t kPatchFormat = 1;
+
+/* the unsigned integer type with the same size as a floating point type */
+template <typename T>
+using FloatBits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+template <typename N>
+void EncodeNodes(std::vector<std::uint8_t>& out, const std::vector<N>& nodes) {
+  EncodeVarint(out, nodes.size());
+  for (const auto& val : nodes) {
+    EncodeValue(out, val);
+  }
+}
+
+template <typename N>
+void DecodeNodes(PatchReader& in, std::vector<N>& nodes) {
+  const auto count = in.Varint();
+  for (std::uint64_t i = 0; i < count; ++i) {
+    nodes.emplace_back();
+    DecodeValue(in, nodes.back());
+  }
+}
+
+/* edges are written as runs that share a src: the src, the run length, then the
+ * (dst, w) of each edge in the run */
+template <typename N, typename E>
+void EncodeEdges(std::vector<std::uint8_t>& out, const std::vector<std::tuple<N, N, E>>& edges) {
+  std::size_t num_runs = 0;
+  for (std::size_t i = 0; i < edges.size(); ++i) {
+    num_runs += i == 0 || std::get<0>(edges[i]) != std::get<0>(edges[i - 1]);
+  }
+  EncodeVarint(out, num_runs);
+  for (std::size_t first = 0; first < edges.size();) {
+    auto last = first + 1;
+    while (last < edges.size() && std::get<0>(edges[last]) == std::get<0>(edges[first]))
+      ++last;
+    EncodeValue(out, std::get<0>(edges[first]));
+    EncodeVarint(out, last - first);
+    for (auto i = first; i < last; ++i) {
+      EncodeValue(out, std::get<1>(edges[i]));
+      EncodeValue(out, std::get<2>(edges[i]));
+    }
+    first = last;
+  }
+}
+
+template <typename N, typename E>
+void DecodeEdges(PatchReader& in, std::vector<std::tuple<N, N, E>>& edges) {
+  const auto num_runs = in.Varint();
+  for (std::uint64_t run = 0; run < num_runs; ++run) {
+    N src{};
+    DecodeValue(in, src);
+    const auto count = in.Varint();
+    for (std::uint64_t i = 0; i < count; ++i) {
+      edges.emplace_back(src, N{}, E{});
+      DecodeValue(in, std::get<1>(edges.back()));
+      DecodeValue(in, std::get<2>(edges.back()));
+    }
+  }
+}
+
+}  // namespace detail
+}  // namespace gdwg
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic<T>::value>
+gdwg::EncodeValue(std::vector<std::uint8_t>& out, const T& value) {
+  if constexpr (std::is_same<T, bool>::value) {
+    out.push_back(value ? 1 : 0);
+  } else if constexpr (std::is_floating_point<T>::value) {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "only float and double can be encoded");
+    detail::FloatBits<T> bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (std::size_t i = 0; i < sizeof(bits); ++i) {
+      out.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+    }
+  } else if constexpr (std::is_signed<T>::value) {
+    /* zigzag: 0, -1, 1, -2, ... become 0, 1, 2, 3, ... */
+    const auto v = static_cast<std::int64_t>(value);
+    EncodeVarint(out, (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+  } else {
+    EncodeVarint(out, value);
+  }
+}
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic<T>::value> gdwg::DecodeValue(PatchReader& in, T& value) {
+  if constexpr (std::is_same<T, bool>::value) {
+    value = in.Byte() != 0;
+  } else if constexpr (std::is_floating_point<T>::value) {
+    detail::FloatBits<T> bits{0};
+    const auto* bytes = in.Bytes(sizeof(bits));
+    for (std::size_t i = 0; i < sizeof(bits); ++i) {
+      bits |= static_cast<detail::FloatBits<T>>(bytes[i]) << (8 * i);
+    }
+    std::memcpy(&value, &bits, sizeof(bits));
+  } else {
+    const auto raw = in.Varint();
+    bool fits;
+    if constexpr (std::is_signed<T>::value) {
+      const auto v = static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1);
+      fits = std::numeric_limits<T>::min() <= v && v <= std::numeric_limits<T>::max();
+      value = static_cast<T>(v);
+    } else {
+      fits = raw <= std::numeric_limits<T>::max();
+      value = static_cast<T>(raw);
+    }
+    if (!fits) {
+      throw std::invalid_argument("Cannot decode a GraphPatch value that doesn't fit its type");
+    }
+  }
+}
+
+template <typename N, typename E>
+gdwg::GraphPatch<N, E> gdwg::Diff(const Graph<N, E>& from, const Graph<N, E>& to) {
+  GraphPatch<N, E> patch{};
+  const auto from_nodes = from.GetNodes();
+  const auto to_nodes = to.GetNodes();
+  auto a = from_nodes.cbegin();
+  auto b = to_nodes.cbegin();
+  while (a != from_nodes.cend() || b != to_nodes.cend()) {
+    if (b == to_nodes.cend() || (a != from_nodes.cend() && *a < *b)) {
+      patch.removed_nodes.push_back(*a++);
+    } else if (a == from_nodes.cend() || *b < *a) {
+      patch.added_nodes.push_back(*b++);
+    } else {
+      ++a;
+      ++b;
+    }
+  }
+
+  auto removed = [&patch](const N& val) {
+    return std::binary_search(patch.removed_nodes.cbegin(), patch.removed_nodes.cend(), val);
+  };
+  auto a_edge = from.cbegin();
+  auto b_edge = to.cbegin();
+  while (a_edge != from.cend() || b_edge != to.cend()) {
+    if (b_edge == to.cend() || (a_edge != from.cend() && *a_edge < *b_edge)) {
+      const auto& [src, dst, w] = *a_edge++;
+      if (!removed(src) && !removed(dst))
+        patch.removed_edges.emplace_back(src, dst, w);
+    } else if (a_edge == from.cend() || *b_edge < *a_edge) {
+      patch.added_edges.emplace_back(*b_edge++);
+    } else {
+      ++a_edge;
+      ++b_edge;
+    }
+  }
+  return patch;
+}
+
+template <typename N, typename E>
+std::vector<std::uint8_t> gdwg::EncodePatch(const GraphPatch<N, E>& patch) {
+  std::vector<std::uint8_t> out{detail::kPatchFormat};
+  detail::EncodeNodes(out, patch.removed_nodes);
+  detail::EncodeEdges(out, patch.removed_edges);
+  detail::EncodeNodes(out, patch.added_nodes);
+  detail::EncodeEdges(out, patch.added_edges);
+  return out;
+}
+
+template <typename N, typename E>
+gdwg::GraphPatch<N, E> gdwg::DecodePatch(const std::vector<std::uint8_t>& bytes) {
+  PatchReader in{bytes.data(), bytes.data() + bytes.size()};
+  if (in.Byte() != detail::kPatchFormat) {
+    throw std::invalid_argument("Cannot decode a GraphPatch from an unknown format");
+  }
+  GraphPatch<N, E> patch{};
+  detail::DecodeNodes(in, patch.removed_nodes);
+  detail::DecodeEdges(in, patch.removed_edges);
+  detail::DecodeNodes(in, patch.added_nodes);
+  detail::DecodeEdges(in, patch.added_edges);
+  if (!in.AtEnd()) {
+    throw std::invalid_argument("Cannot decode a GraphPatch with bytes left over");
+  }
+  return patch;
+}
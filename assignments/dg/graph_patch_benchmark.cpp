@@ -0,0 +1,49 @@
+#include <cstddef>
+#include <iostream>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/graph_patch.h"
+
+/* changes 1% of a random graph's edges, then times diffing the two versions,
+ * encoding and decoding the patch, and applying it, next to operator==.
+ * usage: graph_patch_benchmark [num_edges (default 1M)] [num_nodes (default num_edges / 10)] */
+int main(int argc, char** argv) {
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 1, 1000000);
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 2, num_edges / 10 + 1);
+
+  const auto edges = gdwg::benchmark::RandomEdges(num_nodes, num_edges);
+  gdwg::Graph<int, int> from{edges.cbegin(), edges.cend()};
+  gdwg::Graph<int, int> to{from};
+  /* weights are 1..100, so 0 makes every replacement edge new */
+  for (std::size_t i = 0; i < num_edges; i += 100) {
+    const auto& [src, dst, w] = edges[i];
+    to.erase(src, dst, w);
+    to.InsertEdge(dst, src, 0);
+  }
+
+  gdwg::benchmark::Stopwatch equal_timer{};
+  const bool equal = from == to;
+  gdwg::benchmark::Report("operator==", num_edges, equal_timer.Seconds());
+
+  gdwg::benchmark::Stopwatch diff_timer{};
+  const auto patch = gdwg::Diff(from, to);
+  gdwg::benchmark::Report("Diff", num_edges, diff_timer.Seconds());
+
+  gdwg::benchmark::Stopwatch encode_timer{};
+  const auto bytes = gdwg::EncodePatch(patch);
+  gdwg::benchmark::Report("EncodePatch", bytes.size(), encode_timer.Seconds());
+
+  gdwg::benchmark::Stopwatch decode_timer{};
+  const auto decoded = gdwg::DecodePatch<int, int>(bytes);
+  gdwg::benchmark::Report("DecodePatch", bytes.size(), decode_timer.Seconds());
+
+  const auto changes = patch.removed_edges.size() + patch.added_edges.size();
+  gdwg::benchmark::Stopwatch apply_timer{};
+  from.Apply(decoded);
+  gdwg::benchmark::Report("Apply", changes, apply_timer.Seconds());
+
+  std::cout << "edges changed: " << changes << ", patch bytes: " << bytes.size()
+            << ", equal before: " << equal << ", equal after: " << (from == to) << "\n";
+  return from == to ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include "assignments/dg/graph_patch.h"
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+SCENARIO("Diff and Apply") {
+  GIVEN("two versions of a graph") {
+    std::vector<std::tuple<std::string, std::string, double>> old_edges{
+        {"a", "b", 1.5}, {"a", "c", 2}, {"b", "c", -3}, {"c", "d", 4}, {"d", "d", 5}};
+    std::vector<std::tuple<std::string, std::string, double>> new_edges{
+        {"a", "b", 1.5}, {"a", "c", 2.5}, {"b", "c", -3}, {"b", "e", 6}};
+    gdwg::Graph<std::string, double> from{old_edges.begin(), old_edges.end()};
+    gdwg::Graph<std::string, double> to{new_edges.begin(), new_edges.end()};
+    to.InsertNode("f");
+    WHEN("they are diffed") {
+      auto patch = gdwg::Diff(from, to);
+      THEN("only the changes are listed, without the edges of removed nodes") {
+        REQUIRE(patch.removed_nodes == std::vector<std::string>{"d"});
+        REQUIRE(patch.added_nodes == std::vector<std::string>{"e", "f"});
+        REQUIRE(patch.removed_edges ==
+                std::vector<std::tuple<std::string, std::string, double>>{{"a", "c", 2}});
+        REQUIRE(patch.added_edges == std::vector<std::tuple<std::string, std::string, double>>{
+                                         {"a", "c", 2.5}, {"b", "e", 6}});
+      }
+      THEN("applying the patch to the old graph gives the new one") {
+        from.Apply(patch);
+        REQUIRE(from == to);
+        REQUIRE(gdwg::Diff(from, to).added_edges.empty());
+      }
+      THEN("the patch survives being encoded") {
+        auto bytes = gdwg::EncodePatch(patch);
+        auto decoded = gdwg::DecodePatch<std::string, double>(bytes);
+        REQUIRE(decoded.removed_nodes == patch.removed_nodes);
+        REQUIRE(decoded.removed_edges == patch.removed_edges);
+        REQUIRE(decoded.added_nodes == patch.added_nodes);
+        REQUIRE(decoded.added_edges == patch.added_edges);
+        from.Apply(decoded);
+        REQUIRE(from == to);
+      }
+    }
+    WHEN("a patch is applied to a graph it wasn't made for") {
+      auto patch = gdwg::Diff(from, to);
+      gdwg::Graph<std::string, double> other{to};
+      THEN("it throws and leaves the graph alone") {
+        REQUIRE_THROWS_AS(other.Apply(patch), std::runtime_error);
+        REQUIRE(other == to);
+      }
+    }
+  }
+}
+
+SCENARIO("EncodePatch and DecodePatch") {
+  GIVEN("a patch of integers") {
+    gdwg::GraphPatch<int, long long> patch{};
+    patch.removed_nodes = {-5, 0, 1000000};
+    patch.added_edges = {{-1, 2, -9000000000LL}, {-1, 3, 0}, {7, 7, 1}};
+    auto bytes = gdwg::EncodePatch(patch);
+    THEN("small values take a byte or two, and come back the same") {
+      REQUIRE(bytes.size() < 30);
+      auto decoded = gdwg::DecodePatch<int, long long>(bytes);
+      REQUIRE(decoded.removed_nodes == patch.removed_nodes);
+      REQUIRE(decoded.added_edges == patch.added_edges);
+    }
+    THEN("bytes that aren't a whole patch are rejected") {
+      REQUIRE_THROWS_AS((gdwg::DecodePatch<int, long long>({})), std::invalid_argument);
+      bytes.pop_back();
+      REQUIRE_THROWS_AS((gdwg::DecodePatch<int, long long>(bytes)), std::invalid_argument);
+      REQUIRE_THROWS_AS((gdwg::DecodePatch<std::int8_t, long long>(gdwg::EncodePatch(patch))),
+                        std::invalid_argument);
+    }
+  }
+}
+
+SCENARIO("Diff on random graphs") {
+  std::mt19937 rng{33};
+  for (int round = 0; round < 20; ++round) {
+    gdwg::Graph<int, int> from{};
+    gdwg::Graph<int, int> to{};
+    for (auto* g : {&from, &to}) {
+      for (int i = 0; i < 200; ++i) {
+        const int src = static_cast<int>(rng() % 40);
+        const int dst = static_cast<int>(rng() % 40);
+        g->InsertNode(src);
+        g->InsertNode(dst);
+        g->InsertEdge(src, dst, static_cast<int>(rng() % 3));
+      }
+    }
+    auto patch = gdwg::DecodePatch<int, int>(gdwg::EncodePatch(gdwg::Diff(from, to)));
+    from.Apply(patch);
+    REQUIRE(from == to);
+  }
+}
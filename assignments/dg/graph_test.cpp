@@ -59,6 +59,13 @@
 
 #include "assignments/dg/graph.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -407,6 +414,427 @@ SCENARIO("friend operator== (and also != because it is the inverse)") {
   }
 }
 
+SCENARIO("const_iterator") {
+  GIVEN("a graph with some edges, including parallel and reflexive ones") {
+    gdwg::Graph<double, int> di_g{di_tuple.begin(), di_tuple.end()};
+    std::vector<std::tuple<double, double, int>> expected{
+        {1.1, 1.1, 1}, {1.1, 1.1, 2}, {4.2, 2.3, 3}, {4.2, 6.9, 7},
+        {4.3, 2.3, 3}, {6.5, 2.3, 5}, {6.5, 7.0, 5}, {6.9, 1.1, 9}};
+    WHEN("we iterate forwards") {
+      std::vector<std::tuple<double, double, int>> seen{di_g.begin(), di_g.end()};
+      THEN("edges come out ordered by src, then dst, then weight") { REQUIRE(seen == expected); }
+    }
+    WHEN("we iterate backwards") {
+      std::vector<std::tuple<double, double, int>> seen{di_g.rbegin(), di_g.rend()};
+      THEN("we get the exact reverse") {
+        REQUIRE(std::equal(seen.begin(), seen.end(), expected.rbegin(), expected.rend()));
+      }
+    }
+    WHEN("we step forwards and then back again") {
+      auto it = di_g.find(4.2, 6.9, 7);
+      auto copy = it++;
+      REQUIRE(*it == std::make_tuple(4.3, 2.3, 3));
+      REQUIRE(--it == copy);
+      REQUIRE(--di_g.end() == di_g.find(6.9, 1.1, 9));
+    }
+    WHEN("we erase through an iterator") {
+      auto next = di_g.erase(di_g.find(4.2, 2.3, 3));
+      THEN("we get the following edge back and the edge is gone everywhere") {
+        REQUIRE(next == di_g.find(4.2, 6.9, 7));
+        REQUIRE(di_g.find(4.2, 2.3, 3) == di_g.end());
+        REQUIRE(di_g.GetWeights(4.2, 2.3).empty());
+        REQUIRE(di_g.IsConnected(4.2, 2.3) == false);
+      }
+      THEN("the same edge can be inserted again") { REQUIRE(di_g.InsertEdge(4.2, 2.3, 3)); }
+    }
+  }
+  GIVEN("a graph with nodes but no edges") {
+    gdwg::Graph<int, int> g{1, 2, 3};
+    REQUIRE(g.begin() == g.end());
+    REQUIRE(g.rbegin() == g.rend());
+  }
+}
+
+SCENARIO("EdgeRanges and ParallelForEachEdge") {
+  GIVEN("a graph where one node has most of the edges") {
+    gdwg::Graph<int, int> g{};
+    for (int i = 0; i < 50; ++i) {
+      g.InsertNode(i);
+    }
+    for (int i = 0; i < 50; ++i) {
+      g.InsertEdge(7, i, i);
+      g.InsertEdge(i, (i + 1) % 50, 1);
+    }
+    WHEN("we split the edges into ranges") {
+      auto ranges = g.EdgeRanges(4);
+      THEN("there are at most that many, and together they cover every edge once, in order") {
+        REQUIRE(!ranges.empty());
+        REQUIRE(ranges.size() <= 4);
+        REQUIRE(ranges.front().first == g.begin());
+        REQUIRE(ranges.back().second == g.end());
+        for (std::size_t i = 1; i < ranges.size(); ++i) {
+          REQUIRE(ranges[i - 1].second == ranges[i].first);
+          /* no src node is split over two ranges */
+          REQUIRE(std::get<0>(*std::prev(ranges[i].first)) != std::get<0>(*ranges[i].first));
+        }
+      }
+    }
+    WHEN("we sum the weights in parallel") {
+      gdwg::ThreadPool pool{4};
+      std::atomic<int> total{0};
+      std::atomic<int> count{0};
+      g.ParallelForEachEdge(
+          [&](const int&, const int&, const int& w) {
+            total += w;
+            ++count;
+          },
+          pool);
+      THEN("we get the same answer as a plain loop") {
+        int expected = 0;
+        for (const auto& [src, dst, w] : g) {
+          expected += w;
+        }
+        REQUIRE(total == expected);
+        REQUIRE(count == 100);
+      }
+    }
+  }
+  GIVEN("a graph without edges") {
+    gdwg::Graph<int, int> g{1, 2, 3};
+    REQUIRE(g.EdgeRanges(4).empty());
+    int calls = 0;
+    g.ParallelForEachEdge([&](const int&, const int&, const int&) { ++calls; });
+    REQUIRE(calls == 0);
+  }
+}
+
+SCENARIO("FromSortedIds") {
+  GIVEN("sorted nodes and sorted edges between their ids, with a reflexive edge") {
+    std::vector<std::string> nodes{"a", "b", "c", "d"};
+    std::vector<std::tuple<std::uint32_t, std::uint32_t, int>> edges{
+        {0, 1, 1}, {0, 1, 2}, {1, 1, 5}, {2, 0, 3}, {2, 1, 4}};
+    WHEN("we build a graph from them") {
+      auto g = gdwg::Graph<std::string, int>::FromSortedIds(nodes, edges);
+      THEN("it is the same graph as inserting them one at a time") {
+        gdwg::Graph<std::string, int> expected{nodes.cbegin(), nodes.cend()};
+        for (const auto& [src, dst, w] : edges) {
+          expected.InsertEdge(nodes[src], nodes[dst], w);
+        }
+        REQUIRE(g == expected);
+        REQUIRE(g.GetConnected("c") == std::vector<std::string>{"a", "b"});
+        REQUIRE(g.GetWeights("a", "b") == std::vector<int>{1, 2});
+      }
+      THEN("the adjacency sets work for later changes") {
+        REQUIRE(g.Replace("b", "e"));
+        REQUIRE(g.IsConnected("e", "e"));
+        REQUIRE(g.DeleteNode("e"));
+        REQUIRE(g.begin() != g.end());
+        REQUIRE(std::distance(g.begin(), g.end()) == 1);
+      }
+    }
+    THEN("anything out of order, repeated or out of range is rejected") {
+      using G = gdwg::Graph<std::string, int>;
+      REQUIRE_THROWS_AS(G::FromSortedIds({"b", "a"}, {}), std::invalid_argument);
+      REQUIRE_THROWS_AS(G::FromSortedIds({"a", "a"}, {}), std::invalid_argument);
+      REQUIRE_THROWS_AS(G::FromSortedIds(nodes, {{1, 0, 1}, {0, 1, 1}}), std::invalid_argument);
+      REQUIRE_THROWS_AS(G::FromSortedIds(nodes, {{0, 1, 1}, {0, 1, 1}}), std::invalid_argument);
+      REQUIRE_THROWS_AS(G::FromSortedIds(nodes, {{0, 4, 1}}), std::invalid_argument);
+    }
+  }
+}
+
+SCENARIO("weight index") {
+  GIVEN("a graph with repeated weights, a reflexive edge and an isolated node") {
+    using Edge = std::tuple<std::string, std::string, int>;
+    std::vector<Edge> edges{{"a", "b", 5}, {"a", "c", 2}, {"a", "a", 9}, {"b", "c", 5},
+                            {"c", "a", 1}, {"a", "b", 7}, {"c", "b", 5}};
+    gdwg::Graph<std::string, int> g{edges.cbegin(), edges.cend()};
+    g.InsertNode("d");
+    const auto unindexed = g;
+    g.EnableWeightIndex();
+    /* the queries should give the same answers whether or not there is an index */
+    auto both = [&](auto query) {
+      const auto with = query(g);
+      REQUIRE(with == query(unindexed));
+      return with;
+    };
+    THEN("range queries are lightest first, ties in (src, dst) order") {
+      REQUIRE(g.HasWeightIndex());
+      REQUIRE(!unindexed.HasWeightIndex());
+      REQUIRE(both([](const auto& h) { return h.EdgesWithWeightIn(2, 5); }) ==
+              std::vector<Edge>{{"a", "c", 2}, {"a", "b", 5}, {"b", "c", 5}, {"c", "b", 5}});
+      REQUIRE(both([](const auto& h) { return h.EdgesWithWeightIn(6, 100); }) ==
+              std::vector<Edge>{{"a", "b", 7}, {"a", "a", 9}});
+      REQUIRE(both([](const auto& h) { return h.EdgesWithWeightIn(5, 4); }).empty());
+      REQUIRE(both([](const auto& h) { return h.EdgesWithWeightIn("a", 0, 7); }) ==
+              std::vector<Edge>{{"a", "c", 2}, {"a", "b", 5}, {"a", "b", 7}});
+      REQUIRE(both([](const auto& h) { return h.EdgesWithWeightIn("d", 0, 7); }).empty());
+      REQUIRE_THROWS_AS(g.EdgesWithWeightIn("z", 0, 7), std::out_of_range);
+    }
+    THEN("top-k queries are heaviest first") {
+      REQUIRE(both([](const auto& h) { return h.HeaviestEdges(3); }) ==
+              std::vector<Edge>{{"a", "a", 9}, {"a", "b", 7}, {"c", "b", 5}});
+      REQUIRE(both([](const auto& h) { return h.HeaviestEdges(100); }).size() == 7);
+      REQUIRE(both([](const auto& h) { return h.HeaviestEdges(0); }).empty());
+      REQUIRE(both([](const auto& h) { return h.HeaviestOutgoingEdges("c", 5); }) ==
+              std::vector<Edge>{{"c", "b", 5}, {"c", "a", 1}});
+      REQUIRE(both([](const auto& h) { return h.HeaviestOutgoingEdges("a", 2); }) ==
+              std::vector<Edge>{{"a", "a", 9}, {"a", "b", 7}});
+      REQUIRE_THROWS_AS(g.HeaviestOutgoingEdges("z", 1), std::out_of_range);
+    }
+    WHEN("the graph is changed in every way there is") {
+      g.InsertEdge("d", "a", 3);
+      g.erase("a", "b", 5);
+      g.DeleteNode("b");
+      g.Replace("a", "e");
+      g.MergeReplace("c", "e");
+      auto copy = g;
+      THEN("the index keeps up, and is copied along") {
+        REQUIRE(copy.HasWeightIndex());
+        REQUIRE(g.HeaviestEdges(100) ==
+                std::vector<Edge>{{"e", "e", 9}, {"d", "e", 3}, {"e", "e", 2}, {"e", "e", 1}});
+        REQUIRE(copy.EdgesWithWeightIn("e", 2, 9) ==
+                std::vector<Edge>{{"e", "e", 2}, {"e", "e", 9}});
+        g.Clear();
+        REQUIRE(g.HeaviestEdges(1).empty());
+        g.InsertNode("x");
+        g.InsertEdge("x", "x", 4);
+        REQUIRE(g.HeaviestOutgoingEdges("x", 1) == std::vector<Edge>{{"x", "x", 4}});
+      }
+    }
+    WHEN("it is moved, or the index is dropped") {
+      auto moved = std::move(g);
+      THEN("the index goes with the graph, or goes") {
+        REQUIRE(moved.HasWeightIndex());
+        REQUIRE(moved.HeaviestEdges(1) == std::vector<Edge>{{"a", "a", 9}});
+        moved.DisableWeightIndex();
+        REQUIRE(!moved.HasWeightIndex());
+        REQUIRE(moved.HeaviestEdges(1) == std::vector<Edge>{{"a", "a", 9}});
+      }
+    }
+    WHEN("a graph is assigned to") {
+      gdwg::Graph<std::string, int> from_indexed{};
+      from_indexed = g;
+      gdwg::Graph<std::string, int> from_unindexed{};
+      from_unindexed.EnableWeightIndex();
+      from_unindexed = unindexed;
+      THEN("it has an index exactly when the graph assigned from does") {
+        REQUIRE(from_indexed.HasWeightIndex());
+        REQUIRE(from_indexed.HeaviestEdges(100) == g.HeaviestEdges(100));
+        REQUIRE(!from_unindexed.HasWeightIndex());
+        REQUIRE((from_unindexed == unindexed));
+      }
+    }
+  }
+}
+
+namespace {
+
+/* a node value that can be told to throw when copied, or compared. Moving it
+ * never throws */
+struct Fragile {
+  static inline bool throw_on_copy = false;
+  static inline bool throw_on_compare = false;
+  std::string value;
+
+  explicit Fragile(std::string v) : value{std::move(v)} {}
+  Fragile(const Fragile& other) : value{other.value} {
+    if (throw_on_copy)
+      throw std::runtime_error("Fragile copied");
+  }
+  Fragile(Fragile&&) noexcept = default;
+  Fragile& operator=(const Fragile& other) {
+    if (throw_on_copy)
+      throw std::runtime_error("Fragile copied");
+    value = other.value;
+    return *this;
+  }
+  Fragile& operator=(Fragile&&) noexcept = default;
+
+  friend bool operator<(const Fragile& a, const Fragile& b) {
+    if (throw_on_compare)
+      throw std::runtime_error("Fragile compared");
+    return a.value < b.value;
+  }
+  friend bool operator==(const Fragile& a, const Fragile& b) { return a.value == b.value; }
+};
+
+}  // namespace
+
+SCENARIO("transactions") {
+  GIVEN("an indexed graph, and a copy of it from before any edits") {
+    using Edge = std::tuple<std::string, std::string, int>;
+    std::vector<Edge> edges{{"a", "b", 5}, {"a", "c", 2}, {"a", "a", 9}, {"b", "c", 5},
+                            {"c", "a", 1}, {"c", "b", 5}};
+    gdwg::Graph<std::string, int> g{edges.cbegin(), edges.cend()};
+    g.InsertNode("d");
+    g.EnableWeightIndex();
+    const auto before = g;
+    /* every kind of change there is, through every public way of making one */
+    auto edit = [](gdwg::Graph<std::string, int>& h) {
+      h.InsertNode("e");
+      h.EmplaceNode(1, 'f');
+      h.InsertEdge("e", "a", 4);
+      h.erase("a", "b", 5);
+      h.DeleteNode("b");
+      REQUIRE(h.ExtractNode("d") == std::optional<std::string>{"d"});
+      h.Replace("a", "g");
+      h.MergeReplace("c", "g");
+      h.DisableWeightIndex();
+      h.InsertEdge("f", "f", 8);
+      h.EnableWeightIndex();
+      h.DeleteNodes({"e", "x"});
+    };
+    WHEN("the edits are rolled back") {
+      {
+        gdwg::Graph<std::string, int>::Transaction transaction{g};
+        edit(g);
+        REQUIRE((g != before));
+        transaction.Rollback();
+      }
+      THEN("the graph is as it was, index and all") {
+        REQUIRE((g == before));
+        REQUIRE(g.HasWeightIndex());
+        REQUIRE(g.HeaviestEdges(100) == before.HeaviestEdges(100));
+        REQUIRE(g.EdgesWithWeightIn("a", 0, 10) == before.EdgesWithWeightIn("a", 0, 10));
+        REQUIRE(g.GetConnected("c") == std::vector<std::string>{"a", "b"});
+      }
+    }
+    WHEN("the edits are committed") {
+      auto expected = g;
+      edit(expected);
+      {
+        gdwg::Graph<std::string, int>::Transaction transaction{g};
+        edit(g);
+        transaction.Commit();
+      }
+      THEN("they stay") {
+        REQUIRE((g == expected));
+        REQUIRE(g.HeaviestEdges(100) == expected.HeaviestEdges(100));
+      }
+    }
+    WHEN("a step throws and the transaction goes out of scope") {
+      auto throws = [&g] {
+        gdwg::Graph<std::string, int>::Transaction transaction{g};
+        g.InsertNode("e");
+        g.InsertEdge("e", "a", 1);
+        g.DeleteNode("a");
+        g.InsertEdge("e", "z", 1);
+        transaction.Commit();
+      };
+      REQUIRE_THROWS_AS(throws(), std::runtime_error);
+      THEN("everything before it is undone") {
+        REQUIRE((g == before));
+        REQUIRE(g.HeaviestEdges(100) == before.HeaviestEdges(100));
+      }
+    }
+    WHEN("a node is merged into itself, which deletes it and then can't rename it") {
+      REQUIRE_THROWS_AS(g.MergeReplace("a", "a"), std::runtime_error);
+      THEN("MergeReplace's own transaction puts it back") { REQUIRE((g == before)); }
+    }
+    WHEN("a transaction is nested in another") {
+      gdwg::Graph<std::string, int>::Transaction outer{g};
+      g.InsertNode("e");
+      {
+        gdwg::Graph<std::string, int>::Transaction inner{g};
+        g.DeleteNode("a");
+      }
+      const auto inner_rolled_back = g;
+      {
+        gdwg::Graph<std::string, int>::Transaction inner{g};
+        g.DeleteNode("b");
+        inner.Commit();
+      }
+      const auto inner_committed = g;
+      outer.Rollback();
+      THEN("the inner one only undoes its own changes, or hands them on") {
+        REQUIRE(inner_rolled_back.IsNode("a"));
+        REQUIRE(inner_rolled_back.IsNode("e"));
+        REQUIRE(!inner_committed.IsNode("b"));
+        REQUIRE((g == before));
+      }
+    }
+    WHEN("the outer transaction ends while an inner one is still open") {
+      using Transaction = gdwg::Graph<std::string, int>::Transaction;
+      std::optional<Transaction> outer{std::in_place, g};
+      std::optional<Transaction> inner{std::in_place, g};
+      g.InsertNode("e");
+      THEN("committing the outer one keeps the change, and the inner one does nothing") {
+        outer->Commit();
+        outer.reset();
+        inner.reset();
+        REQUIRE(g.IsNode("e"));
+        Transaction next{g};
+        g.InsertNode("f");
+        next.Commit();
+        REQUIRE(g.IsNode("f"));
+      }
+      THEN("rolling back the outer one undoes the change, and the inner one does nothing") {
+        outer->Rollback();
+        /* a transaction opened since is a different one, which the stale inner
+         * one mustn't touch */
+        Transaction next{g};
+        g.InsertNode("f");
+        inner->Rollback();
+        REQUIRE(g.IsNode("f"));
+        next.Commit();
+        REQUIRE((g != before));
+        g.DeleteNode("f");
+        REQUIRE((g == before));
+      }
+    }
+  }
+  GIVEN("a graph whose node values can throw when copied") {
+    gdwg::Graph<Fragile, int> g{};
+    g.InsertNode(Fragile{"a"});
+    g.InsertNode(Fragile{"b"});
+    g.InsertEdge(Fragile{"a"}, Fragile{"b"}, 1);
+    g.InsertEdge(Fragile{"a"}, Fragile{"a"}, 2);
+    WHEN("a node is renamed in a transaction that then throws, with copies throwing") {
+      auto throws = [&g] {
+        gdwg::Graph<Fragile, int>::Transaction transaction{g};
+        g.Replace(Fragile{"a"}, Fragile{"c"});
+        Fragile::throw_on_copy = true;
+        throw std::logic_error("abandoned");
+      };
+      REQUIRE_THROWS_AS(throws(), std::logic_error);
+      Fragile::throw_on_copy = false;
+      THEN("the rename is undone without copying anything") {
+        REQUIRE(g.IsNode(Fragile{"a"}));
+        REQUIRE(!g.IsNode(Fragile{"c"}));
+        REQUIRE(g.IsConnected(Fragile{"a"}, Fragile{"b"}));
+        REQUIRE(g.IsConnected(Fragile{"a"}, Fragile{"a"}));
+      }
+    }
+    WHEN("undoing a change throws as a transaction goes out of scope") {
+      {
+        gdwg::Graph<Fragile, int>::Transaction transaction{g};
+        g.InsertNode(Fragile{"c"});
+        Fragile::throw_on_compare = true;
+      }
+      Fragile::throw_on_compare = false;
+      THEN("the destructor swallows it, leaving the change, and the graph is usable") {
+        REQUIRE(g.IsNode(Fragile{"c"}));
+        gdwg::Graph<Fragile, int>::Transaction transaction{g};
+        g.InsertNode(Fragile{"d"});
+        transaction.Rollback();
+        REQUIRE(!g.IsNode(Fragile{"d"}));
+      }
+    }
+    WHEN("a node is renamed outside a transaction, and copying the new value throws") {
+      Fragile::throw_on_copy = true;
+      REQUIRE_THROWS_AS(g.Replace(Fragile{"a"}, Fragile{"c"}), std::runtime_error);
+      Fragile::throw_on_copy = false;
+      THEN("nothing has been changed yet") {
+        REQUIRE(g.IsNode(Fragile{"a"}));
+        REQUIRE(!g.IsNode(Fragile{"c"}));
+        REQUIRE(g.IsConnected(Fragile{"a"}, Fragile{"b"}));
+        REQUIRE(g.IsConnected(Fragile{"a"}, Fragile{"a"}));
+      }
+    }
+  }
+}
+
 /* i have tested the operator<< by observation because i feel that is easier.
  * I did this in my client testing. ctrl-f for "std::cout << clear_me;"
  * and "std::cout << lhs" below. Additionally, the testing of ordering being
@@ -0,0 +1,56 @@
+#ifndef ASSIGNMENTS_DG_INDEXED_HEAP_H_
+#define ASSIGNMENTS_DG_INDEXED_HEAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+/* a binary min-heap of the dense ids 0..n-1 keyed by Key, which also tracks
+ * where each id sits so its key can be lowered in place (decrease-key) instead
+ * of pushing duplicates. Clear() only touches the ids that were pushed, so one
+ * heap can be reused across searches without reallocating */
+template <typename Key>
+class IndexedHeap {
+ public:
+  using id_type = std::uint32_t;
+
+  /* ctors */
+  explicit IndexedHeap(std::size_t n) : pos_(n, kAbsent), keys_(n) {}
+
+  /* methods */
+  bool Empty() const { return heap_.empty(); }
+  std::size_t Size() const { return heap_.size(); }
+  bool Contains(id_type id) const { return pos_[id] != kAbsent; }
+  const Key& KeyOf(id_type id) const { return keys_[id]; }
+  id_type Top() const { return heap_.front(); }
+  /* inserts id, or lowers its key if it is already queued with a bigger one.
+   * Returns false (and does nothing) if it is queued with a key <= key */
+  bool PushOrDecrease(id_type id, const Key& key);
+  /* removes and returns the id with the smallest key */
+  id_type Pop();
+  void Clear();
+
+ private:
+  static constexpr std::size_t kAbsent = std::numeric_limits<std::size_t>::max();
+
+  void SiftUp(std::size_t i);
+  void SiftDown(std::size_t i);
+  void Place(std::size_t i, id_type id) {
+    heap_[i] = id;
+    pos_[id] = i;
+  }
+
+  std::vector<id_type> heap_;
+  std::vector<std::size_t> pos_;
+  std::vector<Key> keys_;
+};
+
+}  // namespace gdwg
+
+#include "assignments/dg/indexed_heap.tpp"
+
+#endif  // ASSIGNMENTS_DG_INDEXED_HEAP_H_
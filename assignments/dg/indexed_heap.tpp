@@ -0,0 +1,68 @@
+#include <cstddef>
+
+template <typename Key>
+bool gdwg::IndexedHeap<Key>::PushOrDecrease(id_type id, const Key& key) {
+  if (Contains(id)) {
+    if (!(key < keys_[id]))
+      return false;
+    keys_[id] = key;
+    SiftUp(pos_[id]);
+    return true;
+  }
+  keys_[id] = key;
+  heap_.push_back(id);
+  pos_[id] = heap_.size() - 1;
+  SiftUp(heap_.size() - 1);
+  return true;
+}
+
+template <typename Key>
+typename gdwg::IndexedHeap<Key>::id_type gdwg::IndexedHeap<Key>::Pop() {
+  const auto top = heap_.front();
+  pos_[top] = kAbsent;
+  const auto last = heap_.back();
+  heap_.pop_back();
+  if (!heap_.empty()) {
+    Place(0, last);
+    SiftDown(0);
+  }
+  return top;
+}
+
+template <typename Key>
+void gdwg::IndexedHeap<Key>::Clear() {
+  for (auto id : heap_) {
+    pos_[id] = kAbsent;
+  }
+  heap_.clear();
+}
+
+template <typename Key>
+void gdwg::IndexedHeap<Key>::SiftUp(std::size_t i) {
+  const auto id = heap_[i];
+  while (i > 0) {
+    const auto parent = (i - 1) / 2;
+    if (!(keys_[id] < keys_[heap_[parent]]))
+      break;
+    Place(i, heap_[parent]);
+    i = parent;
+  }
+  Place(i, id);
+}
+
+template <typename Key>
+void gdwg::IndexedHeap<Key>::SiftDown(std::size_t i) {
+  const auto id = heap_[i];
+  while (true) {
+    auto child = 2 * i + 1;
+    if (child >= heap_.size())
+      break;
+    if (child + 1 < heap_.size() && keys_[heap_[child + 1]] < keys_[heap_[child]])
+      ++child;
+    if (!(keys_[heap_[child]] < keys_[id]))
+      break;
+    Place(i, heap_[child]);
+    i = child;
+  }
+  Place(i, id);
+}
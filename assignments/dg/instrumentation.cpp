@@ -0,0 +1,126 @@
+#include "assignments/dg/instrumentation.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace {
+
+/* the first ns value that no longer fits in bucket b */
+std::uint64_t BucketEnd(std::size_t b) {
+  return std::uint64_t{1} << (b + 1);
+}
+
+}  // namespace
+
+const char* gdwg::instrumentation::Name(Op op) {
+  static const char* const names[] = {
+      "InsertNode",   "InsertEdge", "DeleteNode", "Replace", "MergeReplace",
+      "Clear",        "IsNode",     "IsConnected", "GetNodes", "GetConnected",
+      "GetWeights",   "find",       "erase",       "Apply",    "copy"};
+  static_assert(sizeof(names) / sizeof(names[0]) == kNumOps, "every Op needs a name");
+  return names[static_cast<std::size_t>(op)];
+}
+
+const char* gdwg::instrumentation::Name(Counter counter) {
+  static const char* const names[] = {"comparisons", "node_allocations", "edge_allocations",
+                                      "adjacency_cleanups", "expired_seen"};
+  static_assert(sizeof(names) / sizeof(names[0]) == kNumCounters, "every Counter needs a name");
+  return names[static_cast<std::size_t>(counter)];
+}
+
+std::uint64_t gdwg::instrumentation::Snapshot::OpStats::Quantile(double q) const {
+  if (calls == 0)
+    return 0;
+  /* the rank of the call we are after, counting from 1 */
+  const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(calls - 1)) + 1;
+  std::uint64_t seen = 0;
+  for (std::size_t b = 0; b < kNumBuckets; ++b) {
+    seen += buckets[b];
+    if (seen >= rank)
+      return BucketEnd(b);
+  }
+  return BucketEnd(kNumBuckets - 1);
+}
+
+std::string gdwg::instrumentation::Snapshot::ToText() const {
+  std::ostringstream os;
+  for (std::size_t c = 0; c < kNumCounters; ++c) {
+    os << Name(static_cast<Counter>(c)) << ": " << counters[c] << "\n";
+  }
+  for (std::size_t i = 0; i < kNumOps; ++i) {
+    const auto& op = ops[i];
+    if (op.calls == 0)
+      continue;
+    os << Name(static_cast<Op>(i)) << ": " << op.calls << " calls, mean "
+       << op.total_ns / op.calls << " ns, p50 <= " << op.Quantile(0.5)
+       << " ns, p99 <= " << op.Quantile(0.99) << " ns\n";
+  }
+  return os.str();
+}
+
+std::string gdwg::instrumentation::Snapshot::ToJson() const {
+  std::ostringstream os;
+  os << "{\"counters\": {";
+  for (std::size_t c = 0; c < kNumCounters; ++c) {
+    os << (c == 0 ? "" : ", ") << "\"" << Name(static_cast<Counter>(c)) << "\": " << counters[c];
+  }
+  os << "}, \"ops\": {";
+  for (std::size_t i = 0; i < kNumOps; ++i) {
+    const auto& op = ops[i];
+    os << (i == 0 ? "" : ", ") << "\"" << Name(static_cast<Op>(i)) << "\": {\"calls\": "
+       << op.calls << ", \"total_ns\": " << op.total_ns << ", \"buckets\": [";
+    for (std::size_t b = 0; b < kNumBuckets; ++b) {
+      os << (b == 0 ? "" : ", ") << op.buckets[b];
+    }
+    os << "]}";
+  }
+  os << "}}";
+  return os.str();
+}
+
+gdwg::instrumentation::Registry& gdwg::instrumentation::Registry::Global() {
+  static Registry registry{};
+  return registry;
+}
+
+void gdwg::instrumentation::Registry::Record(Op op, std::uint64_t ns) {
+  /* bucket = floor(log2(ns)), capped at the last bucket */
+  std::size_t bucket = 0;
+  while (bucket + 1 < kNumBuckets && ns >= BucketEnd(bucket)) {
+    ++bucket;
+  }
+  auto& counters = ops_[static_cast<std::size_t>(op)];
+  counters.calls.fetch_add(1, std::memory_order_relaxed);
+  counters.total_ns.fetch_add(ns, std::memory_order_relaxed);
+  counters.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+gdwg::instrumentation::Snapshot gdwg::instrumentation::Registry::Take() const {
+  Snapshot snapshot{};
+  for (std::size_t i = 0; i < kNumOps; ++i) {
+    snapshot.ops[i].calls = ops_[i].calls.load(std::memory_order_relaxed);
+    snapshot.ops[i].total_ns = ops_[i].total_ns.load(std::memory_order_relaxed);
+    for (std::size_t b = 0; b < kNumBuckets; ++b) {
+      snapshot.ops[i].buckets[b] = ops_[i].buckets[b].load(std::memory_order_relaxed);
+    }
+  }
+  for (std::size_t c = 0; c < kNumCounters; ++c) {
+    snapshot.counters[c] = counters_[c].load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+void gdwg::instrumentation::Registry::Reset() {
+  for (auto& op : ops_) {
+    op.calls.store(0, std::memory_order_relaxed);
+    op.total_ns.store(0, std::memory_order_relaxed);
+    for (auto& bucket : op.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+  for (auto& counter : counters_) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+}
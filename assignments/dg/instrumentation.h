@@ -0,0 +1,149 @@
+#ifndef ASSIGNMENTS_DG_INSTRUMENTATION_H_
+#define ASSIGNMENTS_DG_INSTRUMENTATION_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* opt-in counters and latency histograms for Graph. Everything is compiled out
+ * unless GDWG_INSTRUMENT is defined (depend on :graph_instrumented rather than
+ * :graph to get it), in which case every Graph method records its call and how
+ * long it took, and the internals count comparisons, allocations and adjacency
+ * cleanups. The numbers are process wide and safe to update from any thread.
+ * Every file in a program has to agree on GDWG_INSTRUMENT, since it changes
+ * what Graph's inline functions do */
+namespace gdwg {
+namespace instrumentation {
+
+/* the Graph methods that are timed. A method's time includes any it calls, e.g.
+ * InsertEdge includes its find */
+enum class Op {
+  kInsertNode,
+  kInsertEdge,
+  kDeleteNode,
+  kReplace,
+  kMergeReplace,
+  kClear,
+  kIsNode,
+  kIsConnected,
+  kGetNodes,
+  kGetConnected,
+  kGetWeights,
+  kFind,
+  kErase,
+  kApply,
+  kCopy,
+  kNumOps
+};
+constexpr std::size_t kNumOps = static_cast<std::size_t>(Op::kNumOps);
+
+enum class Counter {
+  /* calls to the comparator of nodes_, edges_ or an adjacency set */
+  kComparisons,
+  /* Node and Edge objects allocated (each edge also adds a tree node to two
+   * adjacency sets) */
+  kNodeAllocations,
+  kEdgeAllocations,
+  /* weak pointers removed from adjacency sets when their edge is erased */
+  kAdjacencyCleanups,
+  /* expired weak pointers the comparator ran into. Edges are always removed from
+   * both adjacency sets as they are erased, so anything but 0 is a bug */
+  kExpiredSeen,
+  kNumCounters
+};
+constexpr std::size_t kNumCounters = static_cast<std::size_t>(Counter::kNumCounters);
+
+/* latency bucket b holds calls that took [2^b, 2^(b + 1)) ns (bucket 0 also
+ * holds 0 ns), and the last bucket everything longer */
+constexpr std::size_t kNumBuckets = 40;
+
+const char* Name(Op op);
+const char* Name(Counter counter);
+
+/* a copy of the numbers at one point in time */
+struct Snapshot {
+  struct OpStats {
+    std::uint64_t calls{0};
+    std::uint64_t total_ns{0};
+    std::array<std::uint64_t, kNumBuckets> buckets{};
+
+    /* an upper bound on the q-th quantile (0 <= q <= 1) of the call latency, in
+     * ns: the top of the bucket it falls in. 0 if there were no calls */
+    std::uint64_t Quantile(double q) const;
+  };
+
+  std::array<OpStats, kNumOps> ops{};
+  std::array<std::uint64_t, kNumCounters> counters{};
+
+  const OpStats& operator[](Op op) const { return ops[static_cast<std::size_t>(op)]; }
+  std::uint64_t operator[](Counter counter) const {
+    return counters[static_cast<std::size_t>(counter)];
+  }
+
+  /* one line per counter and per op that was called, e.g.
+   * "find: 1000 calls, mean 52 ns, p50 <= 64 ns, p99 <= 256 ns" */
+  std::string ToText() const;
+  /* {"counters": {name: value, ...}, "ops": {name: {"calls": .., "total_ns": ..,
+   * "buckets": [..]}, ...}} with every op, called or not */
+  std::string ToJson() const;
+};
+
+/* where the numbers live while the program runs */
+class Registry {
+ public:
+  static Registry& Global();
+
+  void Add(Counter counter, std::uint64_t n = 1) {
+    counters_[static_cast<std::size_t>(counter)].fetch_add(n, std::memory_order_relaxed);
+  }
+  void Record(Op op, std::uint64_t ns);
+
+  Snapshot Take() const;
+  void Reset();
+
+ private:
+  struct OpCounters {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> total_ns{0};
+    std::array<std::atomic<std::uint64_t>, kNumBuckets> buckets{};
+  };
+
+  std::array<OpCounters, kNumOps> ops_{};
+  std::array<std::atomic<std::uint64_t>, kNumCounters> counters_{};
+};
+
+/* records one call to op, and its latency, when it goes out of scope */
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Op op) : op_{op}, start_{std::chrono::steady_clock::now()} {}
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+  ~ScopedTimer() {
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    Registry::Global().Record(
+        op_, static_cast<std::uint64_t>(
+                 std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+  }
+
+ private:
+  Op op_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace instrumentation
+}  // namespace gdwg
+
+#ifdef GDWG_INSTRUMENT
+#define GDWG_COUNT(counter) \
+  ::gdwg::instrumentation::Registry::Global().Add(::gdwg::instrumentation::Counter::counter)
+#define GDWG_TIME_OP(op) \
+  const ::gdwg::instrumentation::ScopedTimer gdwg_op_timer { ::gdwg::instrumentation::Op::op }
+#else
+#define GDWG_COUNT(counter) static_cast<void>(0)
+#define GDWG_TIME_OP(op) static_cast<void>(0)
+#endif
+
+#endif  // ASSIGNMENTS_DG_INSTRUMENTATION_H_
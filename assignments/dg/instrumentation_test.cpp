@@ -0,0 +1,63 @@
+#include "assignments/dg/instrumentation.h"
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+using gdwg::instrumentation::Counter;
+using gdwg::instrumentation::Op;
+using gdwg::instrumentation::Registry;
+
+SCENARIO("Graph operations are counted and timed") {
+  Registry::Global().Reset();
+  GIVEN("a few operations on a graph") {
+    std::vector<std::tuple<int, int, int>> edges{{1, 2, 3}, {1, 3, 4}, {2, 3, 5}};
+    gdwg::Graph<int, int> g{edges.begin(), edges.end()};
+    g.find(1, 2, 3);
+    g.find(9, 9, 9);
+    g.erase(1, 3, 4);
+    g.DeleteNode(2);
+    auto snapshot = Registry::Global().Take();
+    THEN("every call shows up once, with its latency in a bucket") {
+      REQUIRE(snapshot[Op::kInsertNode].calls == 6);
+      REQUIRE(snapshot[Op::kInsertEdge].calls == 3);
+      /* InsertEdge and erase call find too */
+      REQUIRE(snapshot[Op::kFind].calls == 6);
+      REQUIRE(snapshot[Op::kDeleteNode].calls == 1);
+      std::uint64_t bucketed = 0;
+      for (auto n : snapshot[Op::kFind].buckets) {
+        bucketed += n;
+      }
+      REQUIRE(bucketed == 6);
+      REQUIRE(snapshot[Op::kFind].Quantile(0.5) <= snapshot[Op::kFind].Quantile(1.0));
+      REQUIRE(snapshot[Op::kGetNodes].Quantile(0.5) == 0);
+    }
+    THEN("the internals are counted") {
+      REQUIRE(snapshot[Counter::kNodeAllocations] == 3);
+      REQUIRE(snapshot[Counter::kEdgeAllocations] == 3);
+      REQUIRE(snapshot[Counter::kComparisons] > 0);
+      /* erase took one edge out, DeleteNode the other two */
+      REQUIRE(snapshot[Counter::kAdjacencyCleanups] == 6);
+      REQUIRE(snapshot[Counter::kExpiredSeen] == 0);
+    }
+    THEN("it can be dumped") {
+      auto text = snapshot.ToText();
+      REQUIRE(text.find("find: 6 calls") != std::string::npos);
+      REQUIRE(text.find("GetNodes") == std::string::npos);
+      auto json = snapshot.ToJson();
+      REQUIRE(json.find("\"edge_allocations\": 3") != std::string::npos);
+      REQUIRE(json.find("\"GetNodes\": {\"calls\": 0") != std::string::npos);
+    }
+    WHEN("the registry is reset") {
+      Registry::Global().Reset();
+      THEN("everything starts again from 0") {
+        REQUIRE(Registry::Global().Take()[Op::kFind].calls == 0);
+        REQUIRE(Registry::Global().Take()[Counter::kComparisons] == 0);
+      }
+    }
+  }
+}
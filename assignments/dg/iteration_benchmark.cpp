@@ -0,0 +1,38 @@
+#include <cstddef>
+#include <iostream>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+
+/* times a full forward and reverse scan over every edge of a random graph.
+ * usage: iteration_benchmark [num_edges (default 10M)] [num_nodes (default num_edges / 10)] */
+int main(int argc, char** argv) {
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 1, 10000000);
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 2, num_edges / 10 + 1);
+
+  gdwg::benchmark::Stopwatch build_timer{};
+  const auto edges = gdwg::benchmark::RandomEdges(num_nodes, num_edges);
+  gdwg::Graph<int, int> g{edges.cbegin(), edges.cend()};
+  gdwg::benchmark::Report("build", num_edges, build_timer.Seconds());
+
+  /* sum the fields so the compiler can't throw the loop away */
+  long long checksum = 0;
+  std::size_t scanned = 0;
+  gdwg::benchmark::Stopwatch forward_timer{};
+  for (const auto& [src, dst, weight] : g) {
+    checksum += src + dst + weight;
+    ++scanned;
+  }
+  gdwg::benchmark::Report("forward scan", scanned, forward_timer.Seconds());
+
+  scanned = 0;
+  gdwg::benchmark::Stopwatch reverse_timer{};
+  for (auto it = g.crbegin(); it != g.crend(); ++it) {
+    const auto& [src, dst, weight] = *it;
+    checksum -= src + dst + weight;
+    ++scanned;
+  }
+  gdwg::benchmark::Report("reverse scan", scanned, reverse_timer.Seconds());
+
+  std::cout << "checksum: " << checksum << "\n";
+}
@@ -0,0 +1,76 @@
+#ifndef ASSIGNMENTS_DG_K_CORE_H_
+#define ASSIGNMENTS_DG_K_CORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/partition.h"
+
+namespace gdwg {
+
+/* the core numbers of the undirected simple graph underneath a Graph (as in
+ * triangles.h: direction, weights, parallel and reflexive edges are ignored).
+ * The k-core is the largest subgraph in which every node has at least k
+ * neighbours, and a node's core number is the largest k whose k-core holds it */
+template <typename N>
+struct CoreDecomposition {
+  /* the rest are per node, in the graph's node order */
+  std::vector<N> nodes;
+  std::vector<std::uint32_t> core;
+  /* node ids in the order they were peeled off, i.e. by core number, each
+   * having the fewest neighbours left when it was taken */
+  std::vector<std::uint32_t> order;
+  /* the largest core number (0 for a graph without edges) */
+  std::uint32_t degeneracy{0};
+};
+
+/* a summary of one kind of degree over every node */
+struct DegreeSummary {
+  std::size_t min{0};
+  std::size_t max{0};
+  double mean{0.0};
+  /* histogram[d] is how many nodes have degree d, up to max */
+  std::vector<std::size_t> histogram;
+};
+
+/* every node's in and out degree, as Graph::InDegrees/OutDegrees count them,
+ * with a summary of each */
+template <typename N>
+struct DegreeStats {
+  /* the rest are per node, in the graph's node order */
+  std::vector<N> nodes;
+  std::vector<std::size_t> in_degree;
+  std::vector<std::size_t> out_degree;
+  DegreeSummary in;
+  DegreeSummary out;
+};
+
+/* Batagelj and Zaversnik's bucket queue peeling, O(V + E): nodes sit in buckets
+ * by how many neighbours they have left, and the lowest bucket is always emptied
+ * first, each removal moving its neighbours down a bucket in O(1) */
+template <typename N, typename E>
+CoreDecomposition<N> KCoreDecomposition(const CsrSnapshot<N, E>& g);
+template <typename N, typename E>
+CoreDecomposition<N> KCoreDecomposition(const Graph<N, E>& g) {
+  return KCoreDecomposition(CsrSnapshot<N, E>{g});
+}
+
+/* reads the degrees straight off each node's adjacency sets, so it is O(V) no
+ * matter how many edges there are */
+template <typename N, typename E>
+DegreeStats<N> ComputeDegreeStats(const Graph<N, E>& g);
+
+/* deletes every node outside the k-core of g (see KCoreDecomposition), so every
+ * node left has at least k neighbours. The nodes are found on a snapshot and then
+ * deleted with a single Graph::DeleteNodes. Returns how many were deleted */
+template <typename N, typename E>
+std::size_t PruneBelowCore(Graph<N, E>& g, std::uint32_t k);
+
+}  // namespace gdwg
+
+#include "assignments/dg/k_core.tpp"
+
+#endif  // ASSIGNMENTS_DG_K_CORE_H_
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+namespace detail {
+
+inline DegreeSummary Summarise(const std::vector<std::size_t>& degrees) {
+  DegreeSummary summary{};
+  if (degrees.empty())
+    return summary;
+  const auto [min, max] = std::minmax_element(degrees.begin(), degrees.end());
+  summary.min = *min;
+  summary.max = *max;
+  summary.histogram.assign(summary.max + 1, 0);
+  std::size_t total = 0;
+  for (const auto d : degrees) {
+    ++summary.histogram[d];
+    total += d;
+  }
+  summary.mean = static_cast<double>(total) / static_cast<double>(degrees.size());
+  return summary;
+}
+
+}  // namespace detail
+}  // namespace gdwg
+
+template <typename N, typename E>
+gdwg::CoreDecomposition<N> gdwg::KCoreDecomposition(const CsrSnapshot<N, E>& g) {
+  const auto t = g.Transposed();
+  const auto adjacency =
+      detail::MakeUndirected(g.Offsets(), g.Targets(), t.Offsets(), t.Targets());
+  const auto n = static_cast<std::uint32_t>(g.NumNodes());
+  CoreDecomposition<N> result{};
+  result.nodes = g.Nodes();
+  result.core.resize(n);
+  result.order.resize(n);
+
+  /* degree[v] is how many neighbours v has left. vert holds the nodes sorted by
+   * it, bucket[d] is where degree d starts in vert, and pos[v] is v's place */
+  std::vector<std::uint32_t> degree(n);
+  std::uint32_t max_degree = 0;
+  for (std::uint32_t v = 0; v < n; ++v) {
+    degree[v] = static_cast<std::uint32_t>(adjacency.offsets[v + 1] - adjacency.offsets[v]);
+    max_degree = std::max(max_degree, degree[v]);
+  }
+  std::vector<std::uint32_t> bucket(max_degree + 1, 0);
+  for (const auto d : degree) {
+    ++bucket[d];
+  }
+  std::uint32_t start = 0;
+  for (auto& b : bucket) {
+    start += std::exchange(b, start);
+  }
+  std::vector<std::uint32_t> pos(n);
+  auto& vert = result.order;
+  for (std::uint32_t v = 0; v < n; ++v) {
+    pos[v] = bucket[degree[v]]++;
+    vert[pos[v]] = v;
+  }
+  /* bucket[d] went up to where degree d ends, so shift it back down */
+  for (auto d = max_degree; d > 0; --d) {
+    bucket[d] = bucket[d - 1];
+  }
+  if (!bucket.empty())
+    bucket[0] = 0;
+
+  for (std::uint32_t i = 0; i < n; ++i) {
+    const auto v = vert[i];
+    result.core[v] = degree[v];
+    result.degeneracy = std::max(result.degeneracy, degree[v]);
+    for (auto e = adjacency.offsets[v]; e < adjacency.offsets[v + 1]; ++e) {
+      const auto u = adjacency.targets[e];
+      if (degree[u] <= degree[v])
+        continue;
+      /* swap u with the first node of its bucket, then move the bucket's start
+       * past it, which drops u into the bucket below */
+      const auto du = degree[u];
+      const auto first = vert[bucket[du]];
+      std::swap(vert[pos[u]], vert[bucket[du]]);
+      std::swap(pos[u], pos[first]);
+      ++bucket[du];
+      --degree[u];
+    }
+  }
+  return result;
+}
+
+template <typename N, typename E>
+gdwg::DegreeStats<N> gdwg::ComputeDegreeStats(const Graph<N, E>& g) {
+  DegreeStats<N> stats{};
+  stats.nodes = g.GetNodes();
+  stats.in_degree = g.InDegrees();
+  stats.out_degree = g.OutDegrees();
+  stats.in = detail::Summarise(stats.in_degree);
+  stats.out = detail::Summarise(stats.out_degree);
+  return stats;
+}
+
+template <typename N, typename E>
+std::size_t gdwg::PruneBelowCore(Graph<N, E>& g, std::uint32_t k) {
+  auto cores = KCoreDecomposition(g);
+  std::vector<N> deletees{};
+  for (std::size_t v = 0; v < cores.nodes.size(); ++v) {
+    if (cores.core[v] < k)
+      deletees.push_back(std::move(cores.nodes[v]));
+  }
+  return g.DeleteNodes(std::move(deletees));
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/k_core.h"
+
+/* prunes a random graph (every edge stored both ways, so a node's out-degree is
+ * its number of neighbours) down to its k-core, first the way it used to be done,
+ * sweeping the nodes and calling DeleteNode on any with fewer than k neighbours
+ * until a sweep deletes nothing, then with PruneBelowCore. Also times
+ * KCoreDecomposition on a snapshot, and ComputeDegreeStats.
+ * usage: k_core_benchmark [num_nodes (default 50000)] [num_edges (default 200000)]
+ *                         [k (default 5)] */
+int main(int argc, char** argv) {
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 1, 50000);
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 2, 200000);
+  const auto k = static_cast<std::uint32_t>(gdwg::benchmark::Arg(argc, argv, 3, 5));
+
+  std::set<std::pair<int, int>> undirected{};
+  for (const auto& [src, dst, w] : gdwg::benchmark::RandomEdges(num_nodes, num_edges)) {
+    if (src != dst)
+      undirected.emplace(std::min(src, dst), std::max(src, dst));
+  }
+  std::vector<std::tuple<int, int, int>> edges{};
+  for (const auto& [a, b] : undirected) {
+    edges.emplace_back(a, b, 1);
+    edges.emplace_back(b, a, 1);
+  }
+  const gdwg::Graph<int, int> g{edges.cbegin(), edges.cend()};
+  gdwg::benchmark::JsonResults json{};
+  auto report = [&](const std::string& name, std::size_t items, double seconds) {
+    gdwg::benchmark::Report(name, items, seconds);
+    json.Add(name, {{"k", std::to_string(k)}}, items, seconds);
+  };
+
+  auto swept = g;
+  gdwg::benchmark::Stopwatch sweep_timer{};
+  std::size_t sweeps = 0;
+  for (bool changed = true; changed; ++sweeps) {
+    changed = false;
+    for (const auto v : swept.GetNodes()) {
+      if (swept.OutDegree(v) < k) {
+        swept.DeleteNode(v);
+        changed = true;
+      }
+    }
+  }
+  report("DeleteNode sweeps", g.GetNodes().size(), sweep_timer.Seconds());
+  std::cout << "  (" << sweeps << " sweeps)\n";
+
+  auto pruned = g;
+  gdwg::benchmark::Stopwatch prune_timer{};
+  const auto num_deleted = gdwg::PruneBelowCore(pruned, k);
+  report("PruneBelowCore", g.GetNodes().size(), prune_timer.Seconds());
+  std::cout << "  (" << num_deleted << " nodes deleted, " << pruned.GetNodes().size()
+            << " left)\n";
+
+  /* most of PruneBelowCore is taking the snapshot, so time the peeling alone */
+  const gdwg::CsrSnapshot<int, int> csr{g};
+  gdwg::benchmark::Stopwatch core_timer{};
+  const auto cores = gdwg::KCoreDecomposition(csr);
+  report("KCoreDecomposition (snapshot already taken)", edges.size(), core_timer.Seconds());
+  std::cout << "  (degeneracy " << cores.degeneracy << ")\n";
+
+  gdwg::benchmark::Stopwatch stats_timer{};
+  const auto stats = gdwg::ComputeDegreeStats(g);
+  report("ComputeDegreeStats", g.GetNodes().size(), stats_timer.Seconds());
+  std::cout << "  (mean out degree " << stats.out.mean << ")\n";
+
+  if (!(swept == pruned)) {
+    std::cerr << "the two prunings disagree\n";
+    return 1;
+  }
+  json.Write(std::cout);
+}
@@ -0,0 +1,197 @@
+#include "assignments/dg/k_core.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+namespace {
+
+/* core numbers the slow way: for each k, keep deleting nodes with fewer than k
+ * distinct neighbours until none are left, and whatever survives is in the k-core */
+std::vector<std::uint32_t> NaiveCores(const gdwg::Graph<int, int>& g) {
+  std::vector<std::uint32_t> core(g.GetNodes().size(), 0);
+  for (std::uint32_t k = 1;; ++k) {
+    auto h = g;
+    for (bool changed = true; changed;) {
+      changed = false;
+      for (const auto v : h.GetNodes()) {
+        std::set<int> neighbours{};
+        for (const auto& [src, dst, w] : h) {
+          if (src != dst && (src == v || dst == v))
+            neighbours.insert(src == v ? dst : src);
+        }
+        if (neighbours.size() < k) {
+          h.DeleteNode(v);
+          changed = true;
+        }
+      }
+    }
+    if (h.GetNodes().empty())
+      return core;
+    for (const auto v : h.GetNodes()) {
+      core[static_cast<std::size_t>(v)] = k;
+    }
+  }
+}
+
+}  // namespace
+
+SCENARIO("KCoreDecomposition") {
+  GIVEN("a 4-clique with a triangle hanging off it, a tail and a lonely node") {
+    /* a-b-c-d is a clique, d-e-f a triangle, f-g a tail, and h has only a self
+     * loop. Directions, weights and repeats shouldn't matter */
+    std::vector<std::tuple<char, char, int>> edges{
+        {'a', 'b', 1}, {'b', 'a', 1}, {'a', 'c', 1}, {'d', 'a', 1}, {'b', 'c', 1}, {'b', 'c', 2},
+        {'b', 'd', 1}, {'c', 'd', 1}, {'d', 'e', 1}, {'e', 'f', 1}, {'f', 'd', 1}, {'g', 'f', 1},
+        {'h', 'h', 1}};
+    gdwg::Graph<char, int> g{edges.begin(), edges.end()};
+    const auto cores = gdwg::KCoreDecomposition(g);
+    THEN("each node's core number is the densest core it is part of") {
+      REQUIRE(cores.nodes == g.GetNodes());
+      REQUIRE(cores.core == std::vector<std::uint32_t>{3, 3, 3, 3, 2, 2, 1, 0});
+      REQUIRE(cores.degeneracy == 3);
+    }
+    THEN("the peeling order never goes down in core number") {
+      REQUIRE(cores.order.size() == 8);
+      for (std::size_t i = 1; i < cores.order.size(); ++i) {
+        REQUIRE(cores.core[cores.order[i - 1]] <= cores.core[cores.order[i]]);
+      }
+    }
+  }
+  GIVEN("random graphs") {
+    std::mt19937 rng{11};
+    for (int trial = 0; trial < 20; ++trial) {
+      gdwg::Graph<int, int> g{};
+      const auto n = 5 + static_cast<int>(rng() % 20);
+      for (int v = 0; v < n; ++v) {
+        g.InsertNode(v);
+      }
+      const auto m = rng() % 80;
+      for (std::size_t e = 0; e < m; ++e) {
+        const auto src = static_cast<int>(rng() % static_cast<unsigned>(n));
+        const auto dst = static_cast<int>(rng() % static_cast<unsigned>(n));
+        g.InsertEdge(src, dst, static_cast<int>(rng() % 3));
+      }
+      THEN("the bucket queue agrees with peeling the slow way") {
+        const auto cores = gdwg::KCoreDecomposition(g);
+        REQUIRE(cores.core == NaiveCores(g));
+        REQUIRE(cores.degeneracy == *std::max_element(cores.core.begin(), cores.core.end()));
+      }
+    }
+  }
+  GIVEN("a graph with no nodes") {
+    const auto cores = gdwg::KCoreDecomposition(gdwg::Graph<int, int>{});
+    THEN("there is nothing to decompose") {
+      REQUIRE(cores.core.empty());
+      REQUIRE(cores.degeneracy == 0);
+    }
+  }
+}
+
+SCENARIO("PruneBelowCore") {
+  GIVEN("the same clique, triangle and tail") {
+    std::vector<std::tuple<std::string, std::string, int>> edges{
+        {"a", "b", 1}, {"a", "c", 1}, {"a", "d", 1}, {"b", "c", 1}, {"b", "d", 1},
+        {"c", "d", 1}, {"d", "e", 1}, {"e", "f", 1}, {"f", "d", 1}, {"g", "f", 1}};
+    gdwg::Graph<std::string, int> g{edges.begin(), edges.end()};
+    g.InsertNode("h");
+    WHEN("everything below the 2-core is pruned") {
+      const auto num_deleted = gdwg::PruneBelowCore(g, 2);
+      THEN("the tail and the lonely node go, with their edges") {
+        REQUIRE(num_deleted == 2);
+        REQUIRE(g.GetNodes() == std::vector<std::string>{"a", "b", "c", "d", "e", "f"});
+        REQUIRE(g.InDegree("f") == 1);
+      }
+    }
+    WHEN("everything below the 3-core is pruned") {
+      gdwg::PruneBelowCore(g, 3);
+      THEN("only the clique is left") {
+        REQUIRE(g.GetNodes() == std::vector<std::string>{"a", "b", "c", "d"});
+        REQUIRE(std::distance(g.begin(), g.end()) == 6);
+      }
+    }
+    WHEN("everything below a core that doesn't exist is pruned") {
+      REQUIRE(gdwg::PruneBelowCore(g, 4) == 8);
+      THEN("the graph is empty") {
+        REQUIRE(g.GetNodes().empty());
+        REQUIRE(g.begin() == g.end());
+      }
+    }
+    WHEN("nothing is below the 0-core") {
+      REQUIRE(gdwg::PruneBelowCore(g, 0) == 0);
+      THEN("nothing changes") { REQUIRE(g.GetNodes().size() == 8); }
+    }
+  }
+}
+
+SCENARIO("degrees") {
+  GIVEN("a graph with parallel edges and a reflexive edge") {
+    std::vector<std::tuple<char, char, int>> edges{
+        {'a', 'b', 1}, {'a', 'b', 2}, {'a', 'c', 1}, {'c', 'c', 1}, {'b', 'c', 1}};
+    gdwg::Graph<char, int> g{edges.begin(), edges.end()};
+    g.InsertNode('d');
+    THEN("every edge counts, and a reflexive edge counts both ways") {
+      REQUIRE(g.OutDegree('a') == 3);
+      REQUIRE(g.InDegree('b') == 2);
+      REQUIRE(g.InDegree('c') == 3);
+      REQUIRE(g.OutDegree('c') == 1);
+      REQUIRE(g.OutDegrees() == std::vector<std::size_t>{3, 1, 1, 0});
+      REQUIRE(g.InDegrees() == std::vector<std::size_t>{0, 2, 3, 0});
+      REQUIRE_THROWS_AS(g.InDegree('z'), std::out_of_range);
+      REQUIRE_THROWS_AS(g.OutDegree('z'), std::out_of_range);
+    }
+    THEN("the stats summarise them") {
+      const auto stats = gdwg::ComputeDegreeStats(g);
+      REQUIRE(stats.nodes == g.GetNodes());
+      REQUIRE(stats.out_degree == g.OutDegrees());
+      REQUIRE(stats.out.min == 0);
+      REQUIRE(stats.out.max == 3);
+      REQUIRE(stats.out.mean == Approx(5.0 / 4));
+      REQUIRE(stats.out.histogram == std::vector<std::size_t>{1, 2, 0, 1});
+      REQUIRE(stats.in.histogram == std::vector<std::size_t>{2, 0, 1, 1});
+    }
+  }
+  GIVEN("a graph with no nodes") {
+    const auto stats = gdwg::ComputeDegreeStats(gdwg::Graph<int, int>{});
+    THEN("the summaries are empty") {
+      REQUIRE(stats.in.histogram.empty());
+      REQUIRE(stats.out.max == 0);
+    }
+  }
+}
+
+SCENARIO("DeleteNodes") {
+  GIVEN("a ring of 100 nodes") {
+    gdwg::Graph<int, int> g{};
+    for (int v = 0; v < 100; ++v) {
+      g.InsertNode(v);
+    }
+    for (int v = 0; v < 100; ++v) {
+      g.InsertEdge(v, (v + 1) % 100, v);
+    }
+    THEN("a few deletees, some repeated or missing, are looked up one by one") {
+      REQUIRE(g.DeleteNodes({7, 3, 7, 200}) == 2);
+      REQUIRE(g.GetNodes().size() == 98);
+      REQUIRE(g.OutDegree(2) == 0);
+      REQUIRE(g.InDegree(8) == 0);
+    }
+    THEN("many deletees are found in one walk") {
+      std::vector<int> evens{-1};
+      for (int v = 98; v >= 0; v -= 2) {
+        evens.push_back(v);
+      }
+      REQUIRE(g.DeleteNodes(evens) == 50);
+      REQUIRE(g.GetNodes().size() == 50);
+      REQUIRE(g.begin() == g.end());
+    }
+  }
+}
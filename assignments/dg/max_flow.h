@@ -0,0 +1,88 @@
+#ifndef ASSIGNMENTS_DG_MAX_FLOW_H_
+#define ASSIGNMENTS_DG_MAX_FLOW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+
+namespace gdwg {
+
+template <typename N, typename E>
+struct MaxFlowResult {
+  E value{};
+  /* the nodes on the source's side of a minimum cut */
+  std::vector<N> source_side;
+  /* the graph edges crossing that cut. Their weights sum to value */
+  std::vector<std::tuple<N, N, E>> cut_edges;
+};
+
+/* maximum flow / minimum cut, treating every edge's weight as its capacity. Each
+ * edge becomes its own arc, so parallel edges with different weights add up,
+ * and reflexive edges are ignored.
+ * Building one turns the graph into a residual CSR (each arc stored next to its
+ * reverse) once, and Solve can then be called for as many (source, sink) pairs as
+ * needed. Solve runs FIFO push-relabel with periodic global relabelling (a
+ * backwards BFS from the sink that resets every height to its exact distance)
+ * and the gap heuristic (once no node has height h, everything above h can't
+ * reach the sink and is lifted straight out of the way). It only computes the
+ * maximum preflow, which is enough for the flow value and a minimum cut */
+template <typename N, typename E>
+class MaxFlow {
+ public:
+  /* ctors. Throw std::domain_error if any capacity is negative */
+  explicit MaxFlow(const CsrSnapshot<N, E>& g);
+  explicit MaxFlow(const Graph<N, E>& g) : MaxFlow(CsrSnapshot<N, E>{g}) {}
+
+  /* methods */
+  /* throws std::out_of_range if either node doesn't exist, and
+   * std::invalid_argument if they are the same node */
+  MaxFlowResult<N, E> Solve(const N& source, const N& sink);
+  std::size_t NumArcs() const { return head_.size() / 2; }
+
+ private:
+  using node_id = std::uint32_t;
+
+  node_id Id(const N& val) const;
+  /* sets every height to the node's residual distance to the sink (n if it has none) */
+  void GlobalRelabel();
+  void Discharge(node_id u);
+  void Push(node_id u, std::size_t arc);
+  void Relabel(node_id u);
+  void Gap(std::size_t height);
+
+  /* in the snapshot's id order, with by_value_ to look them up (see
+   * detail::ValueOrder) */
+  std::vector<N> nodes_;
+  std::vector<node_id> by_value_;
+  /* node u's arcs are [first_[u], first_[u + 1]). Arc a goes to head_[a], and
+   * rev_[a] is the arc going the other way */
+  std::vector<std::size_t> first_;
+  std::vector<node_id> head_;
+  std::vector<std::size_t> rev_;
+  std::vector<E> capacity_;
+  /* true for arcs that are graph edges (rather than their reverse) */
+  std::vector<bool> forward_;
+
+  /* per Solve state */
+  std::vector<E> residual_;
+  std::vector<E> excess_;
+  std::vector<std::size_t> height_;
+  std::vector<std::size_t> current_;  // next arc to try for each node
+  std::vector<std::size_t> count_;    // number of nodes at each height below n
+  std::deque<node_id> active_;        // FIFO queue of nodes with excess
+  std::vector<bool> queued_;
+  std::size_t work_since_relabel_{0};
+  node_id source_{0};
+  node_id sink_{0};
+};
+
+}  // namespace gdwg
+
+#include "assignments/dg/max_flow.tpp"
+
+#endif  // ASSIGNMENTS_DG_MAX_FLOW_H_
@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+namespace detail {
+
+/* floating point capacities pick up rounding error as flow is pushed back and
+ * forth, so treat anything that small as nothing */
+template <typename E>
+bool Positive(const E& x) {
+  if constexpr (std::is_floating_point<E>::value) {
+    return x > static_cast<E>(1e-12);
+  } else {
+    return x > E{};
+  }
+}
+
+}  // namespace detail
+}  // namespace gdwg
+
+template <typename N, typename E>
+gdwg::MaxFlow<N, E>::MaxFlow(const CsrSnapshot<N, E>& g)
+  : nodes_{g.Nodes()}, by_value_{detail::ValueOrder(nodes_)} {
+  const auto n = static_cast<node_id>(nodes_.size());
+  /* every edge u -> v puts an arc in u's list and its reverse in v's */
+  first_.assign(n + 1, 0);
+  for (node_id u = 0; u < n; ++u) {
+    for (auto e = g.Offsets()[u]; e < g.Offsets()[u + 1]; ++e) {
+      if (g.Weights()[e] < E{}) {
+        throw std::domain_error("Cannot build MaxFlow from a graph with a negative capacity");
+      }
+      if (g.Targets()[e] == u)
+        continue;
+      ++first_[u + 1];
+      ++first_[g.Targets()[e] + 1];
+    }
+  }
+  for (node_id u = 0; u < n; ++u) {
+    first_[u + 1] += first_[u];
+  }
+  const auto num_arcs = first_[n];
+  head_.resize(num_arcs);
+  rev_.resize(num_arcs);
+  capacity_.resize(num_arcs);
+  forward_.resize(num_arcs);
+  std::vector<std::size_t> next{first_.begin(), first_.end() - 1};
+  for (node_id u = 0; u < n; ++u) {
+    for (auto e = g.Offsets()[u]; e < g.Offsets()[u + 1]; ++e) {
+      const auto v = g.Targets()[e];
+      if (v == u)
+        continue;
+      const auto a = next[u]++;
+      const auto b = next[v]++;
+      head_[a] = v;
+      head_[b] = u;
+      rev_[a] = b;
+      rev_[b] = a;
+      capacity_[a] = g.Weights()[e];
+      capacity_[b] = E{};
+      forward_[a] = true;
+      forward_[b] = false;
+    }
+  }
+}
+
+template <typename N, typename E>
+typename gdwg::MaxFlow<N, E>::node_id gdwg::MaxFlow<N, E>::Id(const N& val) const {
+  const auto id = detail::FindNode(nodes_, by_value_, val);
+  if (id == nodes_.size()) {
+    throw std::out_of_range(
+        "Cannot call MaxFlow::Solve if source or sink don't exist in the graph");
+  }
+  return id;
+}
+
+template <typename N, typename E>
+gdwg::MaxFlowResult<N, E> gdwg::MaxFlow<N, E>::Solve(const N& source, const N& sink) {
+  source_ = Id(source);
+  sink_ = Id(sink);
+  if (source_ == sink_) {
+    throw std::invalid_argument("Cannot call MaxFlow::Solve with the same source and sink");
+  }
+  const auto n = nodes_.size();
+  residual_ = capacity_;
+  excess_.assign(n, E{});
+  height_.assign(n, 0);
+  current_.assign(first_.begin(), first_.end() - 1);
+  count_.assign(n, 0);
+  queued_.assign(n, false);
+  active_.clear();
+  work_since_relabel_ = 0;
+
+  /* saturate every arc out of the source to get things going */
+  height_[source_] = n;
+  for (auto a = first_[source_]; a < first_[source_ + 1]; ++a) {
+    if (detail::Positive(residual_[a])) {
+      excess_[source_] = excess_[source_] + residual_[a];
+      Push(source_, a);
+    }
+  }
+  GlobalRelabel();
+
+  /* nodes at height n or above can't reach the sink any more. Returning their
+   * excess to the source would only matter for the flow on each arc, which we
+   * don't report, so they are just dropped */
+  while (!active_.empty()) {
+    const auto u = active_.front();
+    active_.pop_front();
+    queued_[u] = false;
+    if (height_[u] < n)
+      Discharge(u);
+    /* the usual rule of thumb: a global relabel costs O(n + m), so do one after
+     * about that much pushing and relabelling */
+    if (work_since_relabel_ > 6 * n + head_.size()) {
+      GlobalRelabel();
+      work_since_relabel_ = 0;
+    }
+  }
+
+  /* the minimum cut: whatever can't reach the sink in the residual graph is on
+   * the source's side. A final global relabel works that out */
+  GlobalRelabel();
+  MaxFlowResult<N, E> result{};
+  result.value = excess_[sink_];
+  for (node_id u = 0; u < n; ++u) {
+    if (height_[u] < n)
+      continue;
+    result.source_side.push_back(nodes_[u]);
+    for (auto a = first_[u]; a < first_[u + 1]; ++a) {
+      if (forward_[a] && height_[head_[a]] < n)
+        result.cut_edges.emplace_back(nodes_[u], nodes_[head_[a]], capacity_[a]);
+    }
+  }
+  /* ids only follow value order if the snapshot wasn't Permuted */
+  if (!by_value_.empty()) {
+    std::sort(result.source_side.begin(), result.source_side.end());
+    std::sort(result.cut_edges.begin(), result.cut_edges.end());
+  }
+  return result;
+}
+
+template <typename N, typename E>
+void gdwg::MaxFlow<N, E>::GlobalRelabel() {
+  const auto n = nodes_.size();
+  std::fill(height_.begin(), height_.end(), n);
+  std::fill(count_.begin(), count_.end(), 0);
+  height_[sink_] = 0;
+  count_[0] = 1;
+  /* BFS backwards from the sink: u gets a height if it has a residual arc into a node
+   * that already has one. The source always stays at n */
+  std::vector<node_id> queue{sink_};
+  for (std::size_t i = 0; i < queue.size(); ++i) {
+    const auto v = queue[i];
+    for (auto a = first_[v]; a < first_[v + 1]; ++a) {
+      const auto u = head_[a];
+      if (height_[u] == n && u != source_ && detail::Positive(residual_[rev_[a]])) {
+        height_[u] = height_[v] + 1;
+        ++count_[height_[u]];
+        queue.push_back(u);
+      }
+    }
+  }
+  std::copy(first_.begin(), first_.end() - 1, current_.begin());
+}
+
+template <typename N, typename E>
+void gdwg::MaxFlow<N, E>::Discharge(node_id u) {
+  const auto n = nodes_.size();
+  while (detail::Positive(excess_[u]) && height_[u] < n) {
+    if (current_[u] == first_[u + 1]) {
+      Relabel(u);
+      continue;
+    }
+    const auto a = current_[u];
+    if (detail::Positive(residual_[a]) && height_[u] == height_[head_[a]] + 1) {
+      Push(u, a);
+    } else {
+      ++current_[u];
+    }
+  }
+}
+
+template <typename N, typename E>
+void gdwg::MaxFlow<N, E>::Push(node_id u, std::size_t arc) {
+  const auto v = head_[arc];
+  const auto delta = std::min(excess_[u], residual_[arc]);
+  residual_[arc] = residual_[arc] - delta;
+  residual_[rev_[arc]] = residual_[rev_[arc]] + delta;
+  excess_[u] = excess_[u] - delta;
+  excess_[v] = excess_[v] + delta;
+  ++work_since_relabel_;
+  if (v != source_ && v != sink_ && !queued_[v]) {
+    queued_[v] = true;
+    active_.push_back(v);
+  }
+}
+
+template <typename N, typename E>
+void gdwg::MaxFlow<N, E>::Relabel(node_id u) {
+  const auto n = nodes_.size();
+  const auto old_height = height_[u];
+  /* one above the lowest neighbour we can still push to */
+  auto new_height = n;
+  for (auto a = first_[u]; a < first_[u + 1]; ++a) {
+    if (detail::Positive(residual_[a]))
+      new_height = std::min(new_height, height_[head_[a]] + 1);
+  }
+  work_since_relabel_ += first_[u + 1] - first_[u] + 12;
+  height_[u] = std::min(new_height, n);
+  current_[u] = first_[u];
+  --count_[old_height];
+  if (height_[u] < n)
+    ++count_[height_[u]];
+  if (count_[old_height] == 0)
+    Gap(old_height);
+}
+
+template <typename N, typename E>
+void gdwg::MaxFlow<N, E>::Gap(std::size_t height) {
+  const auto n = nodes_.size();
+  /* with nothing at this height, nothing above it has a path to the sink */
+  for (auto& h : height_) {
+    if (h > height && h < n) {
+      --count_[h];
+      h = n;
+    }
+  }
+}
@@ -0,0 +1,69 @@
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/max_flow.h"
+
+namespace {
+
+/* builds the residual CSR for g and solves from src to dst, reporting both times */
+void Run(const std::string& name, const gdwg::Graph<int, int>& g, int src, int dst) {
+  gdwg::benchmark::Stopwatch build_timer{};
+  gdwg::MaxFlow<int, int> flow{g};
+  gdwg::benchmark::Report(name + " residual build", flow.NumArcs(), build_timer.Seconds());
+  gdwg::benchmark::Stopwatch solve_timer{};
+  auto result = flow.Solve(src, dst);
+  gdwg::benchmark::Report(name + " solve", flow.NumArcs(), solve_timer.Seconds());
+  std::cout << name << " flow: " << result.value << " (" << result.cut_edges.size()
+            << " cut edges)\n";
+}
+
+}  // namespace
+
+/* max flow on a 4-connected grid, from a source feeding the whole left column to a
+ * sink draining the whole right column, and on a random graph from a source feeding
+ * its first 1% of nodes to a sink draining the last 1%.
+ * usage: max_flow_benchmark [num_arcs (default 1M)] */
+int main(int argc, char** argv) {
+  const auto num_arcs = gdwg::benchmark::Arg(argc, argv, 1, 1000000);
+  std::mt19937 rng{6771};
+  std::uniform_int_distribution<int> capacity{1, 100};
+  constexpr int kSource = -1;
+  constexpr int kSink = -2;
+
+  /* every cell has an arc to each of its (up to) 4 neighbours */
+  const auto side = static_cast<int>(std::sqrt(static_cast<double>(num_arcs) / 4)) + 1;
+  std::vector<std::tuple<int, int, int>> grid{};
+  for (int r = 0; r < side; ++r) {
+    for (int c = 0; c < side; ++c) {
+      const auto id = r * side + c;
+      if (c + 1 < side) {
+        grid.emplace_back(id, id + 1, capacity(rng));
+        grid.emplace_back(id + 1, id, capacity(rng));
+      }
+      if (r + 1 < side) {
+        grid.emplace_back(id, id + side, capacity(rng));
+        grid.emplace_back(id + side, id, capacity(rng));
+      }
+    }
+  }
+  for (int r = 0; r < side; ++r) {
+    grid.emplace_back(kSource, r * side, 1000);
+    grid.emplace_back(r * side + side - 1, kSink, 1000);
+  }
+  Run("grid", gdwg::Graph<int, int>{grid.cbegin(), grid.cend()}, kSource, kSink);
+
+  const auto num_nodes = static_cast<int>(num_arcs / 8 + 100);
+  auto random = gdwg::benchmark::RandomEdges(static_cast<std::size_t>(num_nodes), num_arcs);
+  for (int i = 0; i < num_nodes / 100; ++i) {
+    random.emplace_back(kSource, i, 1000);
+    random.emplace_back(num_nodes - 1 - i, kSink, 1000);
+  }
+  Run("random", gdwg::Graph<int, int>{random.cbegin(), random.cend()}, kSource, kSink);
+}
@@ -0,0 +1,88 @@
+#include "assignments/dg/max_flow.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+SCENARIO("max flow on a textbook network") {
+  GIVEN("the CLRS example network with an extra parallel edge and a reflexive edge") {
+    std::vector<std::tuple<std::string, std::string, int>> edges{
+        {"s", "v1", 16}, {"s", "v2", 13}, {"v1", "v3", 12}, {"v2", "v1", 4}, {"v2", "v4", 14},
+        {"v3", "v2", 9}, {"v3", "t", 20}, {"v4", "v3", 7}, {"v4", "t", 4},  {"v4", "t", 1},
+        {"t", "t", 100}};
+    gdwg::Graph<std::string, int> g{edges.begin(), edges.end()};
+    gdwg::MaxFlow<std::string, int> flow{g};
+    WHEN("we solve from s to t") {
+      auto result = flow.Solve("s", "t");
+      THEN("parallel edges add their capacities") { REQUIRE(result.value == 24); }
+      THEN("the cut edges add up to the flow") {
+        int cut = 0;
+        for (const auto& [src, dst, w] : result.cut_edges) {
+          cut += w;
+          REQUIRE(std::find(result.source_side.begin(), result.source_side.end(), src) !=
+                  result.source_side.end());
+          REQUIRE(std::find(result.source_side.begin(), result.source_side.end(), dst) ==
+                  result.source_side.end());
+        }
+        REQUIRE(cut == result.value);
+        REQUIRE(result.source_side.front() == "s");
+      }
+    }
+    WHEN("we reuse it for another pair") {
+      REQUIRE(flow.Solve("v2", "v3").value == 4 + 7);
+      REQUIRE(flow.Solve("t", "s").value == 0);
+    }
+    THEN("bad queries throw") {
+      REQUIRE_THROWS_AS(flow.Solve("s", "nope"), std::out_of_range);
+      REQUIRE_THROWS_AS(flow.Solve("s", "s"), std::invalid_argument);
+    }
+    WHEN("it is built from a snapshot in some other node order") {
+      auto permuted = gdwg::CsrSnapshot<std::string, int>{g}.Permuted({5, 4, 3, 2, 1, 0});
+      auto result = gdwg::MaxFlow<std::string, int>{permuted}.Solve("s", "t");
+      THEN("it finds the same cut, in node order") {
+        auto expected = flow.Solve("s", "t");
+        REQUIRE(result.value == expected.value);
+        REQUIRE(result.source_side == expected.source_side);
+        REQUIRE(result.cut_edges == expected.cut_edges);
+      }
+    }
+  }
+  GIVEN("a graph with a negative capacity") {
+    std::vector<std::tuple<int, int, int>> edges{{1, 2, -1}};
+    gdwg::Graph<int, int> g{edges.begin(), edges.end()};
+    REQUIRE_THROWS_AS((gdwg::MaxFlow<int, int>{g}), std::domain_error);
+  }
+}
+
+SCENARIO("max flow with double capacities") {
+  GIVEN("a layered random network") {
+    std::mt19937 rng{3};
+    gdwg::Graph<int, double> g{};
+    for (int i = 0; i < 62; ++i) {
+      g.InsertNode(i);
+    }
+    /* 0 -> layer 1..30 -> layer 31..60 -> 61, each unit of capacity 0.5 */
+    for (int i = 1; i <= 30; ++i) {
+      g.InsertEdge(0, i, 0.5);
+      g.InsertEdge(i + 30, 61, 0.5);
+      g.InsertEdge(i, 31 + static_cast<int>(rng() % 30), 0.5);
+    }
+    THEN("the flow is half the number of distinct middle layer nodes reached") {
+      int reached = 0;
+      for (int i = 31; i <= 60; ++i) {
+        bool has_in = false;
+        for (int j = 1; j <= 30; ++j) {
+          has_in = has_in || g.IsConnected(j, i);
+        }
+        reached += has_in ? 1 : 0;
+      }
+      REQUIRE(gdwg::MaxFlow<int, double>{g}.Solve(0, 61).value == Approx(0.5 * reached));
+    }
+  }
+}
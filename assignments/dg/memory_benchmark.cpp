@@ -0,0 +1,142 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/compressed_graph.h"
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+
+/* adds up the bytes asked for through operator new, so the estimates can be
+ * checked against what was really allocated */
+namespace {
+std::atomic<std::size_t> bytes_allocated{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+  bytes_allocated += size;
+  if (void* p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc{};
+}
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+namespace {
+
+/* what building something allocated, and how long it took */
+struct Measured {
+  std::size_t bytes;
+  double seconds;
+};
+
+/* runs make(), measuring it, and hands back what it made */
+template <typename F>
+auto Measure(F make, Measured& measured) {
+  const auto start = bytes_allocated.load();
+  gdwg::benchmark::Stopwatch timer{};
+  auto made = make();
+  measured = {bytes_allocated.load() - start, timer.Seconds()};
+  return made;
+}
+
+std::string BytesPerEdge(std::size_t bytes, std::size_t num_edges) {
+  return std::to_string(static_cast<double>(bytes) / static_cast<double>(num_edges));
+}
+
+/* prints one configuration's estimate, broken down, against what copying it
+ * really allocated */
+void Print(const std::string& name,
+           const gdwg::MemoryBreakdown& usage,
+           const Measured& measured,
+           std::size_t num_edges,
+           gdwg::benchmark::JsonResults& json) {
+  const auto per_edge = [num_edges](std::size_t bytes) {
+    return static_cast<double>(bytes) / static_cast<double>(num_edges);
+  };
+  const auto requested = usage.Total() - usage.allocator_overhead;
+  std::cout << name << ": " << per_edge(usage.Total()) << " bytes/edge (nodes "
+            << per_edge(usage.nodes) << ", edges " << per_edge(usage.edges) << ", adjacency "
+            << per_edge(usage.adjacency) << ", control blocks " << per_edge(usage.control_blocks)
+            << ", weight index " << per_edge(usage.weight_index) << ", owned "
+            << per_edge(usage.owned) << ", malloc " << per_edge(usage.allocator_overhead)
+            << "); allocated " << per_edge(measured.bytes) << " against " << per_edge(requested)
+            << " estimated\n";
+  json.Add("copy",
+           {{"storage", name}, {"bytes_per_edge", BytesPerEdge(usage.Total(), num_edges)}},
+           num_edges, measured.seconds);
+}
+
+}  // namespace
+
+/* bytes per edge of a random graph stored in each way there is: a Graph (with
+ * and without the weight index, and with string node values that own a buffer
+ * each), a CsrSnapshot and a CompressedGraph. For Graphs the MemoryUsage
+ * estimate is printed beside the bytes its copy ctor really allocates. Each
+ * JSON result times the copy (or build) and has the bytes per edge as a param.
+ * usage: memory_benchmark [num_nodes (default 20000)] [num_edges (default 200000)] */
+int main(int argc, char** argv) {
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 1, 20000);
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 2, 200000);
+  const auto edges = gdwg::benchmark::RandomEdges(num_nodes, num_edges);
+  gdwg::benchmark::JsonResults json{};
+
+  gdwg::Graph<int, int> g{edges.cbegin(), edges.cend()};
+  /* RandomEdges can repeat an edge */
+  const auto n = static_cast<std::size_t>(std::distance(g.begin(), g.end()));
+  Measured measured{};
+  const auto copy = Measure([&g] { return g; }, measured);
+  Print("Graph<int, int>", copy.MemoryUsage(), measured, n, json);
+
+  g.EnableWeightIndex();
+  const auto indexed = Measure([&g] { return g; }, measured);
+  Print("Graph<int, int> + weight index", indexed.MemoryUsage(), measured, n, json);
+  g.DisableWeightIndex();
+
+  std::vector<std::tuple<std::string, std::string, int>> named{};
+  named.reserve(edges.size());
+  auto name = [](int v) { return "node number " + std::to_string(v) + " of the graph"; };
+  for (const auto& [src, dst, w] : edges) {
+    named.emplace_back(name(src), name(dst), w);
+  }
+  gdwg::Graph<std::string, int> strings{named.cbegin(), named.cend()};
+  const auto strings_copy = Measure([&strings] { return strings; }, measured);
+  Print("Graph<std::string, int>", strings_copy.MemoryUsage(true), measured, n, json);
+
+  const auto csr = Measure([&g] { return gdwg::CsrSnapshot<int, int>{g}; }, measured);
+  std::cout << "CsrSnapshot<int, int>: allocated " << BytesPerEdge(measured.bytes, n)
+            << " bytes/edge\n";
+  json.Add("build",
+           {{"storage", "CsrSnapshot"}, {"bytes_per_edge", BytesPerEdge(measured.bytes, n)}}, n,
+           measured.seconds);
+
+  const auto compressed = Measure([&g] { return gdwg::CompressedGraph<int, int>{g}; }, measured);
+  std::cout << "CompressedGraph<int, int>: " << compressed.BytesPerEdge()
+            << " bytes/edge of adjacency\n";
+  json.Add("build",
+           {{"storage", "CompressedGraph"},
+            {"bytes_per_edge", BytesPerEdge(compressed.AdjacencyBytes(), n)}},
+           n, measured.seconds);
+
+  gdwg::benchmark::Stopwatch timer{};
+  std::size_t total = 0;
+  for (int i = 0; i < 1000; ++i) {
+    total += g.MemoryUsage().Total();
+  }
+  gdwg::benchmark::Report("MemoryUsage", 1000, timer.Seconds());
+  gdwg::benchmark::Stopwatch owned_timer{};
+  total += strings.MemoryUsage(true).owned;
+  gdwg::benchmark::Report("MemoryUsage(true)", 1, owned_timer.Seconds());
+  std::cout << "  (check " << total << ", " << csr.NumEdges() << ")\n";
+  json.Write(std::cout);
+}
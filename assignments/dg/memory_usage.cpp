@@ -0,0 +1,9 @@
+#include "assignments/dg/memory_usage.h"
+
+#include <cstddef>
+#include <string>
+
+std::size_t gdwg::HeapBytes(const std::string& s) {
+  /* a default constructed string's capacity is what fits inside it */
+  return s.capacity() > std::string{}.capacity() ? s.capacity() + 1 : 0;
+}
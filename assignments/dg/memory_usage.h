@@ -0,0 +1,84 @@
+#ifndef ASSIGNMENTS_DG_MEMORY_USAGE_H_
+#define ASSIGNMENTS_DG_MEMORY_USAGE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/* estimating how much heap a container uses, for Graph::MemoryUsage. Nothing
+ * here walks the allocator, so the numbers come from the sizes of the objects
+ * involved and a model of how std::set, std::make_shared and malloc lay things
+ * out (the libstdc++/libc++ and glibc ones). They are estimates, but close ones
+ * for the usual 64-bit targets */
+namespace gdwg {
+
+/* a container's heap, by what it is for. Every field is in bytes, and is what
+ * the container asked the allocator for, apart from allocator_overhead */
+struct MemoryBreakdown {
+  /* node objects and their entries in the set of nodes */
+  std::size_t nodes{0};
+  /* edge objects and their entries in the set of edges */
+  std::size_t edges{0};
+  /* entries in the nodes' incoming and outgoing sets */
+  std::size_t adjacency{0};
+  /* shared_ptr control blocks (one per edge) */
+  std::size_t control_blocks{0};
+  /* the optional weight index's entries */
+  std::size_t weight_index{0};
+  /* heap owned by the node and edge values themselves (e.g. a long string's
+   * buffer), if it was asked for */
+  std::size_t owned{0};
+  /* what malloc adds to each allocation: its header, and rounding up */
+  std::size_t allocator_overhead{0};
+
+  std::size_t Total() const {
+    return nodes + edges + adjacency + control_blocks + weight_index + owned + allocator_overhead;
+  }
+};
+
+/* the heap a value owns, beyond its own sizeof. This is a customization point:
+ * for a type that owns memory, overload HeapBytes(const T&) in T's namespace,
+ * where argument dependent lookup will find it. Anything without an overload
+ * counts as owning nothing */
+template <typename T>
+std::size_t HeapBytes(const T&) {
+  return 0;
+}
+/* a string's buffer, unless it fits in the string itself */
+std::size_t HeapBytes(const std::string& s);
+/* a vector's buffer, plus whatever its elements own */
+template <typename T, typename A>
+std::size_t HeapBytes(const std::vector<T, A>& v);
+
+namespace detail {
+
+/* an rb-tree node's colour and three links, before the value it holds */
+constexpr std::size_t kTreeNodeHeader = 4 * sizeof(void*);
+/* std::make_shared's control block: a vtable pointer and two counts */
+constexpr std::size_t kControlBlockBytes = sizeof(void*) + 2 * sizeof(int);
+
+/* what a std::set node holding a value of value_size takes */
+constexpr std::size_t TreeNodeBytes(std::size_t value_size) {
+  return kTreeNodeHeader + value_size;
+}
+
+/* what malloc uses for a request of size bytes: a size_t header, rounded up to
+ * twice that and to at least four times that (as glibc does) */
+constexpr std::size_t AllocationBytes(std::size_t size) {
+  constexpr std::size_t header = sizeof(std::size_t);
+  constexpr std::size_t align = 2 * header;
+  return std::max(4 * header, (size + header + align - 1) / align * align);
+}
+
+/* the overhead of n allocations of size bytes each */
+constexpr std::size_t AllocatorOverhead(std::size_t n, std::size_t size) {
+  return n * (AllocationBytes(size) - size);
+}
+
+}  // namespace detail
+}  // namespace gdwg
+
+#include "assignments/dg/memory_usage.tpp"
+
+#endif  // ASSIGNMENTS_DG_MEMORY_USAGE_H_
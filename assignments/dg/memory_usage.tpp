@@ -0,0 +1,11 @@
+#include <cstddef>
+#include <vector>
+
+template <typename T, typename A>
+std::size_t gdwg::HeapBytes(const std::vector<T, A>& v) {
+  std::size_t bytes = v.capacity() * sizeof(T);
+  for (const auto& x : v) {
+    bytes += HeapBytes(x);
+  }
+  return bytes;
+}
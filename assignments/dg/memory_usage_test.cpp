@@ -0,0 +1,103 @@
+#include "assignments/dg/memory_usage.h"
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+namespace blob {
+
+/* a type that owns memory, with HeapBytes overloaded beside it */
+struct Blob {
+  std::size_t size;
+};
+bool operator<(const Blob& a, const Blob& b) {
+  return a.size < b.size;
+}
+bool operator==(const Blob& a, const Blob& b) {
+  return a.size == b.size;
+}
+std::size_t HeapBytes(const Blob& b) {
+  return b.size;
+}
+
+}  // namespace blob
+
+SCENARIO("HeapBytes") {
+  THEN("plain values own nothing, and strings only own what doesn't fit inside them") {
+    REQUIRE(gdwg::HeapBytes(42) == 0);
+    REQUIRE(gdwg::HeapBytes(std::string{"short"}) == 0);
+    const std::string long_string(100, 'x');
+    REQUIRE(gdwg::HeapBytes(long_string) == long_string.capacity() + 1);
+  }
+  THEN("vectors own their buffer and whatever is in it, found by overload where it's declared") {
+    std::vector<int> ints(10);
+    REQUIRE(gdwg::HeapBytes(ints) == ints.capacity() * sizeof(int));
+    std::vector<blob::Blob> blobs{{3}, {4}};
+    REQUIRE(gdwg::HeapBytes(blobs) == blobs.capacity() * sizeof(blob::Blob) + 7);
+    std::vector<std::string> strings{std::string(50, 'y')};
+    REQUIRE(gdwg::HeapBytes(strings) ==
+            strings.capacity() * sizeof(std::string) + strings[0].capacity() + 1);
+  }
+}
+
+SCENARIO("Graph::MemoryUsage") {
+  GIVEN("an empty graph") {
+    gdwg::Graph<int, int> g{};
+    THEN("it uses nothing") { REQUIRE(g.MemoryUsage().Total() == 0); }
+    WHEN("nodes and edges are added") {
+      g.InsertNode(1);
+      const auto one_node = g.MemoryUsage();
+      g.InsertNode(2);
+      const auto two_nodes = g.MemoryUsage();
+      g.InsertEdge(1, 2, 3);
+      const auto one_edge = g.MemoryUsage();
+      g.InsertEdge(2, 1, 3);
+      const auto two_edges = g.MemoryUsage();
+      THEN("every node costs the same, and so does every edge") {
+        REQUIRE(one_node.nodes > 0);
+        REQUIRE(one_node.edges == 0);
+        REQUIRE(two_nodes.nodes == 2 * one_node.nodes);
+        REQUIRE(two_nodes.allocator_overhead == 2 * one_node.allocator_overhead);
+        REQUIRE(one_edge.nodes == two_nodes.nodes);
+        REQUIRE(one_edge.edges > 0);
+        REQUIRE(one_edge.adjacency > 0);
+        REQUIRE(one_edge.control_blocks > 0);
+        REQUIRE(two_edges.edges == 2 * one_edge.edges);
+        REQUIRE(two_edges.adjacency == 2 * one_edge.adjacency);
+        REQUIRE(two_edges.control_blocks == 2 * one_edge.control_blocks);
+        REQUIRE(two_edges.Total() - one_edge.Total() == one_edge.Total() - two_nodes.Total());
+        REQUIRE(two_edges.weight_index == 0);
+        REQUIRE(two_edges.owned == 0);
+      }
+      THEN("the weight index adds to it, and nothing else") {
+        g.EnableWeightIndex();
+        const auto indexed = g.MemoryUsage();
+        REQUIRE(indexed.weight_index > 0);
+        REQUIRE(indexed.Total() > two_edges.Total());
+        REQUIRE(indexed.edges == two_edges.edges);
+        g.DisableWeightIndex();
+        REQUIRE(g.MemoryUsage().Total() == two_edges.Total());
+      }
+      THEN("clearing gives it all back") {
+        g.Clear();
+        REQUIRE(g.MemoryUsage().Total() == 0);
+      }
+    }
+  }
+  GIVEN("a graph whose values own memory") {
+    const std::string long_name(64, 'a');
+    gdwg::Graph<std::string, blob::Blob> g{long_name, "b"};
+    g.InsertEdge(long_name, "b", blob::Blob{1000});
+    g.InsertEdge("b", "b", blob::Blob{24});
+    THEN("what they own is only counted if asked for") {
+      REQUIRE(g.MemoryUsage().owned == 0);
+      const auto usage = g.MemoryUsage(true);
+      REQUIRE(usage.owned == gdwg::HeapBytes(long_name) + 1024);
+      REQUIRE(usage.Total() == g.MemoryUsage().Total() + usage.owned);
+    }
+  }
+}
@@ -0,0 +1,56 @@
+#ifndef ASSIGNMENTS_DG_MST_H_
+#define ASSIGNMENTS_DG_MST_H_
+
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+
+/* minimum spanning forests. Edge direction is ignored (an edge joins its two
+ * nodes either way round), reflexive edges are never used, and a graph that
+ * isn't connected gets one tree per component. The forest's edges are reported
+ * as they appear in the graph, (src, dst, w). When several edges tie on weight
+ * the three algorithms may pick different ones, but always with the same total.
+ * E needs operator< and operator+ */
+namespace gdwg {
+
+template <typename N, typename E>
+struct SpanningForest {
+  std::vector<std::tuple<N, N, E>> edges;
+  E total_weight{};
+};
+
+/* sorts every edge by weight (in parallel on pool) and keeps each one that
+ * joins two different trees of a union-find. O(E log E) */
+template <typename N, typename E>
+SpanningForest<N, E> Kruskal(const CsrSnapshot<N, E>& g, ThreadPool& pool = ThreadPool::Default());
+/* grows a tree from each unvisited node, always adding the cheapest edge out of
+ * it, using an indexed heap with decrease-key. O(E log V) */
+template <typename N, typename E>
+SpanningForest<N, E> Prim(const CsrSnapshot<N, E>& g);
+/* every round, each tree picks its cheapest outgoing edge (scanned in parallel
+ * on pool) and all of those are added at once. At most O(log V) rounds of O(E) */
+template <typename N, typename E>
+SpanningForest<N, E> Boruvka(const CsrSnapshot<N, E>& g, ThreadPool& pool = ThreadPool::Default());
+
+/* the same, straight from a Graph (which is snapshotted first) */
+template <typename N, typename E>
+SpanningForest<N, E> Kruskal(const Graph<N, E>& g, ThreadPool& pool = ThreadPool::Default()) {
+  return Kruskal(CsrSnapshot<N, E>{g}, pool);
+}
+template <typename N, typename E>
+SpanningForest<N, E> Prim(const Graph<N, E>& g) {
+  return Prim(CsrSnapshot<N, E>{g});
+}
+template <typename N, typename E>
+SpanningForest<N, E> Boruvka(const Graph<N, E>& g, ThreadPool& pool = ThreadPool::Default()) {
+  return Boruvka(CsrSnapshot<N, E>{g}, pool);
+}
+
+}  // namespace gdwg
+
+#include "assignments/dg/mst.tpp"
+
+#endif  // ASSIGNMENTS_DG_MST_H_
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/indexed_heap.h"
+#include "assignments/dg/parallel_sort.h"
+#include "assignments/dg/union_find.h"
+
+namespace gdwg {
+namespace detail {
+
+/* one (non reflexive) edge of a snapshot, by ids */
+template <typename E>
+struct IdEdge {
+  std::uint32_t src;
+  std::uint32_t dst;
+  E weight;
+};
+
+template <typename N, typename E>
+std::vector<IdEdge<E>> IdEdges(const CsrSnapshot<N, E>& g) {
+  std::vector<IdEdge<E>> edges{};
+  edges.reserve(g.NumEdges());
+  for (std::uint32_t src = 0; src < g.NumNodes(); ++src) {
+    for (auto e = g.Offsets()[src]; e < g.Offsets()[src + 1]; ++e) {
+      if (g.Targets()[e] != src)
+        edges.push_back({src, g.Targets()[e], g.Weights()[e]});
+    }
+  }
+  return edges;
+}
+
+template <typename N, typename E>
+void AddToForest(SpanningForest<N, E>& forest,
+                 const CsrSnapshot<N, E>& g,
+                 std::uint32_t src,
+                 std::uint32_t dst,
+                 const E& w) {
+  forest.edges.emplace_back(g.Value(src), g.Value(dst), w);
+  forest.total_weight = forest.total_weight + w;
+}
+
+}  // namespace detail
+}  // namespace gdwg
+
+template <typename N, typename E>
+gdwg::SpanningForest<N, E> gdwg::Kruskal(const CsrSnapshot<N, E>& g, ThreadPool& pool) {
+  auto edges = detail::IdEdges(g);
+  ParallelSort(
+      edges.begin(), edges.end(),
+      [](const detail::IdEdge<E>& a, const detail::IdEdge<E>& b) { return a.weight < b.weight; },
+      pool);
+
+  SpanningForest<N, E> forest{};
+  UnionFind trees{g.NumNodes()};
+  for (const auto& edge : edges) {
+    /* a forest over V nodes can't have more than V - 1 edges, stop once it's full */
+    if (trees.NumSets() == 1)
+      break;
+    if (trees.Union(edge.src, edge.dst))
+      detail::AddToForest(forest, g, edge.src, edge.dst, edge.weight);
+  }
+  return forest;
+}
+
+template <typename N, typename E>
+gdwg::SpanningForest<N, E> gdwg::Prim(const CsrSnapshot<N, E>& g) {
+  /* direction doesn't matter, so a node's neighbours are its outgoing edges in g
+   * plus its outgoing edges in the transpose */
+  const auto t = g.Transposed();
+  const auto n = static_cast<std::uint32_t>(g.NumNodes());
+
+  /* for every queued node, the cheapest known edge into the tree, as it appears
+   * in the graph */
+  struct Link {
+    std::uint32_t src;
+    std::uint32_t dst;
+  };
+  std::vector<Link> link(n);
+  std::vector<bool> in_tree(n, false);
+  IndexedHeap<E> heap{n};
+
+  SpanningForest<N, E> forest{};
+  for (std::uint32_t root = 0; root < n; ++root) {
+    if (in_tree[root])
+      continue;
+    in_tree[root] = true;
+    auto u = root;
+    while (true) {
+      /* offer every neighbour of u that isn't in the tree yet */
+      for (auto e = g.Offsets()[u]; e < g.Offsets()[u + 1]; ++e) {
+        const auto v = g.Targets()[e];
+        if (!in_tree[v] && heap.PushOrDecrease(v, g.Weights()[e]))
+          link[v] = {u, v};
+      }
+      for (auto e = t.Offsets()[u]; e < t.Offsets()[u + 1]; ++e) {
+        const auto v = t.Targets()[e];
+        if (!in_tree[v] && heap.PushOrDecrease(v, t.Weights()[e]))
+          link[v] = {v, u};
+      }
+      if (heap.Empty())
+        break;
+      const auto w = heap.KeyOf(heap.Top());
+      u = heap.Pop();
+      in_tree[u] = true;
+      detail::AddToForest(forest, g, link[u].src, link[u].dst, w);
+    }
+  }
+  return forest;
+}
+
+template <typename N, typename E>
+gdwg::SpanningForest<N, E> gdwg::Boruvka(const CsrSnapshot<N, E>& g, ThreadPool& pool) {
+  constexpr auto kNone = std::numeric_limits<std::size_t>::max();
+  const auto edges = detail::IdEdges(g);
+  const auto n = g.NumNodes();
+  /* ties are broken by edge index, so every tree agrees on one strict order and
+   * the edges picked in a round can never form a cycle */
+  auto lighter = [&edges](std::size_t a, std::size_t b) {
+    return edges[a].weight < edges[b].weight ||
+           (!(edges[b].weight < edges[a].weight) && a < b);
+  };
+
+  SpanningForest<N, E> forest{};
+  UnionFind trees{n};
+  std::vector<std::uint32_t> tree_of(n);
+  std::vector<std::atomic<std::size_t>> cheapest(n);
+  const auto num_chunks = 4 * (pool.Size() + 1);
+  bool merged = true;
+  while (merged && trees.NumSets() > 1) {
+    /* find() compresses paths, so resolve every node's tree up front and let the
+     * parallel phase only read the result */
+    for (std::uint32_t v = 0; v < n; ++v) {
+      tree_of[v] = trees.Find(v);
+      cheapest[v].store(kNone, std::memory_order_relaxed);
+    }
+    pool.ParallelFor(num_chunks, [&](std::size_t chunk) {
+      const auto first = edges.size() * chunk / num_chunks;
+      const auto last = edges.size() * (chunk + 1) / num_chunks;
+      for (auto i = first; i < last; ++i) {
+        const auto a = tree_of[edges[i].src];
+        const auto b = tree_of[edges[i].dst];
+        if (a == b)
+          continue;
+        for (auto tree : {a, b}) {
+          auto current = cheapest[tree].load(std::memory_order_relaxed);
+          while ((current == kNone || lighter(i, current)) &&
+                 !cheapest[tree].compare_exchange_weak(current, i, std::memory_order_relaxed)) {
+          }
+        }
+      }
+    });
+    /* now join every tree along the edge it picked */
+    merged = false;
+    for (std::uint32_t v = 0; v < n; ++v) {
+      const auto i = cheapest[v].load(std::memory_order_relaxed);
+      if (tree_of[v] != v || i == kNone)
+        continue;
+      if (trees.Union(edges[i].src, edges[i].dst)) {
+        detail::AddToForest(forest, g, edges[i].src, edges[i].dst, edges[i].weight);
+        merged = true;
+      }
+    }
+  }
+  return forest;
+}
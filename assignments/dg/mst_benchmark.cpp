@@ -0,0 +1,40 @@
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/mst.h"
+
+/* times Kruskal, Prim and Boruvka on the same random weighted graph.
+ * usage: mst_benchmark [num_edges (default 10M)] [num_nodes (default num_edges / 10)] */
+int main(int argc, char** argv) {
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 1, 10000000);
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 2, num_edges / 10 + 1);
+
+  std::vector<std::tuple<int, int, double>> edges{};
+  for (const auto& [src, dst, w] : gdwg::benchmark::RandomEdges(num_nodes, num_edges)) {
+    edges.emplace_back(src, dst, w / 7.0);
+  }
+  gdwg::Graph<int, double> g{edges.cbegin(), edges.cend()};
+
+  gdwg::benchmark::Stopwatch snapshot_timer{};
+  gdwg::CsrSnapshot<int, double> csr{g};
+  gdwg::benchmark::Report("snapshot", csr.NumEdges(), snapshot_timer.Seconds());
+
+  gdwg::benchmark::Stopwatch kruskal_timer{};
+  auto kruskal = gdwg::Kruskal(csr);
+  gdwg::benchmark::Report("kruskal", csr.NumEdges(), kruskal_timer.Seconds());
+
+  gdwg::benchmark::Stopwatch prim_timer{};
+  auto prim = gdwg::Prim(csr);
+  gdwg::benchmark::Report("prim", csr.NumEdges(), prim_timer.Seconds());
+
+  gdwg::benchmark::Stopwatch boruvka_timer{};
+  auto boruvka = gdwg::Boruvka(csr);
+  gdwg::benchmark::Report("boruvka", csr.NumEdges(), boruvka_timer.Seconds());
+
+  std::cout << "forest weight: kruskal " << kruskal.total_weight << ", prim " << prim.total_weight
+            << ", boruvka " << boruvka.total_weight << "\n";
+}
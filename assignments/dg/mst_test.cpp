@@ -0,0 +1,86 @@
+#include "assignments/dg/mst.h"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "assignments/dg/parallel_sort.h"
+#include "assignments/dg/thread_pool.h"
+#include "assignments/dg/union_find.h"
+#include "catch.h"
+
+SCENARIO("UnionFind") {
+  gdwg::UnionFind uf{5};
+  REQUIRE(uf.NumSets() == 5);
+  REQUIRE(uf.Union(0, 1));
+  REQUIRE(uf.Union(3, 4));
+  REQUIRE(uf.Union(1, 4));
+  REQUIRE(!uf.Union(0, 3));
+  REQUIRE(uf.Connected(0, 4));
+  REQUIRE(!uf.Connected(2, 4));
+  REQUIRE(uf.NumSets() == 2);
+}
+
+SCENARIO("ParallelSort") {
+  gdwg::ThreadPool pool{3};
+  std::mt19937 rng{1};
+  for (auto size : {0, 1, 100, 50000}) {
+    std::vector<int> values(static_cast<std::size_t>(size));
+    for (auto& value : values) {
+      value = static_cast<int>(rng() % 1000);
+    }
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+    gdwg::ParallelSort(values.begin(), values.end(), std::less<int>{}, pool);
+    REQUIRE(values == expected);
+  }
+}
+
+SCENARIO("minimum spanning forests") {
+  GIVEN("two components, parallel edges and a reflexive edge") {
+    /* a-b-c-d is a square with a diagonal, e-f is on its own */
+    std::vector<std::tuple<char, char, double>> edges{
+        {'a', 'b', 1.0}, {'b', 'a', 0.5}, {'b', 'c', 2.0}, {'c', 'd', 1.5}, {'d', 'a', 4.0},
+        {'a', 'c', 3.0}, {'c', 'c', 0.1}, {'e', 'f', 7.0}, {'f', 'e', 8.0}};
+    gdwg::Graph<char, double> g{edges.begin(), edges.end()};
+    g.InsertNode('z');
+    gdwg::ThreadPool pool{2};
+    const auto expect_forest = [](const gdwg::SpanningForest<char, double>& forest) {
+      REQUIRE(forest.edges.size() == 4);
+      REQUIRE(forest.total_weight == Approx(0.5 + 2.0 + 1.5 + 7.0));
+      /* every edge used is a real edge of the graph */
+      REQUIRE(std::find(forest.edges.begin(), forest.edges.end(),
+                        std::make_tuple('b', 'a', 0.5)) != forest.edges.end());
+      REQUIRE(std::find(forest.edges.begin(), forest.edges.end(),
+                        std::make_tuple('e', 'f', 7.0)) != forest.edges.end());
+    };
+    THEN("Kruskal finds the forest") { expect_forest(gdwg::Kruskal(g, pool)); }
+    THEN("Prim finds the forest") { expect_forest(gdwg::Prim(g)); }
+    THEN("Boruvka finds the forest") { expect_forest(gdwg::Boruvka(g, pool)); }
+  }
+  GIVEN("a bigger random graph with lots of tied weights") {
+    std::mt19937 rng{7};
+    gdwg::Graph<int, double> g{};
+    for (int i = 0; i < 300; ++i) {
+      g.InsertNode(i);
+    }
+    for (int i = 0; i < 1500; ++i) {
+      g.InsertEdge(static_cast<int>(rng() % 300), static_cast<int>(rng() % 300),
+                   static_cast<double>(rng() % 10));
+    }
+    gdwg::ThreadPool pool{3};
+    gdwg::CsrSnapshot<int, double> csr{g};
+    auto kruskal = gdwg::Kruskal(csr, pool);
+    auto prim = gdwg::Prim(csr);
+    auto boruvka = gdwg::Boruvka(csr, pool);
+    THEN("all three agree on the size and the weight of the forest") {
+      REQUIRE(prim.edges.size() == kruskal.edges.size());
+      REQUIRE(boruvka.edges.size() == kruskal.edges.size());
+      REQUIRE(prim.total_weight == Approx(kruskal.total_weight));
+      REQUIRE(boruvka.total_weight == Approx(kruskal.total_weight));
+    }
+  }
+}
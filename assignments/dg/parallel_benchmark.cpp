@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+
+/* times two edge aggregations on 1, 2, 4, ... threads, up to the hardware thread count:
+ *  - a weight sum, with a partial sum per EdgeRanges range so threads share nothing
+ *  - an in-degree histogram via ParallelForEachEdge, counted into per node atomics
+ * usage: parallel_benchmark [num_edges (default 10M)] [num_nodes (default num_edges / 10)] */
+int main(int argc, char** argv) {
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 1, 10000000);
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 2, num_edges / 10 + 1);
+
+  const auto edges = gdwg::benchmark::RandomEdges(num_nodes, num_edges);
+  gdwg::Graph<int, int> g{edges.cbegin(), edges.cend()};
+  /* RandomEdges can repeat an edge and the graph keeps one copy, so count what
+   * the loops below actually visit */
+  const auto num_unique = static_cast<std::size_t>(std::distance(g.begin(), g.end()));
+
+  /* single threaded baseline */
+  long long expected = 0;
+  gdwg::benchmark::Stopwatch baseline_timer{};
+  for (const auto& [src, dst, w] : g) {
+    expected += w;
+  }
+  gdwg::benchmark::Report("weight sum, sequential loop", num_unique, baseline_timer.Seconds());
+
+  const auto max_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 2);
+  for (std::size_t threads = 2; threads <= max_threads; threads *= 2) {
+    /* the calling thread works too, so the pool needs one less worker */
+    gdwg::ThreadPool pool{threads - 1};
+    const auto name = std::to_string(threads) + " threads";
+
+    gdwg::benchmark::Stopwatch sum_timer{};
+    const auto ranges = g.EdgeRanges(4 * threads);
+    std::vector<long long> partial(ranges.size(), 0);
+    pool.ParallelFor(ranges.size(), [&](std::size_t i) {
+      long long sum = 0;
+      for (auto it = ranges[i].first; it != ranges[i].second; ++it) {
+        sum += std::get<2>(*it);
+      }
+      partial[i] = sum;
+    });
+    long long total = 0;
+    for (auto sum : partial) {
+      total += sum;
+    }
+    gdwg::benchmark::Report("weight sum, " + name, num_unique, sum_timer.Seconds());
+
+    gdwg::benchmark::Stopwatch histogram_timer{};
+    std::vector<std::atomic<int>> in_degree(num_nodes);
+    g.ParallelForEachEdge(
+        [&](const int&, const int& dst, const int&) {
+          in_degree[dst].fetch_add(1, std::memory_order_relaxed);
+        },
+        pool);
+    gdwg::benchmark::Report("in-degree histogram, " + name, num_unique, histogram_timer.Seconds());
+
+    if (total != expected) {
+      std::cerr << "weight sum mismatch: " << total << " != " << expected << "\n";
+      return 1;
+    }
+  }
+}
@@ -0,0 +1,49 @@
+#ifndef ASSIGNMENTS_DG_PARALLEL_SORT_H_
+#define ASSIGNMENTS_DG_PARALLEL_SORT_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/thread_pool.h"
+
+namespace gdwg {
+
+/* sorts [first, last) with comp by sorting one chunk per thread on pool, then
+ * merging neighbouring chunks in parallel rounds until one sorted run is left.
+ * Like std::sort it isn't stable */
+template <typename RandomIt, typename Compare>
+void ParallelSort(RandomIt first,
+                  RandomIt last,
+                  Compare comp,
+                  ThreadPool& pool = ThreadPool::Default()) {
+  const auto n = static_cast<std::size_t>(std::distance(first, last));
+  const auto num_chunks = std::min(pool.Size() + 1, std::max<std::size_t>(n / 4096, 1));
+  /* chunk i is [bounds[i], bounds[i + 1]) */
+  std::vector<RandomIt> bounds{};
+  for (std::size_t i = 0; i <= num_chunks; ++i) {
+    bounds.push_back(first + static_cast<std::ptrdiff_t>(n * i / num_chunks));
+  }
+  pool.ParallelFor(num_chunks, [&](std::size_t i) { std::sort(bounds[i], bounds[i + 1], comp); });
+
+  /* each round merges chunk pairs (0, 1), (2, 3), ... and drops the bound between them */
+  while (bounds.size() > 2) {
+    const auto num_pairs = (bounds.size() - 1) / 2;
+    pool.ParallelFor(num_pairs, [&](std::size_t i) {
+      std::inplace_merge(bounds[2 * i], bounds[2 * i + 1], bounds[2 * i + 2], comp);
+    });
+    std::vector<RandomIt> merged{};
+    for (std::size_t i = 0; i < bounds.size(); i += 2) {
+      merged.push_back(bounds[i]);
+    }
+    if (merged.back() != bounds.back())
+      merged.push_back(bounds.back());
+    bounds = std::move(merged);
+  }
+}
+
+}  // namespace gdwg
+
+#endif  // ASSIGNMENTS_DG_PARALLEL_SORT_H_
@@ -0,0 +1,195 @@
+#include "assignments/dg/partition.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+/* label propagation stops after this many rounds even if nodes are still moving */
+constexpr std::size_t kMaxRounds = 20;
+
+/* a node that would rather be in shard to, cutting gain fewer edges if it was */
+struct Move {
+  std::uint32_t node;
+  std::uint32_t to;
+  std::uint32_t gain;
+};
+
+/* the shard most of v's neighbours are in, and how many more of them are there
+ * than in v's own shard. counts must be all zeros (and is left that way) */
+Move BestShard(const gdwg::detail::UndirectedCsr& g,
+               const std::vector<std::uint32_t>& shard,
+               std::uint32_t v,
+               std::vector<std::uint32_t>& counts,
+               std::vector<std::uint32_t>& touched) {
+  touched.clear();
+  for (auto e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+    const auto s = shard[g.targets[e]];
+    if (counts[s]++ == 0)
+      touched.push_back(s);
+  }
+  Move best{v, shard[v], 0};
+  const auto stay = counts[shard[v]];
+  for (auto s : touched) {
+    if (counts[s] > stay + best.gain) {
+      best.to = s;
+      best.gain = counts[s] - stay;
+    }
+  }
+  for (auto s : touched) {
+    counts[s] = 0;
+  }
+  return best;
+}
+
+}  // namespace
+
+gdwg::detail::UndirectedCsr
+gdwg::detail::MakeUndirected(const std::vector<std::size_t>& out_offsets,
+                             const std::vector<std::uint32_t>& out_targets,
+                             const std::vector<std::size_t>& in_offsets,
+                             const std::vector<std::uint32_t>& in_targets) {
+  const auto n = static_cast<std::uint32_t>(out_offsets.size() - 1);
+  UndirectedCsr g{};
+  g.offsets.reserve(n + 1);
+  g.offsets.push_back(0);
+  g.targets.reserve(out_targets.size() + in_targets.size());
+  for (std::uint32_t v = 0; v < n; ++v) {
+    /* both lists are sorted by id, so merge them, dropping repeats and v itself */
+    auto out = out_offsets[v];
+    auto in = in_offsets[v];
+    const auto out_end = out_offsets[v + 1];
+    const auto in_end = in_offsets[v + 1];
+    while (out < out_end || in < in_end) {
+      std::uint32_t u;
+      if (in == in_end || (out < out_end && out_targets[out] < in_targets[in])) {
+        u = out_targets[out++];
+      } else {
+        u = in_targets[in++];
+      }
+      if (u != v && (g.targets.size() == g.offsets.back() || g.targets.back() != u))
+        g.targets.push_back(u);
+    }
+    g.offsets.push_back(g.targets.size());
+  }
+  return g;
+}
+
+std::vector<std::uint32_t> gdwg::detail::ReverseCuthillMcKee(const UndirectedCsr& g) {
+  const auto n = static_cast<std::uint32_t>(g.offsets.size() - 1);
+  auto degree = [&g](std::uint32_t v) { return g.offsets[v + 1] - g.offsets[v]; };
+  auto by_degree = [&degree](std::uint32_t a, std::uint32_t b) { return degree(a) < degree(b); };
+
+  /* each component starts from its lowest degree node; ties go to the lower id */
+  std::vector<std::uint32_t> starts(n);
+  for (std::uint32_t v = 0; v < n; ++v) {
+    starts[v] = v;
+  }
+  std::stable_sort(starts.begin(), starts.end(), by_degree);
+
+  std::vector<bool> seen(n, false);
+  std::vector<std::uint32_t> order{};
+  order.reserve(n);
+  std::vector<std::uint32_t> next{};
+  for (auto start : starts) {
+    if (seen[start])
+      continue;
+    seen[start] = true;
+    order.push_back(start);
+    /* order doubles as the queue */
+    for (auto head = order.size() - 1; head < order.size(); ++head) {
+      const auto v = order[head];
+      next.clear();
+      for (auto e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+        const auto u = g.targets[e];
+        if (!seen[u]) {
+          seen[u] = true;
+          next.push_back(u);
+        }
+      }
+      std::stable_sort(next.begin(), next.end(), by_degree);
+      order.insert(order.end(), next.begin(), next.end());
+    }
+  }
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+gdwg::Partition gdwg::detail::PartitionUndirected(const UndirectedCsr& g,
+                                                  std::size_t num_shards,
+                                                  ThreadPool& pool) {
+  const auto n = g.offsets.size() - 1;
+  const auto k = num_shards;
+  Partition p{};
+  p.num_shards = k;
+
+  /* contiguous runs of a bandwidth reducing order are already decent shards */
+  const auto rcm = ReverseCuthillMcKee(g);
+  p.shard.resize(n);
+  std::vector<std::size_t> size(k, 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto s = i * k / n;
+    p.shard[rcm[i]] = static_cast<std::uint32_t>(s);
+    ++size[s];
+  }
+  const auto capacity = std::max((n + k - 1) / k, (105 * n + 100 * k - 1) / (100 * k));
+
+  /* proposals are worked out in parallel against the shards as they were at the
+   * start of the round, then checked again against the current shards as they
+   * are applied, best first. Every move cuts fewer edges, so this can't cycle */
+  const auto num_chunks = std::min(n, 16 * (pool.Size() + 1));
+  std::vector<std::vector<Move>> proposals(num_chunks);
+  std::vector<Move> moves{};
+  std::vector<std::uint32_t> counts(k, 0);
+  std::vector<std::uint32_t> touched{};
+  for (std::size_t round = 0; round < kMaxRounds; ++round) {
+    pool.ParallelFor(num_chunks, [&](std::size_t chunk) {
+      std::vector<std::uint32_t> chunk_counts(k, 0);
+      std::vector<std::uint32_t> chunk_touched{};
+      proposals[chunk].clear();
+      for (auto v = n * chunk / num_chunks; v < n * (chunk + 1) / num_chunks; ++v) {
+        auto move =
+            BestShard(g, p.shard, static_cast<std::uint32_t>(v), chunk_counts, chunk_touched);
+        if (move.gain > 0)
+          proposals[chunk].push_back(move);
+      }
+    });
+    moves.clear();
+    for (const auto& chunk : proposals) {
+      moves.insert(moves.end(), chunk.begin(), chunk.end());
+    }
+    std::stable_sort(moves.begin(), moves.end(),
+                     [](const Move& a, const Move& b) { return a.gain > b.gain; });
+    std::size_t moved = 0;
+    for (const auto& proposal : moves) {
+      const auto move = BestShard(g, p.shard, proposal.node, counts, touched);
+      if (move.gain == 0 || size[move.to] >= capacity)
+        continue;
+      --size[p.shard[move.node]];
+      ++size[move.to];
+      p.shard[move.node] = move.to;
+      ++moved;
+    }
+    if (moved <= n / 1000)
+      break;
+  }
+
+  /* shard by shard, keeping the reverse Cuthill-McKee order within each */
+  p.shard_offsets.assign(k + 1, 0);
+  for (std::size_t s = 0; s < k; ++s) {
+    p.shard_offsets[s + 1] = p.shard_offsets[s] + size[s];
+  }
+  p.order.resize(n);
+  auto next = p.shard_offsets;
+  for (auto v : rcm) {
+    p.order[next[p.shard[v]]++] = v;
+  }
+  for (std::uint32_t v = 0; v < n; ++v) {
+    for (auto e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+      p.cut_edges += v < g.targets[e] && p.shard[v] != p.shard[g.targets[e]];
+    }
+  }
+  return p;
+}
@@ -0,0 +1,90 @@
+#ifndef ASSIGNMENTS_DG_PARTITION_H_
+#define ASSIGNMENTS_DG_PARTITION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/thread_pool.h"
+
+/* node orders and k-way partitions for laying a CsrSnapshot out in memory so
+ * that nodes sit near the nodes they share edges with. Both look at the
+ * undirected simple graph underneath the snapshot (edge direction, weights,
+ * parallel edges and reflexive edges are ignored), and both hand back orders of
+ * snapshot ids, ready for CsrSnapshot::Permuted */
+namespace gdwg {
+
+/* a split of a snapshot's nodes into num_shards shards of about the same size */
+struct Partition {
+  std::size_t num_shards{0};
+  /* each node's shard, by snapshot id */
+  std::vector<std::uint32_t> shard;
+  /* every id, shard by shard (in reverse Cuthill-McKee order within a shard), so
+   * shard s is order[shard_offsets[s]] .. order[shard_offsets[s + 1] - 1] */
+  std::vector<std::uint32_t> order;
+  std::vector<std::size_t> shard_offsets;
+  /* how many pairs of neighbours ended up in different shards */
+  std::size_t cut_edges{0};
+};
+
+/* a snapshot laid out by a Partition, for handing one shard to each thread (or
+ * machine): shard s owns nodes shard_offsets[s] .. shard_offsets[s + 1] - 1 of
+ * snapshot, and cut_edges[s] lists the indexes of the edges (into Targets() and
+ * Weights()) that leave it for another shard */
+template <typename N, typename E>
+struct ShardedSnapshot {
+  CsrSnapshot<N, E> snapshot;
+  std::vector<std::size_t> shard_offsets;
+  std::vector<std::vector<std::size_t>> cut_edges;
+};
+
+namespace detail {
+
+/* the undirected simple graph underneath a CSR, as another CSR with each
+ * node's neighbours in increasing order */
+struct UndirectedCsr {
+  std::vector<std::size_t> offsets;
+  std::vector<std::uint32_t> targets;
+};
+
+/* merges out and in, the Offsets()/Targets() of a snapshot and of its
+ * transpose */
+UndirectedCsr MakeUndirected(const std::vector<std::size_t>& out_offsets,
+                             const std::vector<std::uint32_t>& out_targets,
+                             const std::vector<std::size_t>& in_offsets,
+                             const std::vector<std::uint32_t>& in_targets);
+std::vector<std::uint32_t> ReverseCuthillMcKee(const UndirectedCsr& g);
+Partition PartitionUndirected(const UndirectedCsr& g, std::size_t num_shards, ThreadPool& pool);
+
+}  // namespace detail
+
+/* reverse Cuthill-McKee: a breadth first search of each connected component
+ * from its lowest degree node, queueing each node's unseen neighbours lowest
+ * degree first, with the whole order reversed at the end. Neighbours end up
+ * with nearby ids, so the edges of a graph that has a narrow band (meshes,
+ * grids, road networks) stay close to the diagonal */
+template <typename N, typename E>
+std::vector<std::uint32_t> ReverseCuthillMcKee(const CsrSnapshot<N, E>& g);
+
+/* splits g into num_shards shards, each with at most 5% more than its share of
+ * nodes, with as few edges between shards as balanced label propagation finds.
+ * Shards start as contiguous runs of the reverse Cuthill-McKee order; then, in
+ * rounds, every node works out (in parallel on pool) which shard most of its
+ * neighbours are in, and the nodes that would gain most move there one at a
+ * time, as long as it still pays and the shard has room. Stops once a round
+ * moves next to nothing. Throws std::invalid_argument if num_shards is 0 */
+template <typename N, typename E>
+Partition PartitionGraph(const CsrSnapshot<N, E>& g,
+                         std::size_t num_shards,
+                         ThreadPool& pool = ThreadPool::Default());
+
+/* g laid out by partition, which must have been made from g */
+template <typename N, typename E>
+ShardedSnapshot<N, E> Shard(const CsrSnapshot<N, E>& g, const Partition& partition);
+
+}  // namespace gdwg
+
+#include "assignments/dg/partition.tpp"
+
+#endif  // ASSIGNMENTS_DG_PARTITION_H_
@@ -0,0 +1,40 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+template <typename N, typename E>
+std::vector<std::uint32_t> gdwg::ReverseCuthillMcKee(const CsrSnapshot<N, E>& g) {
+  const auto t = g.Transposed();
+  return detail::ReverseCuthillMcKee(
+      detail::MakeUndirected(g.Offsets(), g.Targets(), t.Offsets(), t.Targets()));
+}
+
+template <typename N, typename E>
+gdwg::Partition
+gdwg::PartitionGraph(const CsrSnapshot<N, E>& g, std::size_t num_shards, ThreadPool& pool) {
+  if (num_shards == 0) {
+    throw std::invalid_argument("Cannot call PartitionGraph with no shards");
+  }
+  const auto t = g.Transposed();
+  return detail::PartitionUndirected(
+      detail::MakeUndirected(g.Offsets(), g.Targets(), t.Offsets(), t.Targets()), num_shards,
+      pool);
+}
+
+template <typename N, typename E>
+gdwg::ShardedSnapshot<N, E> gdwg::Shard(const CsrSnapshot<N, E>& g, const Partition& partition) {
+  ShardedSnapshot<N, E> sharded{g.Permuted(partition.order), partition.shard_offsets, {}};
+  const auto& offsets = sharded.snapshot.Offsets();
+  const auto& targets = sharded.snapshot.Targets();
+  sharded.cut_edges.resize(partition.num_shards);
+  for (std::size_t s = 0; s < partition.num_shards; ++s) {
+    const auto first = partition.shard_offsets[s];
+    const auto last = partition.shard_offsets[s + 1];
+    for (auto e = offsets[first]; e < offsets[last]; ++e) {
+      if (targets[e] < first || targets[e] >= last)
+        sharded.cut_edges[s].push_back(e);
+    }
+  }
+  return sharded;
+}
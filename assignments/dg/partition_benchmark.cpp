@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/partition.h"
+
+namespace {
+
+/* a full BFS from start, returning the sum of the depths so it can't be
+ * optimised away */
+std::uint64_t Bfs(const gdwg::CsrSnapshot<int, int>& g,
+                  std::uint32_t start,
+                  std::vector<std::uint32_t>& depth,
+                  std::vector<std::uint32_t>& queue) {
+  const auto unseen = static_cast<std::uint32_t>(-1);
+  std::fill(depth.begin(), depth.end(), unseen);
+  queue.clear();
+  queue.push_back(start);
+  depth[start] = 0;
+  std::uint64_t total = 0;
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    const auto v = queue[head];
+    total += depth[v];
+    for (auto e = g.Offsets()[v]; e < g.Offsets()[v + 1]; ++e) {
+      const auto u = g.Targets()[e];
+      if (depth[u] == unseen) {
+        depth[u] = depth[v] + 1;
+        queue.push_back(u);
+      }
+    }
+  }
+  return total;
+}
+
+/* one pull style sweep (as in PageRank): every node sums its neighbours' values */
+void Sweep(const gdwg::CsrSnapshot<int, int>& g,
+           const std::vector<double>& in,
+           std::vector<double>& out) {
+  for (std::uint32_t v = 0; v < g.NumNodes(); ++v) {
+    double sum = 0;
+    for (auto e = g.Offsets()[v]; e < g.Offsets()[v + 1]; ++e) {
+      sum += in[g.Targets()[e]];
+    }
+    out[v] = 0.15 + 0.85 * sum / 4;
+  }
+}
+
+/* times repetitions of a full BFS (from node 0) and of a sweep over every edge
+ * on layout */
+void TimeTraversals(const std::string& name,
+                    const gdwg::CsrSnapshot<int, int>& layout,
+                    std::size_t repetitions,
+                    gdwg::benchmark::JsonResults& json) {
+  std::vector<std::uint32_t> depth(layout.NumNodes());
+  std::vector<std::uint32_t> queue{};
+  queue.reserve(layout.NumNodes());
+  const auto start = layout.Id(0);
+  std::uint64_t check = 0;
+  gdwg::benchmark::Stopwatch bfs_timer{};
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    check += Bfs(layout, start, depth, queue);
+  }
+  const auto bfs_seconds = bfs_timer.Seconds();
+  gdwg::benchmark::Report(name + " bfs", repetitions * layout.NumEdges(), bfs_seconds);
+  json.Add("bfs", {{"layout", name}}, repetitions * layout.NumEdges(), bfs_seconds);
+
+  std::vector<double> a(layout.NumNodes(), 1.0);
+  std::vector<double> b(layout.NumNodes(), 0.0);
+  gdwg::benchmark::Stopwatch sweep_timer{};
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    Sweep(layout, a, b);
+    a.swap(b);
+  }
+  const auto sweep_seconds = sweep_timer.Seconds();
+  gdwg::benchmark::Report(name + " sweep", repetitions * layout.NumEdges(), sweep_seconds);
+  json.Add("sweep", {{"layout", name}}, repetitions * layout.NumEdges(), sweep_seconds);
+  std::cout << "  (check " << check << ", " << a[start] << ")\n";
+}
+
+}  // namespace
+
+/* edges per second of a full BFS and of a PageRank style sweep over a side x
+ * side grid whose node labels are shuffled, so the snapshot's value order
+ * scatters neighbours all over memory, then the same over the snapshot laid out
+ * in reverse Cuthill-McKee order and by PartitionGraph's shards. Also reports how
+ * many edges the shards cut, against splitting the shuffled ids into runs.
+ * usage: partition_benchmark [side (default 700)] [num_shards (default 8)]
+ *                            [repetitions (default 10)] */
+int main(int argc, char** argv) {
+  const auto side = static_cast<int>(gdwg::benchmark::Arg(argc, argv, 1, 700));
+  const auto num_shards = gdwg::benchmark::Arg(argc, argv, 2, 8);
+  const auto repetitions = gdwg::benchmark::Arg(argc, argv, 3, 10);
+
+  std::vector<int> label(static_cast<std::size_t>(side) * static_cast<std::size_t>(side));
+  std::iota(label.begin(), label.end(), 0);
+  std::shuffle(label.begin(), label.end(), std::mt19937{6771});
+  auto at = [&label, side](int r, int c) { return label[static_cast<std::size_t>(r * side + c)]; };
+  std::vector<std::tuple<int, int, int>> edges{};
+  for (int r = 0; r < side; ++r) {
+    for (int c = 0; c < side; ++c) {
+      if (c + 1 < side) {
+        edges.emplace_back(at(r, c), at(r, c + 1), 1);
+        edges.emplace_back(at(r, c + 1), at(r, c), 1);
+      }
+      if (r + 1 < side) {
+        edges.emplace_back(at(r, c), at(r + 1, c), 1);
+        edges.emplace_back(at(r + 1, c), at(r, c), 1);
+      }
+    }
+  }
+  gdwg::Graph<int, int> g{edges.cbegin(), edges.cend()};
+  gdwg::CsrSnapshot<int, int> csr{g};
+  gdwg::benchmark::JsonResults json{};
+
+  gdwg::benchmark::Stopwatch rcm_timer{};
+  const auto rcm = csr.Permuted(gdwg::ReverseCuthillMcKee(csr));
+  gdwg::benchmark::Report("ReverseCuthillMcKee + Permuted", csr.NumEdges(), rcm_timer.Seconds());
+  gdwg::benchmark::Stopwatch partition_timer{};
+  const auto partition = gdwg::PartitionGraph(csr, num_shards);
+  const auto sharded = gdwg::Shard(csr, partition);
+  gdwg::benchmark::Report("PartitionGraph + Shard", csr.NumEdges(), partition_timer.Seconds());
+
+  std::size_t naive_cut = 0;
+  const auto n = csr.NumNodes();
+  for (std::uint32_t v = 0; v < n; ++v) {
+    for (auto e = csr.Offsets()[v]; e < csr.Offsets()[v + 1]; ++e) {
+      const auto u = csr.Targets()[e];
+      naive_cut += v < u && v * num_shards / n != u * num_shards / n;
+    }
+  }
+  std::cout << "  " << num_shards << " shards cut " << partition.cut_edges << " of "
+            << csr.NumEdges() / 2 << " edges (runs of shuffled ids cut " << naive_cut << ")\n";
+
+  TimeTraversals("shuffled", csr, repetitions, json);
+  TimeTraversals("rcm", rcm, repetitions, json);
+  TimeTraversals("sharded", sharded.snapshot, repetitions, json);
+  json.Write(std::cout);
+}
@@ -0,0 +1,189 @@
+#include "assignments/dg/partition.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+#include "catch.h"
+
+namespace {
+
+/* a side x side grid with edges both ways between neighbours, with the node
+ * labels shuffled so that value order has nothing to do with the grid */
+gdwg::Graph<int, int> ShuffledGrid(int side) {
+  std::vector<int> label(static_cast<std::size_t>(side * side));
+  std::iota(label.begin(), label.end(), 0);
+  std::shuffle(label.begin(), label.end(), std::mt19937{6771});
+  gdwg::Graph<int, int> g{};
+  for (auto l : label) {
+    g.InsertNode(l);
+  }
+  for (int r = 0; r < side; ++r) {
+    for (int c = 0; c < side; ++c) {
+      const auto v = label[static_cast<std::size_t>(r * side + c)];
+      if (c + 1 < side) {
+        g.InsertEdge(v, label[static_cast<std::size_t>(r * side + c + 1)], 1);
+        g.InsertEdge(label[static_cast<std::size_t>(r * side + c + 1)], v, 1);
+      }
+      if (r + 1 < side) {
+        g.InsertEdge(v, label[static_cast<std::size_t>((r + 1) * side + c)], 1);
+        g.InsertEdge(label[static_cast<std::size_t>((r + 1) * side + c)], v, 1);
+      }
+    }
+  }
+  return g;
+}
+
+/* the largest id distance between the ends of any edge */
+template <typename N, typename E>
+std::uint32_t Bandwidth(const gdwg::CsrSnapshot<N, E>& g) {
+  std::uint32_t widest = 0;
+  for (std::uint32_t v = 0; v < g.NumNodes(); ++v) {
+    for (auto e = g.Offsets()[v]; e < g.Offsets()[v + 1]; ++e) {
+      const auto u = g.Targets()[e];
+      widest = std::max(widest, u > v ? u - v : v - u);
+    }
+  }
+  return widest;
+}
+
+bool IsPermutation(std::vector<std::uint32_t> order, std::size_t n) {
+  std::sort(order.begin(), order.end());
+  std::vector<std::uint32_t> ids(n);
+  std::iota(ids.begin(), ids.end(), 0);
+  return order == ids;
+}
+
+}  // namespace
+
+SCENARIO("ordering nodes so neighbours are close") {
+  GIVEN("a grid with shuffled labels") {
+    const auto g = ShuffledGrid(20);
+    gdwg::CsrSnapshot<int, int> csr{g};
+    WHEN("we lay it out in reverse Cuthill-McKee order") {
+      const auto order = gdwg::ReverseCuthillMcKee(csr);
+      const auto laid_out = csr.Permuted(order);
+      THEN("every node is kept, and edges stay near the diagonal") {
+        REQUIRE(IsPermutation(order, csr.NumNodes()));
+        REQUIRE(Bandwidth(csr) > 200);
+        REQUIRE(Bandwidth(laid_out) <= 21);
+      }
+    }
+  }
+  GIVEN("a graph with several components, loops, parallel edges and an isolated node") {
+    std::vector<std::tuple<std::string, std::string, int>> edges{
+        {"a", "b", 1}, {"a", "b", 2}, {"b", "c", 1}, {"c", "c", 1}, {"x", "y", 1}, {"z", "y", 1}};
+    gdwg::Graph<std::string, int> g{edges.begin(), edges.end()};
+    g.InsertNode("lonely");
+    gdwg::CsrSnapshot<std::string, int> csr{g};
+    THEN("each component comes out in one piece") {
+      const auto order = gdwg::ReverseCuthillMcKee(csr);
+      REQUIRE(IsPermutation(order, csr.NumNodes()));
+      std::vector<std::string> values{};
+      for (auto id : order) {
+        values.push_back(csr.Value(id));
+      }
+      REQUIRE(values == std::vector<std::string>{"z", "y", "x", "c", "b", "a", "lonely"});
+    }
+  }
+}
+
+SCENARIO("partitioning a graph into shards") {
+  gdwg::ThreadPool pool{3};
+  GIVEN("two cliques joined by one edge") {
+    gdwg::Graph<int, int> g{};
+    for (int v = 0; v < 16; ++v) {
+      g.InsertNode(v);
+    }
+    for (int u = 0; u < 8; ++u) {
+      for (int v = 0; v < 8; ++v) {
+        if (u != v) {
+          g.InsertEdge(2 * u, 2 * v, 1);
+          g.InsertEdge(2 * u + 1, 2 * v + 1, 1);
+        }
+      }
+    }
+    g.InsertEdge(0, 1, 1);
+    gdwg::CsrSnapshot<int, int> csr{g};
+    const auto p = gdwg::PartitionGraph(csr, 2, pool);
+    THEN("each clique gets its own shard") {
+      REQUIRE(p.num_shards == 2);
+      REQUIRE(p.cut_edges == 1);
+      for (int v = 0; v < 16; ++v) {
+        REQUIRE(p.shard[csr.Id(v)] == p.shard[csr.Id(v % 2)]);
+      }
+      REQUIRE(p.shard_offsets == std::vector<std::size_t>{0, 8, 16});
+    }
+    WHEN("we lay the snapshot out by shard") {
+      const auto sharded = gdwg::Shard(csr, p);
+      THEN("each shard owns a run of ids, and only the joining edge is cut") {
+        REQUIRE(sharded.snapshot.NumEdges() == csr.NumEdges());
+        REQUIRE(sharded.shard_offsets == p.shard_offsets);
+        const auto zero_shard = p.shard[csr.Id(0)];
+        REQUIRE(sharded.cut_edges[1 - zero_shard].empty());
+        REQUIRE(sharded.cut_edges[zero_shard].size() == 1);
+        const auto e = sharded.cut_edges[zero_shard].front();
+        REQUIRE(sharded.snapshot.Value(sharded.snapshot.Targets()[e]) == 1);
+        REQUIRE(sharded.snapshot.Id(0) / 8 == zero_shard);
+      }
+    }
+  }
+  GIVEN("a grid with shuffled labels") {
+    const auto g = ShuffledGrid(30);
+    gdwg::CsrSnapshot<int, int> csr{g};
+    const std::size_t k = 6;
+    const auto p = gdwg::PartitionGraph(csr, k, pool);
+    THEN("the shards are balanced and agree with each other") {
+      REQUIRE(IsPermutation(p.order, csr.NumNodes()));
+      REQUIRE(p.shard_offsets.size() == k + 1);
+      REQUIRE(p.shard_offsets.back() == csr.NumNodes());
+      for (std::size_t s = 0; s < k; ++s) {
+        REQUIRE(p.shard_offsets[s + 1] - p.shard_offsets[s] <= 158);
+        for (auto i = p.shard_offsets[s]; i < p.shard_offsets[s + 1]; ++i) {
+          REQUIRE(p.shard[p.order[i]] == s);
+        }
+      }
+    }
+    THEN("far fewer edges are cut than by shards of the original ids") {
+      std::size_t cut = 0;
+      std::size_t naive_cut = 0;
+      const auto n = csr.NumNodes();
+      for (std::uint32_t v = 0; v < n; ++v) {
+        for (auto e = csr.Offsets()[v]; e < csr.Offsets()[v + 1]; ++e) {
+          const auto u = csr.Targets()[e];
+          cut += v < u && p.shard[v] != p.shard[u];
+          naive_cut += v < u && v * k / n != u * k / n;
+        }
+      }
+      REQUIRE(cut == p.cut_edges);
+      REQUIRE(cut * 5 < naive_cut);
+    }
+  }
+  GIVEN("an empty graph, and a graph with fewer nodes than shards") {
+    gdwg::Graph<int, int> empty{};
+    gdwg::Graph<int, int> tiny{};
+    tiny.InsertNode(1);
+    tiny.InsertNode(2);
+    THEN("there are still num_shards shards") {
+      const auto p = gdwg::PartitionGraph(gdwg::CsrSnapshot<int, int>{empty}, 3, pool);
+      REQUIRE(p.order.empty());
+      REQUIRE(p.shard_offsets == std::vector<std::size_t>{0, 0, 0, 0});
+      const auto q = gdwg::PartitionGraph(gdwg::CsrSnapshot<int, int>{tiny}, 3, pool);
+      REQUIRE(q.shard_offsets.back() == 2);
+      REQUIRE(q.cut_edges == 0);
+    }
+    THEN("asking for no shards throws") {
+      REQUIRE_THROWS_AS(gdwg::PartitionGraph(gdwg::CsrSnapshot<int, int>{tiny}, 0, pool),
+                        std::invalid_argument);
+    }
+  }
+}
@@ -0,0 +1,118 @@
+#ifndef ASSIGNMENTS_DG_POINT_TO_POINT_H_
+#define ASSIGNMENTS_DG_POINT_TO_POINT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/indexed_heap.h"
+
+namespace gdwg {
+
+template <typename N, typename E>
+struct ShortestPath {
+  bool found{false};
+  /* the path's total weight, only meaningful if found */
+  E distance{};
+  /* src, ..., dst, or empty if dst can't be reached */
+  std::vector<N> nodes;
+};
+
+namespace detail {
+
+/* everything one search needs, sized for graphs of up to Capacity() nodes. A
+ * node's dist/parent only count if its stamp matches the current generation, so
+ * starting a new search is O(1) rather than a sweep over every node */
+template <typename E>
+class SearchState {
+ public:
+  struct Side {
+    explicit Side(std::size_t n) : heap(n), dist(n), parent(n), stamp(n, 0) {}
+    IndexedHeap<E> heap;
+    std::vector<E> dist;
+    std::vector<std::uint32_t> parent;
+    std::vector<std::uint32_t> stamp;
+  };
+
+  explicit SearchState(std::size_t n = 0) : forward_{n}, backward_{n} {}
+
+  std::size_t Capacity() const { return forward_.dist.size(); }
+  /* starts a new search on a graph of n nodes, only allocating if it has more
+   * nodes than any graph this state has been used on before */
+  void Begin(std::size_t n);
+  Side& Forward() { return forward_; }
+  Side& Backward() { return backward_; }
+  bool Seen(const Side& side, std::uint32_t v) const { return side.stamp[v] == generation_; }
+  void Set(Side& side, std::uint32_t v, const E& dist, std::uint32_t parent) {
+    side.stamp[v] = generation_;
+    side.dist[v] = dist;
+    side.parent[v] = parent;
+  }
+
+ private:
+  Side forward_;
+  Side backward_;
+  std::uint32_t generation_{0};
+};
+
+/* this thread's search state for weights of type E, shared by every search on
+ * the thread (so searches mustn't run inside one another). Begin grows it for
+ * bigger graphs */
+template <typename E>
+SearchState<E>& ThreadSearchState() {
+  static thread_local SearchState<E> state{};
+  return state;
+}
+
+}  // namespace detail
+
+/* one source, one target shortest paths over a graph's edge weights, which must
+ * not be negative. The graph is copied once into forward and backward CSR arrays
+ * (its outgoing_ and incoming_ sets, flattened), and queries then run:
+ *  - BidirectionalDijkstra: Dijkstra forwards from src and backwards from dst at
+ *    the same time, stopping once the two frontiers' best keys add up to at
+ *    least the best path seen so far, so each side only searches about half as
+ *    far as a plain Dijkstra would
+ *  - AStar: Dijkstra from src ordered by dist + heuristic(node, dst), where the
+ *    heuristic must never overestimate the real distance left (admissible). It
+ *    needn't be consistent: nodes are reopened if a shorter path turns up
+ * Every thread keeps its own search state (distances, parents and heaps) between
+ * queries, so after the first query on a thread a search allocates nothing
+ * beyond the result's nodes */
+template <typename N, typename E>
+class PathFinder {
+ public:
+  /* ctors. Throw std::domain_error if any weight is negative */
+  explicit PathFinder(const CsrSnapshot<N, E>& g);
+  explicit PathFinder(const Graph<N, E>& g) : PathFinder(CsrSnapshot<N, E>{g}) {}
+
+  /* methods. Both throw std::out_of_range if src or dst isn't a node. The
+   * out-parameter versions reuse out.nodes' storage */
+  ShortestPath<N, E> BidirectionalDijkstra(const N& src, const N& dst) const;
+  void BidirectionalDijkstra(const N& src, const N& dst, ShortestPath<N, E>& out) const;
+  /* heuristic(node, dst) returns an E no bigger than node's distance to dst */
+  template <typename Heuristic>
+  ShortestPath<N, E> AStar(const N& src, const N& dst, Heuristic heuristic) const;
+  template <typename Heuristic>
+  void AStar(const N& src, const N& dst, Heuristic heuristic, ShortestPath<N, E>& out) const;
+
+  std::size_t NumNodes() const { return forward_.NumNodes(); }
+
+ private:
+  using node_id = std::uint32_t;
+
+  /* src's ..., v chain of forward parents, then v's ..., dst chain of backward
+   * parents (if any) */
+  void WritePath(detail::SearchState<E>& state, node_id v, ShortestPath<N, E>& out) const;
+
+  CsrSnapshot<N, E> forward_;
+  CsrSnapshot<N, E> backward_;
+};
+
+}  // namespace gdwg
+
+#include "assignments/dg/point_to_point.tpp"
+
+#endif  // ASSIGNMENTS_DG_POINT_TO_POINT_H_
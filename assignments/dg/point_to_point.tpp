@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+template <typename E>
+void gdwg::detail::SearchState<E>::Begin(std::size_t n) {
+  if (Capacity() < n) {
+    forward_ = Side{n};
+    backward_ = Side{n};
+  }
+  forward_.heap.Clear();
+  backward_.heap.Clear();
+  /* stamps from 4 billion searches ago would look current again, so start over */
+  if (++generation_ == 0) {
+    std::fill(forward_.stamp.begin(), forward_.stamp.end(), 0);
+    std::fill(backward_.stamp.begin(), backward_.stamp.end(), 0);
+    generation_ = 1;
+  }
+}
+
+template <typename N, typename E>
+gdwg::PathFinder<N, E>::PathFinder(const CsrSnapshot<N, E>& g)
+  : forward_{g}, backward_{g.Transposed()} {
+  for (const auto& w : g.Weights()) {
+    if (w < E{}) {
+      throw std::domain_error("Cannot make a PathFinder for a graph with negative weights");
+    }
+  }
+}
+
+template <typename N, typename E>
+gdwg::ShortestPath<N, E> gdwg::PathFinder<N, E>::BidirectionalDijkstra(const N& src,
+                                                                      const N& dst) const {
+  ShortestPath<N, E> out{};
+  BidirectionalDijkstra(src, dst, out);
+  return out;
+}
+
+template <typename N, typename E>
+void gdwg::PathFinder<N, E>::BidirectionalDijkstra(const N& src,
+                                                   const N& dst,
+                                                   ShortestPath<N, E>& out) const {
+  const auto s = forward_.Id(src);
+  const auto t = forward_.Id(dst);
+  auto& state = detail::ThreadSearchState<E>();
+  state.Begin(NumNodes());
+  auto& fwd = state.Forward();
+  auto& bwd = state.Backward();
+  state.Set(fwd, s, E{}, s);
+  state.Set(bwd, t, E{}, t);
+  fwd.heap.PushOrDecrease(s, E{});
+  bwd.heap.PushOrDecrease(t, E{});
+
+  bool found = s == t;
+  E best{};
+  node_id meet = s;
+  while (!fwd.heap.Empty() && !bwd.heap.Empty()) {
+    /* no path through anything still queued can beat best any more */
+    if (found && !(fwd.heap.KeyOf(fwd.heap.Top()) + bwd.heap.KeyOf(bwd.heap.Top()) < best))
+      break;
+    /* grow whichever side has the smaller frontier */
+    const bool go_forward = fwd.heap.Size() <= bwd.heap.Size();
+    auto& side = go_forward ? fwd : bwd;
+    auto& other = go_forward ? bwd : fwd;
+    const auto& g = go_forward ? forward_ : backward_;
+    const auto u = side.heap.Pop();
+    for (auto e = g.Offsets()[u]; e < g.Offsets()[u + 1]; ++e) {
+      const auto v = g.Targets()[e];
+      const E dist = side.dist[u] + g.Weights()[e];
+      if (state.Seen(side, v) && !(dist < side.dist[v]))
+        continue;
+      state.Set(side, v, dist, u);
+      side.heap.PushOrDecrease(v, dist);
+      if (state.Seen(other, v) && (!found || dist + other.dist[v] < best)) {
+        found = true;
+        best = dist + other.dist[v];
+        meet = v;
+      }
+    }
+  }
+
+  out.found = found;
+  out.distance = best;
+  out.nodes.clear();
+  if (found)
+    WritePath(state, meet, out);
+}
+
+template <typename N, typename E>
+template <typename Heuristic>
+gdwg::ShortestPath<N, E>
+gdwg::PathFinder<N, E>::AStar(const N& src, const N& dst, Heuristic heuristic) const {
+  ShortestPath<N, E> out{};
+  AStar(src, dst, heuristic, out);
+  return out;
+}
+
+template <typename N, typename E>
+template <typename Heuristic>
+void gdwg::PathFinder<N, E>::AStar(const N& src,
+                                   const N& dst,
+                                   Heuristic heuristic,
+                                   ShortestPath<N, E>& out) const {
+  const auto s = forward_.Id(src);
+  const auto t = forward_.Id(dst);
+  auto& state = detail::ThreadSearchState<E>();
+  state.Begin(NumNodes());
+  auto& fwd = state.Forward();
+  /* the backward side isn't searched, so it caches each node's heuristic. Its
+   * parent is the node itself, which keeps WritePath from following it */
+  auto& cache = state.Backward();
+  auto estimate = [&](node_id v) -> const E& {
+    if (!state.Seen(cache, v))
+      state.Set(cache, v, heuristic(forward_.Value(v), dst), v);
+    return cache.dist[v];
+  };
+  state.Set(fwd, s, E{}, s);
+  fwd.heap.PushOrDecrease(s, estimate(s));
+
+  out.found = false;
+  out.nodes.clear();
+  while (!fwd.heap.Empty()) {
+    const auto u = fwd.heap.Pop();
+    if (u == t) {
+      out.found = true;
+      out.distance = fwd.dist[t];
+      WritePath(state, t, out);
+      return;
+    }
+    for (auto e = forward_.Offsets()[u]; e < forward_.Offsets()[u + 1]; ++e) {
+      const auto v = forward_.Targets()[e];
+      const E dist = fwd.dist[u] + forward_.Weights()[e];
+      if (state.Seen(fwd, v) && !(dist < fwd.dist[v]))
+        continue;
+      state.Set(fwd, v, dist, u);
+      fwd.heap.PushOrDecrease(v, dist + estimate(v));
+    }
+  }
+  out.distance = E{};
+}
+
+template <typename N, typename E>
+void gdwg::PathFinder<N, E>::WritePath(detail::SearchState<E>& state,
+                                       node_id v,
+                                       ShortestPath<N, E>& out) const {
+  const auto& fwd = state.Forward();
+  const auto& bwd = state.Backward();
+  for (auto u = v;; u = fwd.parent[u]) {
+    out.nodes.push_back(forward_.Value(u));
+    if (fwd.parent[u] == u)
+      break;
+  }
+  std::reverse(out.nodes.begin(), out.nodes.end());
+  for (auto u = v; state.Seen(bwd, u) && bwd.parent[u] != u;) {
+    u = bwd.parent[u];
+    out.nodes.push_back(forward_.Value(u));
+  }
+}
@@ -0,0 +1,82 @@
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/point_to_point.h"
+
+/* query latency percentiles for random (src, dst) pairs on a side x side grid
+ * with random weights of 1..100 both ways between neighbours: plain Dijkstra
+ * (A* with a zero heuristic), bidirectional Dijkstra, and A* with the Manhattan
+ * distance as its heuristic.
+ * usage: point_to_point_benchmark [side (default 500)] [num_queries (default 1000)] */
+int main(int argc, char** argv) {
+  const auto side = static_cast<int>(gdwg::benchmark::Arg(argc, argv, 1, 500));
+  const auto num_queries = gdwg::benchmark::Arg(argc, argv, 2, 1000);
+
+  std::mt19937 rng{6771};
+  std::uniform_int_distribution<int> weight{1, 100};
+  std::vector<std::tuple<int, int, int>> edges{};
+  for (int r = 0; r < side; ++r) {
+    for (int c = 0; c < side; ++c) {
+      const int v = r * side + c;
+      if (c + 1 < side) {
+        edges.emplace_back(v, v + 1, weight(rng));
+        edges.emplace_back(v + 1, v, weight(rng));
+      }
+      if (r + 1 < side) {
+        edges.emplace_back(v, v + side, weight(rng));
+        edges.emplace_back(v + side, v, weight(rng));
+      }
+    }
+  }
+  gdwg::Graph<int, int> g{edges.cbegin(), edges.cend()};
+  gdwg::benchmark::Stopwatch build_timer{};
+  gdwg::PathFinder<int, int> finder{g};
+  gdwg::benchmark::Report("PathFinder build", edges.size(), build_timer.Seconds());
+
+  std::uniform_int_distribution<int> node{0, side * side - 1};
+  std::vector<std::pair<int, int>> queries{};
+  for (std::size_t i = 0; i < num_queries; ++i) {
+    queries.emplace_back(node(rng), node(rng));
+  }
+  auto zero = [](int, int) { return 0; };
+  /* every weight is at least 1, so each step left is worth at least 1 */
+  auto manhattan = [side](int a, int b) {
+    return std::abs(a / side - b / side) + std::abs(a % side - b % side);
+  };
+
+  gdwg::ShortestPath<int, int> result{};
+  std::vector<double> dijkstra{};
+  std::vector<double> bidirectional{};
+  std::vector<double> astar{};
+  long long checksum = 0;
+  for (const auto& [src, dst] : queries) {
+    gdwg::benchmark::Stopwatch dijkstra_timer{};
+    finder.AStar(src, dst, zero, result);
+    dijkstra.push_back(dijkstra_timer.Seconds());
+    const auto expected = result.distance;
+
+    gdwg::benchmark::Stopwatch bidirectional_timer{};
+    finder.BidirectionalDijkstra(src, dst, result);
+    bidirectional.push_back(bidirectional_timer.Seconds());
+    checksum += result.distance != expected;
+
+    gdwg::benchmark::Stopwatch astar_timer{};
+    finder.AStar(src, dst, manhattan, result);
+    astar.push_back(astar_timer.Seconds());
+    checksum += result.distance != expected;
+  }
+  gdwg::benchmark::ReportLatencies("dijkstra", dijkstra);
+  gdwg::benchmark::ReportLatencies("bidirectional dijkstra", bidirectional);
+  gdwg::benchmark::ReportLatencies("a* (manhattan)", astar);
+  if (checksum != 0) {
+    std::cerr << checksum << " queries disagreed on the distance\n";
+    return 1;
+  }
+}
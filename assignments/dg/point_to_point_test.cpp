@@ -0,0 +1,144 @@
+#include "assignments/dg/point_to_point.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+#include "catch.h"
+
+namespace {
+
+/* plain Dijkstra over the whole graph, for checking against */
+std::vector<int> AllDistances(const gdwg::Graph<int, int>& g, int n, int src) {
+  std::vector<int> dist(static_cast<std::size_t>(n), -1);
+  dist[static_cast<std::size_t>(src)] = 0;
+  std::vector<bool> done(static_cast<std::size_t>(n), false);
+  for (int round = 0; round < n; ++round) {
+    int u = -1;
+    for (int v = 0; v < n; ++v) {
+      const auto i = static_cast<std::size_t>(v);
+      if (!done[i] && dist[i] >= 0 && (u < 0 || dist[i] < dist[static_cast<std::size_t>(u)]))
+        u = v;
+    }
+    if (u < 0)
+      break;
+    done[static_cast<std::size_t>(u)] = true;
+    for (const auto& [src_node, dst, w] : g) {
+      const auto d = static_cast<std::size_t>(dst);
+      if (src_node == u && (dist[d] < 0 || dist[static_cast<std::size_t>(u)] + w < dist[d]))
+        dist[d] = dist[static_cast<std::size_t>(u)] + w;
+    }
+  }
+  return dist;
+}
+
+/* the total weight of a path, taking the lightest edge between each pair */
+int PathWeight(const gdwg::Graph<int, int>& g, const std::vector<int>& path) {
+  int total = 0;
+  for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+    auto weights = g.GetWeights(path[i], path[i + 1]);
+    REQUIRE(!weights.empty());
+    total += *std::min_element(weights.begin(), weights.end());
+  }
+  return total;
+}
+
+}  // namespace
+
+SCENARIO("PathFinder on a small graph") {
+  GIVEN("a graph with a short cut that looks long") {
+    std::vector<std::tuple<std::string, std::string, double>> edges{
+        {"a", "b", 1}, {"b", "c", 1}, {"c", "d", 1}, {"a", "d", 5}, {"d", "e", 1},
+        {"a", "e", 2.5}, {"e", "a", 1}, {"f", "a", 1}};
+    gdwg::Graph<std::string, double> g{edges.begin(), edges.end()};
+    gdwg::PathFinder<std::string, double> finder{g};
+    THEN("both searches find the shortest path") {
+      auto bidirectional = finder.BidirectionalDijkstra("a", "d");
+      REQUIRE(bidirectional.found);
+      REQUIRE(bidirectional.distance == Approx(3));
+      REQUIRE(bidirectional.nodes == std::vector<std::string>{"a", "b", "c", "d"});
+      auto zero = [](const std::string&, const std::string&) { return 0.0; };
+      auto astar = finder.AStar("a", "d", zero);
+      REQUIRE(astar.distance == Approx(3));
+      REQUIRE(astar.nodes == bidirectional.nodes);
+      REQUIRE(finder.BidirectionalDijkstra("b", "a").nodes ==
+              std::vector<std::string>{"b", "c", "d", "e", "a"});
+    }
+    THEN("a node reaches itself for free, and unreachable nodes aren't found") {
+      auto self = finder.BidirectionalDijkstra("c", "c");
+      REQUIRE(self.found);
+      REQUIRE(self.nodes == std::vector<std::string>{"c"});
+      auto none = finder.BidirectionalDijkstra("a", "f");
+      REQUIRE(!none.found);
+      REQUIRE(none.nodes.empty());
+      REQUIRE(!finder.AStar("a", "f", [](const std::string&, const std::string&) {
+                       return 0.0;
+                     }).found);
+    }
+    THEN("unknown nodes throw") {
+      REQUIRE_THROWS_AS(finder.BidirectionalDijkstra("a", "z"), std::out_of_range);
+    }
+  }
+  GIVEN("a graph with a negative weight") {
+    std::vector<std::tuple<int, int, int>> edges{{1, 2, -1}};
+    gdwg::Graph<int, int> g{edges.begin(), edges.end()};
+    REQUIRE_THROWS_AS((gdwg::PathFinder<int, int>{g}), std::domain_error);
+  }
+}
+
+SCENARIO("PathFinder on a grid") {
+  /* a 12 x 12 grid with random weights of at least 1 both ways between
+   * neighbours, so Manhattan distance never overestimates */
+  const int side = 12;
+  const int n = side * side;
+  std::mt19937 rng{36};
+  std::vector<std::tuple<int, int, int>> edges{};
+  for (int r = 0; r < side; ++r) {
+    for (int c = 0; c < side; ++c) {
+      const int v = r * side + c;
+      if (c + 1 < side) {
+        edges.emplace_back(v, v + 1, 1 + static_cast<int>(rng() % 9));
+        edges.emplace_back(v + 1, v, 1 + static_cast<int>(rng() % 9));
+      }
+      if (r + 1 < side) {
+        edges.emplace_back(v, v + side, 1 + static_cast<int>(rng() % 9));
+        edges.emplace_back(v + side, v, 1 + static_cast<int>(rng() % 9));
+      }
+    }
+  }
+  gdwg::Graph<int, int> g{edges.begin(), edges.end()};
+  gdwg::PathFinder<int, int> finder{g};
+  auto manhattan = [](int a, int b) {
+    return std::abs(a / side - b / side) + std::abs(a % side - b % side);
+  };
+  /* one result reused for every query, like a caller in a loop would */
+  gdwg::ShortestPath<int, int> result{};
+  for (int src : {0, 17, 77, 143}) {
+    const auto expected = AllDistances(g, n, src);
+    for (int dst = 0; dst < n; ++dst) {
+      finder.BidirectionalDijkstra(src, dst, result);
+      REQUIRE(result.distance == expected[static_cast<std::size_t>(dst)]);
+      REQUIRE(result.nodes.front() == src);
+      REQUIRE(result.nodes.back() == dst);
+      REQUIRE(PathWeight(g, result.nodes) == result.distance);
+      finder.AStar(src, dst, manhattan, result);
+      REQUIRE(result.distance == expected[static_cast<std::size_t>(dst)]);
+      REQUIRE(PathWeight(g, result.nodes) == result.distance);
+    }
+  }
+  THEN("queries on other threads get their own search state") {
+    gdwg::ThreadPool pool{3};
+    std::vector<int> distances(static_cast<std::size_t>(n));
+    pool.ParallelFor(distances.size(), [&](std::size_t dst) {
+      distances[dst] = finder.BidirectionalDijkstra(0, static_cast<int>(dst)).distance;
+    });
+    REQUIRE(distances == AllDistances(g, n, 0));
+  }
+}
@@ -0,0 +1,67 @@
+#include "assignments/dg/random_walk.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+gdwg::detail::WalkRng::WalkRng(std::uint64_t seed, std::uint64_t stream)
+  : state_{seed ^ (stream * 0xD1B54A32D192ED03ULL)} {
+  /* mix once so that neighbouring streams don't start out alike */
+  Next();
+}
+
+std::uint64_t gdwg::detail::WalkRng::Next() {
+  auto z = (state_ += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+std::uint32_t gdwg::detail::WalkRng::Below(std::uint32_t n) {
+  /* Lemire's multiply and shift: the bias is at most n / 2^32, which is far
+   * below anything a walk could notice */
+  return static_cast<std::uint32_t>(((Next() >> 32) * n) >> 32);
+}
+
+double gdwg::detail::WalkRng::Unit() {
+  return static_cast<double>(Next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void gdwg::detail::BuildAliasTable(const double* weights,
+                                   std::size_t n,
+                                   double* prob,
+                                   std::uint32_t* alias) {
+  double total = 0.0;
+  for (std::size_t i = 0; i < n; ++i) {
+    total += weights[i];
+  }
+  /* scaled so the average is 1: below 1 is small, and gets topped up by a large */
+  std::vector<double> scaled(n);
+  std::vector<std::uint32_t> small{};
+  std::vector<std::uint32_t> large{};
+  for (std::size_t i = 0; i < n; ++i) {
+    scaled[i] = total > 0 ? weights[i] * static_cast<double>(n) / total : 1.0;
+    (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+  }
+  while (!small.empty() && !large.empty()) {
+    const auto s = small.back();
+    const auto l = large.back();
+    small.pop_back();
+    prob[s] = scaled[s];
+    alias[s] = l;
+    scaled[l] -= 1.0 - scaled[s];
+    if (scaled[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  /* whatever is left is 1 up to rounding */
+  for (const auto i : large) {
+    prob[i] = 1.0;
+    alias[i] = i;
+  }
+  for (const auto i : small) {
+    prob[i] = 1.0;
+    alias[i] = i;
+  }
+}
@@ -0,0 +1,109 @@
+#ifndef ASSIGNMENTS_DG_RANDOM_WALK_H_
+#define ASSIGNMENTS_DG_RANDOM_WALK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+
+namespace gdwg {
+
+/* what Walk generates. Every node starts walks_per_node walks, each following up
+ * to walk_length - 1 outgoing edges (so visiting up to walk_length nodes), and
+ * stopping early at a node with no outgoing edges */
+struct WalkOptions {
+  std::size_t walk_length{80};
+  std::size_t walks_per_node{10};
+  /* pick edges in proportion to their weight, rather than all alike */
+  bool weighted{true};
+  /* node2vec's return (p) and in-out (q) parameters: going from t to v, the
+   * next step x has its weight divided by p if x is t, left alone if t has an
+   * edge to x, and divided by q otherwise. With both 1 the walk is first order */
+  double p{1.0};
+  double q{1.0};
+  /* the walks only depend on the seed, not on the pool they run on */
+  std::uint64_t seed{6771};
+};
+
+namespace detail {
+
+/* a small, fast generator (SplitMix64) with a state per walk, so walks can be
+ * generated on any thread in any order and still come out the same */
+class WalkRng {
+ public:
+  WalkRng(std::uint64_t seed, std::uint64_t stream);
+  std::uint64_t Next();
+  /* uniform in [0, n), n > 0 */
+  std::uint32_t Below(std::uint32_t n);
+  /* uniform in [0, 1) */
+  double Unit();
+
+ private:
+  std::uint64_t state_;
+};
+
+/* Vose's alias method: fills prob[0..n) and alias[0..n) so that picking i
+ * uniformly and keeping it with probability prob[i] (else taking alias[i])
+ * picks each i in proportion to weights[i]. If every weight is 0, every i is
+ * equally likely */
+void BuildAliasTable(const double* weights, std::size_t n, double* prob, std::uint32_t* alias);
+
+}  // namespace detail
+
+/* random walks over a graph's outgoing edges, for building corpora (e.g. for
+ * DeepWalk or node2vec embeddings). Building one precomputes an alias table per
+ * node over its outgoing edges' weights, in parallel, after which each weighted
+ * step costs O(1). Walks are numbered walk = round * NumNodes() + start for
+ * round in [0, walks_per_node), and generated in parallel, each handed to the
+ * sink as soon as it is finished rather than stored */
+template <typename N, typename E>
+class RandomWalker {
+ public:
+  using node_id = std::uint32_t;
+
+  /* ctors. Throw std::domain_error if any weight is negative */
+  explicit RandomWalker(CsrSnapshot<N, E> g, ThreadPool& pool = ThreadPool::Default());
+  explicit RandomWalker(const Graph<N, E>& g, ThreadPool& pool = ThreadPool::Default())
+    : RandomWalker(CsrSnapshot<N, E>{g}, pool) {}
+
+  /* methods */
+  /* the snapshot the walks' ids are into */
+  const CsrSnapshot<N, E>& Snapshot() const { return g_; }
+
+  /* generates every walk, calling sink(walk, path) with each walk's number and
+   * its nodes as snapshot ids. path is only valid during the call, and sink is
+   * called from several threads at once, so it must be safe to do that.
+   * node2vec walks (p or q not 1) use rejection sampling: a candidate from the
+   * first order alias table is kept with probability its bias over the largest
+   * bias, so steps stay cheap whatever the degree. Throws std::invalid_argument
+   * if p or q isn't positive, or walk_length is 0 */
+  template <typename Sink>
+  void Walk(const WalkOptions& options, Sink sink, ThreadPool& pool = ThreadPool::Default()) const;
+
+ private:
+  /* the next node after cur (reached from prev, unless it is the first step),
+   * or NumNodes() if cur has no outgoing edges */
+  node_id Step(const WalkOptions& options,
+               node_id prev,
+               node_id cur,
+               bool first,
+               detail::WalkRng& rng) const;
+  /* one first order step: the edge index taken out of v */
+  std::size_t PickEdge(bool weighted, node_id v, detail::WalkRng& rng) const;
+  bool HasEdge(node_id from, node_id to) const;
+
+  CsrSnapshot<N, E> g_;
+  /* the alias table of node v's edges is prob_/alias_ over v's edge indexes,
+   * with alias_ holding offsets within v's edges */
+  std::vector<double> prob_;
+  std::vector<std::uint32_t> alias_;
+};
+
+}  // namespace gdwg
+
+#include "assignments/dg/random_walk.tpp"
+
+#endif  // ASSIGNMENTS_DG_RANDOM_WALK_H_
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename N, typename E>
+gdwg::RandomWalker<N, E>::RandomWalker(CsrSnapshot<N, E> g, ThreadPool& pool) : g_{std::move(g)} {
+  static_assert(std::is_arithmetic<E>::value, "random walks need numeric weights");
+  const auto& weights = g_.Weights();
+  if (std::any_of(weights.begin(), weights.end(), [](const E& w) { return w < E{}; })) {
+    throw std::domain_error("Cannot call RandomWalker on a graph with negative weights");
+  }
+  prob_.resize(g_.NumEdges());
+  alias_.resize(g_.NumEdges());
+  const auto n = g_.NumNodes();
+  const auto num_chunks = std::min(n, 16 * (pool.Size() + 1));
+  pool.ParallelFor(num_chunks, [&](std::size_t chunk) {
+    std::vector<double> node_weights{};
+    for (auto v = n * chunk / num_chunks; v < n * (chunk + 1) / num_chunks; ++v) {
+      const auto first = g_.Offsets()[v];
+      const auto last = g_.Offsets()[v + 1];
+      node_weights.assign(weights.begin() + static_cast<std::ptrdiff_t>(first),
+                          weights.begin() + static_cast<std::ptrdiff_t>(last));
+      detail::BuildAliasTable(node_weights.data(), node_weights.size(), prob_.data() + first,
+                              alias_.data() + first);
+    }
+  });
+}
+
+template <typename N, typename E>
+template <typename Sink>
+void gdwg::RandomWalker<N, E>::Walk(const WalkOptions& options,
+                                    Sink sink,
+                                    ThreadPool& pool) const {
+  if (!(options.p > 0) || !(options.q > 0)) {
+    throw std::invalid_argument("Cannot call RandomWalker::Walk with a p or q that isn't positive");
+  }
+  if (options.walk_length == 0) {
+    throw std::invalid_argument("Cannot call RandomWalker::Walk with a walk_length of 0");
+  }
+  const auto n = g_.NumNodes();
+  const auto num_walks = n * options.walks_per_node;
+  const auto num_chunks = std::min(num_walks, 16 * (pool.Size() + 1));
+  pool.ParallelFor(num_chunks, [&](std::size_t chunk) {
+    /* one path buffer per chunk, reused by every walk in it */
+    std::vector<node_id> path{};
+    path.reserve(options.walk_length);
+    for (auto walk = num_walks * chunk / num_chunks; walk < num_walks * (chunk + 1) / num_chunks;
+         ++walk) {
+      detail::WalkRng rng{options.seed, walk};
+      path.clear();
+      path.push_back(static_cast<node_id>(walk % n));
+      while (path.size() < options.walk_length) {
+        const auto prev = path.size() > 1 ? path[path.size() - 2] : path.back();
+        const auto next = Step(options, prev, path.back(), path.size() == 1, rng);
+        if (next == n)
+          break;
+        path.push_back(next);
+      }
+      sink(walk, static_cast<const std::vector<node_id>&>(path));
+    }
+  });
+}
+
+template <typename N, typename E>
+typename gdwg::RandomWalker<N, E>::node_id
+gdwg::RandomWalker<N, E>::Step(const WalkOptions& options,
+                               node_id prev,
+                               node_id cur,
+                               bool first,
+                               detail::WalkRng& rng) const {
+  if (g_.Degree(cur) == 0)
+    return static_cast<node_id>(g_.NumNodes());
+  if (first || (options.p == 1.0 && options.q == 1.0))
+    return g_.Targets()[PickEdge(options.weighted, cur, rng)];
+  /* keep a first order candidate x with probability bias(x) / max_bias */
+  const auto max_bias = std::max({1.0, 1.0 / options.p, 1.0 / options.q});
+  while (true) {
+    const auto x = g_.Targets()[PickEdge(options.weighted, cur, rng)];
+    double bias;
+    if (x == prev) {
+      bias = 1.0 / options.p;
+    } else if (HasEdge(prev, x)) {
+      bias = 1.0;
+    } else {
+      bias = 1.0 / options.q;
+    }
+    if (rng.Unit() * max_bias < bias)
+      return x;
+  }
+}
+
+template <typename N, typename E>
+std::size_t
+gdwg::RandomWalker<N, E>::PickEdge(bool weighted, node_id v, detail::WalkRng& rng) const {
+  const auto first = g_.Offsets()[v];
+  const auto i = rng.Below(static_cast<std::uint32_t>(g_.Degree(v)));
+  if (!weighted)
+    return first + i;
+  return first + (rng.Unit() < prob_[first + i] ? i : alias_[first + i]);
+}
+
+template <typename N, typename E>
+bool gdwg::RandomWalker<N, E>::HasEdge(node_id from, node_id to) const {
+  /* a node's targets are sorted */
+  const auto first = g_.Targets().begin() + static_cast<std::ptrdiff_t>(g_.Offsets()[from]);
+  const auto last = g_.Targets().begin() + static_cast<std::ptrdiff_t>(g_.Offsets()[from + 1]);
+  return std::binary_search(first, last, to);
+}
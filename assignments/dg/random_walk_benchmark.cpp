@@ -0,0 +1,85 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/random_walk.h"
+
+/* steps per second of random walks over a random graph. The baseline walks
+ * straight over the Graph, calling GetConnected and GetWeights and building a
+ * std::discrete_distribution at every step (and only walks once from every 20th
+ * node, as it is so slow). RandomWalker then runs every walk, uniform,
+ * weighted and node2vec, streaming them to a sink that only counts visits.
+ * usage: random_walk_benchmark [num_nodes (default 100000)] [num_edges (default 1000000)]
+ *                              [walk_length (default 40)] [walks_per_node (default 10)] */
+int main(int argc, char** argv) {
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 1, 100000);
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 2, 1000000);
+  const auto walk_length = gdwg::benchmark::Arg(argc, argv, 3, 40);
+  const auto walks_per_node = gdwg::benchmark::Arg(argc, argv, 4, 10);
+  const auto edges = gdwg::benchmark::RandomEdges(num_nodes, num_edges);
+  const gdwg::Graph<int, int> g{edges.cbegin(), edges.cend()};
+  gdwg::benchmark::JsonResults json{};
+
+  const auto nodes = g.GetNodes();
+  std::mt19937 rng{6771};
+  std::size_t baseline_steps = 0;
+  gdwg::benchmark::Stopwatch baseline_timer{};
+  for (std::size_t s = 0; s < nodes.size(); s += 20) {
+    auto cur = nodes[s];
+    for (std::size_t i = 1; i < walk_length; ++i) {
+      std::vector<int> targets{};
+      std::vector<double> weights{};
+      for (const auto dst : g.GetConnected(cur)) {
+        for (const auto w : g.GetWeights(cur, dst)) {
+          targets.push_back(dst);
+          weights.push_back(w);
+        }
+      }
+      if (targets.empty())
+        break;
+      cur = targets[std::discrete_distribution<std::size_t>{weights.begin(), weights.end()}(rng)];
+      ++baseline_steps;
+    }
+  }
+  const auto baseline_seconds = baseline_timer.Seconds();
+  gdwg::benchmark::Report("Graph lookups + discrete_distribution", baseline_steps,
+                          baseline_seconds);
+  json.Add("baseline", {}, baseline_steps, baseline_seconds);
+
+  gdwg::benchmark::Stopwatch build_timer{};
+  const gdwg::RandomWalker<int, int> walker{g};
+  gdwg::benchmark::Report("RandomWalker (snapshot + alias tables)", walker.Snapshot().NumEdges(),
+                          build_timer.Seconds());
+
+  auto run = [&](const std::string& name, gdwg::WalkOptions options) {
+    options.walk_length = walk_length;
+    options.walks_per_node = walks_per_node;
+    std::vector<std::atomic<std::uint32_t>> visits(num_nodes);
+    std::atomic<std::size_t> steps{0};
+    gdwg::benchmark::Stopwatch timer{};
+    walker.Walk(options, [&](std::size_t, const std::vector<std::uint32_t>& path) {
+      for (const auto v : path) {
+        visits[v].fetch_add(1, std::memory_order_relaxed);
+      }
+      steps.fetch_add(path.size() - 1, std::memory_order_relaxed);
+    });
+    const auto seconds = timer.Seconds();
+    gdwg::benchmark::Report(name, steps.load(), seconds);
+    json.Add(name, {}, steps.load(), seconds);
+  };
+  gdwg::WalkOptions uniform{};
+  uniform.weighted = false;
+  run("uniform", uniform);
+  run("weighted", gdwg::WalkOptions{});
+  gdwg::WalkOptions node2vec{};
+  node2vec.p = 0.5;
+  node2vec.q = 2;
+  run("node2vec (p 0.5, q 2)", node2vec);
+  json.Write(std::cout);
+}
@@ -0,0 +1,202 @@
+#include "assignments/dg/random_walk.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+#include "catch.h"
+
+namespace {
+
+/* every walk, by number */
+template <typename N, typename E>
+std::vector<std::vector<std::uint32_t>> AllWalks(const gdwg::RandomWalker<N, E>& walker,
+                                                 const gdwg::WalkOptions& options,
+                                                 gdwg::ThreadPool& pool) {
+  std::vector<std::vector<std::uint32_t>> walks(walker.Snapshot().NumNodes() *
+                                                options.walks_per_node);
+  std::mutex mutex{};
+  walker.Walk(
+      options,
+      [&](std::size_t walk, const std::vector<std::uint32_t>& path) {
+        std::lock_guard<std::mutex> lock{mutex};
+        walks[walk] = path;
+      },
+      pool);
+  return walks;
+}
+
+}  // namespace
+
+SCENARIO("BuildAliasTable") {
+  GIVEN("weights of very different sizes, including 0") {
+    const std::vector<double> weights{1, 0, 6, 2, 0.5, 0.5};
+    std::vector<double> prob(weights.size());
+    std::vector<std::uint32_t> alias(weights.size());
+    gdwg::detail::BuildAliasTable(weights.data(), weights.size(), prob.data(), alias.data());
+    THEN("each index ends up with exactly its share of the probability") {
+      std::vector<double> share(weights.size(), 0.0);
+      for (std::size_t i = 0; i < weights.size(); ++i) {
+        share[i] += prob[i] / 6;
+        share[alias[i]] += (1 - prob[i]) / 6;
+      }
+      for (std::size_t i = 0; i < weights.size(); ++i) {
+        REQUIRE(share[i] == Approx(weights[i] / 10));
+      }
+    }
+    THEN("sampling follows the weights") {
+      gdwg::detail::WalkRng rng{1, 2};
+      std::vector<std::size_t> counts(weights.size(), 0);
+      for (int i = 0; i < 100000; ++i) {
+        const auto j = rng.Below(6);
+        ++counts[rng.Unit() < prob[j] ? j : alias[j]];
+      }
+      REQUIRE(counts[1] == 0);
+      REQUIRE(counts[2] == Approx(60000).epsilon(0.02));
+      REQUIRE(counts[4] == Approx(5000).epsilon(0.05));
+    }
+  }
+  GIVEN("only zero weights") {
+    std::vector<double> prob(3);
+    std::vector<std::uint32_t> alias(3);
+    const std::vector<double> weights{0, 0, 0};
+    gdwg::detail::BuildAliasTable(weights.data(), 3, prob.data(), alias.data());
+    THEN("they are all equally likely") { REQUIRE(prob == std::vector<double>{1, 1, 1}); }
+  }
+}
+
+SCENARIO("RandomWalker") {
+  GIVEN("a graph with a dead end") {
+    std::vector<std::tuple<std::string, std::string, int>> edges{
+        {"a", "b", 1}, {"b", "a", 1}, {"b", "c", 1}, {"c", "a", 2}, {"c", "d", 1}};
+    gdwg::Graph<std::string, int> g{edges.cbegin(), edges.cend()};
+    gdwg::RandomWalker<std::string, int> walker{g};
+    gdwg::WalkOptions options{};
+    options.walk_length = 12;
+    options.walks_per_node = 5;
+    gdwg::ThreadPool pool{3};
+    const auto walks = AllWalks(walker, options, pool);
+    THEN("every walk starts at its node, follows edges, and stops only at the dead end") {
+      const auto& csr = walker.Snapshot();
+      for (std::size_t walk = 0; walk < walks.size(); ++walk) {
+        const auto& path = walks[walk];
+        REQUIRE(!path.empty());
+        REQUIRE(path.front() == walk % 4);
+        for (std::size_t i = 1; i < path.size(); ++i) {
+          REQUIRE(g.IsConnected(csr.Value(path[i - 1]), csr.Value(path[i])));
+        }
+        REQUIRE((path.size() == 12 || csr.Value(path.back()) == "d"));
+      }
+      REQUIRE(walks[3] == std::vector<std::uint32_t>{3});
+    }
+    THEN("the walks only depend on the seed, not on the pool") {
+      gdwg::ThreadPool single{0};
+      REQUIRE(AllWalks(walker, options, single) == walks);
+      options.seed = 7;
+      REQUIRE(AllWalks(walker, options, single) != walks);
+    }
+    THEN("bad options are rejected") {
+      auto ignore = [](std::size_t, const std::vector<std::uint32_t>&) {};
+      options.q = 0;
+      REQUIRE_THROWS_AS(walker.Walk(options, ignore), std::invalid_argument);
+      options.q = 1;
+      options.walk_length = 0;
+      REQUIRE_THROWS_AS(walker.Walk(options, ignore), std::invalid_argument);
+    }
+  }
+
+  GIVEN("a hub with a light edge and a heavy edge") {
+    std::vector<std::tuple<char, char, double>> edges{
+        {'h', 'l', 1}, {'h', 'x', 9}, {'l', 'h', 1}, {'x', 'h', 1}};
+    gdwg::Graph<char, double> g{edges.cbegin(), edges.cend()};
+    gdwg::RandomWalker<char, double> walker{g};
+    gdwg::WalkOptions options{};
+    options.walk_length = 101;
+    options.walks_per_node = 20;
+    auto heavy_share = [&walker, &options] {
+      std::mutex mutex{};
+      std::size_t light = 0;
+      std::size_t heavy = 0;
+      walker.Walk(options, [&](std::size_t, const std::vector<std::uint32_t>& path) {
+        std::lock_guard<std::mutex> lock{mutex};
+        for (std::size_t i = 1; i < path.size(); ++i) {
+          if (path[i - 1] == 0) {
+            light += path[i] == 1;
+            heavy += path[i] == 2;
+          }
+        }
+      });
+      return static_cast<double>(heavy) / static_cast<double>(light + heavy);
+    };
+    THEN("weighted walks take the heavy edge 9 times in 10") {
+      REQUIRE(heavy_share() == Approx(0.9).epsilon(0.03));
+    }
+    THEN("uniform walks take each half the time") {
+      options.weighted = false;
+      REQUIRE(heavy_share() == Approx(0.5).epsilon(0.05));
+    }
+  }
+
+  GIVEN("a path a - b - c, with b also on a triangle b - d - e") {
+    std::vector<std::tuple<char, char, int>> edges{};
+    for (auto [u, v] : {std::pair{'a', 'b'}, {'b', 'c'}, {'b', 'd'}, {'b', 'e'}, {'d', 'e'}}) {
+      edges.emplace_back(u, v, 1);
+      edges.emplace_back(v, u, 1);
+    }
+    gdwg::Graph<char, int> g{edges.cbegin(), edges.cend()};
+    gdwg::RandomWalker<char, int> walker{g};
+    gdwg::WalkOptions options{};
+    options.walk_length = 3;
+    options.walks_per_node = 20000;
+    /* how often walks starting a -> b then go back to a, and on to d */
+    auto after_ab = [&walker, &options] {
+      std::mutex mutex{};
+      std::vector<double> counts(5, 0.0);
+      double total = 0;
+      walker.Walk(options, [&](std::size_t, const std::vector<std::uint32_t>& path) {
+        if (path.size() == 3 && path[0] == 0 && path[1] == 1) {
+          std::lock_guard<std::mutex> lock{mutex};
+          ++counts[path[2]];
+          ++total;
+        }
+      });
+      for (auto& count : counts) {
+        count /= total;
+      }
+      return counts;
+    };
+    THEN("a first order walk picks each of b's 4 neighbours alike") {
+      const auto share = after_ab();
+      REQUIRE(share[0] == Approx(0.25).epsilon(0.05));
+      REQUIRE(share[3] == Approx(0.25).epsilon(0.05));
+    }
+    THEN("a small p makes going back likely") {
+      options.p = 0.1;
+      /* weights: back 10, and 1 for each of c, d, e */
+      REQUIRE(after_ab()[0] == Approx(10.0 / 13).epsilon(0.03));
+    }
+    THEN("a large q keeps walks near where they came from") {
+      options.q = 4;
+      options.p = 2;
+      /* weights: back 1/2, and 1/4 for each of c, d, e, none of which a reaches */
+      REQUIRE(after_ab()[0] == Approx(0.4).epsilon(0.05));
+      REQUIRE(after_ab()[2] == Approx(0.2).epsilon(0.05));
+    }
+  }
+
+  GIVEN("a negative weight") {
+    gdwg::Graph<char, int> g{'a', 'b'};
+    g.InsertEdge('a', 'b', -1);
+    THEN("the walker can't be built") {
+      using Walker = gdwg::RandomWalker<char, int>;
+      REQUIRE_THROWS_AS(Walker{g}, std::domain_error);
+    }
+  }
+}
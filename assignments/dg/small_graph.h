@@ -0,0 +1,196 @@
+#ifndef ASSIGNMENTS_DG_SMALL_GRAPH_H_
+#define ASSIGNMENTS_DG_SMALL_GRAPH_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+
+namespace gdwg {
+
+/* a Graph for when there are lots of tiny ones. Up to NodeCapacity nodes and
+ * EdgeCapacity edges live inline, in sorted arrays inside the object: nodes by
+ * value, and edges as (src index, dst index, weight), which sorts the same as
+ * (src, dst, weight) because node indexes follow node order. Making, filling and
+ * destroying one doesn't touch the heap unless N or E do. The first insert that
+ * doesn't fit moves everything into a real Graph (it spills), and from then on
+ * every call goes straight to that, until Clear makes it small again.
+ *
+ * Every method and operator here (the original Graph interface: edits, queries,
+ * find and erase, iterators, ==, !=, <<) means, and throws, exactly what it does
+ * on Graph, in either mode, so one can stand in for the other where only those
+ * are used. Graph's later additions (degrees, views, transactions and so on)
+ * aren't here. N and E must be default constructible, since the
+ * unused array slots hold default values */
+template <typename N, typename E, std::size_t NodeCapacity = 16, std::size_t EdgeCapacity = 32>
+class SmallGraph {
+  static_assert(NodeCapacity > 0 && NodeCapacity < 256, "node indexes have to fit a byte");
+
+ public:
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::tuple<N, N, E>;
+    using reference = std::tuple<const N&, const N&, const E&>;
+    using pointer = void;
+    using difference_type = int;
+
+    const_iterator() = default;
+
+    reference operator*() const;
+    const_iterator& operator++() {
+      if (Spilled())
+        ++spilled_it_;
+      else
+        ++i_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      auto copy{*this};
+      ++(*this);
+      return copy;
+    }
+    const_iterator& operator--() {
+      if (Spilled())
+        --spilled_it_;
+      else
+        --i_;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      auto copy{*this};
+      --(*this);
+      return copy;
+    }
+
+    /* iterators into the same graph are both in whichever mode it is in */
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+      return lhs.Spilled() ? lhs.spilled_it_ == rhs.spilled_it_ : lhs.i_ == rhs.i_;
+    }
+    friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    bool Spilled() const { return g_ != nullptr && g_->spilled_; }
+
+    const SmallGraph* g_{nullptr};
+    std::size_t i_{0};
+    typename Graph<N, E>::const_iterator spilled_it_;
+
+    friend class SmallGraph;
+    const_iterator(const SmallGraph* g, std::size_t i, typename Graph<N, E>::const_iterator it)
+      : g_{g}, i_{i}, spilled_it_{it} {}
+  };
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /* ctors and dtor */
+  SmallGraph() = default;
+  SmallGraph(const SmallGraph& orig);
+  /* like Graph, moving leaves recyclee empty */
+  SmallGraph(SmallGraph&& recyclee);
+  ~SmallGraph() = default;
+
+  /* operators */
+  SmallGraph& operator=(const SmallGraph& other);
+  SmallGraph& operator=(SmallGraph&& recyclee);
+
+  /* methods */
+  bool InsertNode(const N& val);
+  bool InsertEdge(const N& src, const N& dst, const E& w);
+  bool DeleteNode(const N& deletee);
+  bool Replace(const N& old_data, const N& new_data);
+  void MergeReplace(const N& replacee, const N& replacer);
+  void Clear();
+  bool IsNode(const N& val) const;
+  bool IsConnected(const N& src, const N& dst) const;
+  std::vector<N> GetNodes() const;
+  std::vector<N> GetConnected(const N& src) const;
+  std::vector<E> GetWeights(const N& src, const N& dst) const;
+  const_iterator find(const N& src, const N& dst, const E& w) const;
+  bool erase(const N& src, const N& dst, const E& w);
+  const_iterator erase(const_iterator it);
+
+  /* false once it has spilled into a Graph */
+  bool IsInline() const { return !spilled_; }
+  /* a Graph with the same nodes and edges */
+  Graph<N, E> ToGraph() const;
+
+  /* iterator methods */
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+  const_reverse_iterator crbegin() const { return const_reverse_iterator{cend()}; }
+  const_reverse_iterator crend() const { return const_reverse_iterator{cbegin()}; }
+  const_reverse_iterator rbegin() const { return crbegin(); }
+  const_reverse_iterator rend() const { return crend(); }
+
+  /* friend methods */
+  /* either side may have spilled, so unless both have this goes through the
+   * same nodes and edges Graph would compare */
+  friend bool operator==(const SmallGraph& lhs, const SmallGraph& rhs) {
+    if (lhs.spilled_ && rhs.spilled_)
+      return *lhs.spilled_ == *rhs.spilled_;
+    return lhs.GetNodes() == rhs.GetNodes() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+  friend bool operator!=(const SmallGraph& lhs, const SmallGraph& rhs) { return !(lhs == rhs); }
+  /* prints just what Graph's operator<< does */
+  friend std::ostream& operator<<(std::ostream& os, const SmallGraph& g) {
+    if (g.spilled_)
+      return os << *g.spilled_;
+    /* edges are in src order, so each node's are the next ones along */
+    std::size_t e = 0;
+    for (std::size_t i = 0; i < g.num_nodes_; ++i) {
+      os << g.nodes_[i] << " (\n";
+      for (; e < g.num_edges_ && g.edges_[e].src == i; ++e) {
+        os << "  " << g.nodes_[g.edges_[e].dst] << " | " << g.edges_[e].weight << "\n";
+      }
+      os << ")\n";
+    }
+    return os;
+  }
+
+ private:
+  struct InlineEdge {
+    std::uint8_t src;
+    std::uint8_t dst;
+    E weight;
+  };
+
+  /* the index of val, or num_nodes_ if it isn't a node */
+  std::size_t FindNode(const N& val) const;
+  /* the first edge not ordered before (src, dst), or (src, dst, w) */
+  std::size_t LowerBound(std::size_t src, std::size_t dst) const;
+  std::size_t LowerBound(std::size_t src, std::size_t dst, const E& w) const;
+  /* removes edge i, or node i and every edge touching it */
+  void RemoveEdgeAt(std::size_t i);
+  void RemoveNodeAt(std::size_t i);
+  /* gives node i a new value (that isn't a node yet), moving it into place */
+  void Rename(std::size_t i, const N& new_data);
+  /* after node indexes change, puts the edges back in order and drops any that
+   * have become the same edge */
+  void SortEdges();
+  /* moves everything into spilled_ */
+  void Spill();
+
+  std::unique_ptr<Graph<N, E>> spilled_;
+  std::uint8_t num_nodes_{0};
+  std::size_t num_edges_{0};
+  std::array<N, NodeCapacity> nodes_{};
+  std::array<InlineEdge, EdgeCapacity> edges_{};
+};
+
+}  // namespace gdwg
+
+#include "assignments/dg/small_graph.tpp"
+
+#endif  // ASSIGNMENTS_DG_SMALL_GRAPH_H_
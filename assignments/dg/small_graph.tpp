@@ -0,0 +1,401 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+gdwg::SmallGraph<N, E, NC, EC>::SmallGraph(const SmallGraph& orig)
+  : spilled_{orig.spilled_ ? std::make_unique<Graph<N, E>>(*orig.spilled_) : nullptr},
+    num_nodes_{orig.num_nodes_}, num_edges_{orig.num_edges_}, nodes_{orig.nodes_},
+    edges_{orig.edges_} {}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+gdwg::SmallGraph<N, E, NC, EC>::SmallGraph(SmallGraph&& recyclee)
+  : spilled_{std::move(recyclee.spilled_)}, num_nodes_{recyclee.num_nodes_},
+    num_edges_{recyclee.num_edges_}, nodes_{std::move(recyclee.nodes_)},
+    edges_{std::move(recyclee.edges_)} {
+  recyclee.num_nodes_ = 0;
+  recyclee.num_edges_ = 0;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+gdwg::SmallGraph<N, E, NC, EC>& gdwg::SmallGraph<N, E, NC, EC>::operator=(const SmallGraph& other) {
+  if (this != &other) {
+    auto copy{other};
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+gdwg::SmallGraph<N, E, NC, EC>& gdwg::SmallGraph<N, E, NC, EC>::operator=(
+    SmallGraph&& recyclee) {
+  if (this != &recyclee) {
+    spilled_ = std::move(recyclee.spilled_);
+    num_nodes_ = recyclee.num_nodes_;
+    num_edges_ = recyclee.num_edges_;
+    nodes_ = std::move(recyclee.nodes_);
+    edges_ = std::move(recyclee.edges_);
+    recyclee.num_nodes_ = 0;
+    recyclee.num_edges_ = 0;
+  }
+  return *this;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+bool gdwg::SmallGraph<N, E, NC, EC>::InsertNode(const N& val) {
+  if (spilled_)
+    return spilled_->InsertNode(val);
+  const auto i = static_cast<std::size_t>(
+      std::lower_bound(nodes_.begin(), nodes_.begin() + num_nodes_, val) - nodes_.begin());
+  if (i < num_nodes_ && !(val < nodes_[i]))
+    return false;
+  if (num_nodes_ == NC) {
+    Spill();
+    return spilled_->InsertNode(val);
+  }
+  std::move_backward(nodes_.begin() + static_cast<std::ptrdiff_t>(i),
+                     nodes_.begin() + num_nodes_, nodes_.begin() + num_nodes_ + 1);
+  nodes_[i] = val;
+  ++num_nodes_;
+  /* every node from i up moved along one, and the edges still sort the same */
+  for (std::size_t e = 0; e < num_edges_; ++e) {
+    edges_[e].src += edges_[e].src >= i;
+    edges_[e].dst += edges_[e].dst >= i;
+  }
+  return true;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+bool gdwg::SmallGraph<N, E, NC, EC>::InsertEdge(const N& src, const N& dst, const E& w) {
+  if (spilled_)
+    return spilled_->InsertEdge(src, dst, w);
+  const auto s = FindNode(src);
+  const auto d = FindNode(dst);
+  if (s == num_nodes_ || d == num_nodes_) {
+    throw std::runtime_error(
+        "Cannot call Graph::InsertEdge when either src or dst node does not exist");
+  }
+  const auto i = LowerBound(s, d, w);
+  if (i < num_edges_ && edges_[i].src == s && edges_[i].dst == d && !(w < edges_[i].weight))
+    return false;
+  if (num_edges_ == EC) {
+    Spill();
+    return spilled_->InsertEdge(src, dst, w);
+  }
+  std::move_backward(edges_.begin() + static_cast<std::ptrdiff_t>(i),
+                     edges_.begin() + static_cast<std::ptrdiff_t>(num_edges_),
+                     edges_.begin() + static_cast<std::ptrdiff_t>(num_edges_ + 1));
+  edges_[i] = {static_cast<std::uint8_t>(s), static_cast<std::uint8_t>(d), w};
+  ++num_edges_;
+  return true;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+bool gdwg::SmallGraph<N, E, NC, EC>::DeleteNode(const N& deletee) {
+  if (spilled_)
+    return spilled_->DeleteNode(deletee);
+  const auto i = FindNode(deletee);
+  if (i == num_nodes_)
+    return false;
+  RemoveNodeAt(i);
+  return true;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+bool gdwg::SmallGraph<N, E, NC, EC>::Replace(const N& old_data, const N& new_data) {
+  if (spilled_)
+    return spilled_->Replace(old_data, new_data);
+  const auto i = FindNode(old_data);
+  if (i == num_nodes_) {
+    throw std::runtime_error("Cannot call Graph::Replace on a node that doesn't exist");
+  }
+  if (IsNode(new_data))
+    return false;
+  Rename(i, new_data);
+  return true;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+void gdwg::SmallGraph<N, E, NC, EC>::MergeReplace(const N& replacee, const N& replacer) {
+  if (spilled_) {
+    spilled_->MergeReplace(replacee, replacer);
+    return;
+  }
+  auto a = FindNode(replacee);
+  const auto b = FindNode(replacer);
+  if (a == num_nodes_ || b == num_nodes_) {
+    throw std::runtime_error(
+        "Cannot call Graph::MergeReplace on old or new data if they don't exist in the graph");
+  }
+  if (a == b) {
+    /* Graph deletes the node, fails to rename it and undoes the delete */
+    throw std::runtime_error("Cannot call Graph::Replace on a node that doesn't exist");
+  }
+  /* replacer's edges move over to replacee, replacer goes, and replacee takes
+   * its name */
+  for (std::size_t e = 0; e < num_edges_; ++e) {
+    if (edges_[e].src == b)
+      edges_[e].src = static_cast<std::uint8_t>(a);
+    if (edges_[e].dst == b)
+      edges_[e].dst = static_cast<std::uint8_t>(a);
+  }
+  SortEdges();
+  RemoveNodeAt(b);
+  a -= b < a;
+  Rename(a, replacer);
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+void gdwg::SmallGraph<N, E, NC, EC>::Clear() {
+  spilled_.reset();
+  /* give back anything the old values were holding on to */
+  std::fill(nodes_.begin(), nodes_.begin() + num_nodes_, N{});
+  std::fill(edges_.begin(), edges_.begin() + static_cast<std::ptrdiff_t>(num_edges_),
+            InlineEdge{});
+  num_nodes_ = 0;
+  num_edges_ = 0;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+bool gdwg::SmallGraph<N, E, NC, EC>::IsNode(const N& val) const {
+  if (spilled_)
+    return spilled_->IsNode(val);
+  return FindNode(val) != num_nodes_;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+bool gdwg::SmallGraph<N, E, NC, EC>::IsConnected(const N& src, const N& dst) const {
+  if (spilled_)
+    return spilled_->IsConnected(src, dst);
+  const auto s = FindNode(src);
+  const auto d = FindNode(dst);
+  if (s == num_nodes_ || d == num_nodes_) {
+    throw std::runtime_error(
+        "Cannot call Graph::IsConnected if src or dst node don't exist in the graph");
+  }
+  const auto i = LowerBound(s, d);
+  return i < num_edges_ && edges_[i].src == s && edges_[i].dst == d;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+std::vector<N> gdwg::SmallGraph<N, E, NC, EC>::GetNodes() const {
+  if (spilled_)
+    return spilled_->GetNodes();
+  return {nodes_.begin(), nodes_.begin() + num_nodes_};
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+std::vector<N> gdwg::SmallGraph<N, E, NC, EC>::GetConnected(const N& src) const {
+  if (spilled_)
+    return spilled_->GetConnected(src);
+  const auto s = FindNode(src);
+  if (s == num_nodes_) {
+    throw std::out_of_range("Cannot call Graph::GetConnected if src doesn't exist in the graph");
+  }
+  /* src's edges are together and ordered by dst, so parallel ones are neighbours */
+  std::vector<N> connected{};
+  for (auto i = LowerBound(s, 0); i < num_edges_ && edges_[i].src == s; ++i) {
+    if (connected.empty() || connected.back() != nodes_[edges_[i].dst])
+      connected.push_back(nodes_[edges_[i].dst]);
+  }
+  return connected;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+std::vector<E> gdwg::SmallGraph<N, E, NC, EC>::GetWeights(const N& src, const N& dst) const {
+  if (spilled_)
+    return spilled_->GetWeights(src, dst);
+  const auto s = FindNode(src);
+  const auto d = FindNode(dst);
+  if (s == num_nodes_ || d == num_nodes_) {
+    throw std::out_of_range(
+        "Cannot call Graph::GetWeights if src or dst node don't exist in the graph");
+  }
+  std::vector<E> weights{};
+  for (auto i = LowerBound(s, d); i < num_edges_ && edges_[i].src == s && edges_[i].dst == d; ++i) {
+    weights.push_back(edges_[i].weight);
+  }
+  return weights;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+bool gdwg::SmallGraph<N, E, NC, EC>::erase(const N& src, const N& dst, const E& w) {
+  if (spilled_)
+    return spilled_->erase(src, dst, w);
+  const auto it = find(src, dst, w);
+  if (it == cend())
+    return false;
+  erase(it);
+  return true;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+typename gdwg::SmallGraph<N, E, NC, EC>::const_iterator
+gdwg::SmallGraph<N, E, NC, EC>::find(const N& src, const N& dst, const E& w) const {
+  if (spilled_)
+    return {this, 0, spilled_->find(src, dst, w)};
+  const auto s = FindNode(src);
+  const auto d = FindNode(dst);
+  if (s == num_nodes_ || d == num_nodes_)
+    return cend();
+  const auto i = LowerBound(s, d, w);
+  if (i == num_edges_ || edges_[i].src != s || edges_[i].dst != d || w < edges_[i].weight)
+    return cend();
+  return {this, i, {}};
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+typename gdwg::SmallGraph<N, E, NC, EC>::const_iterator
+gdwg::SmallGraph<N, E, NC, EC>::erase(const_iterator it) {
+  if (spilled_)
+    return {this, 0, spilled_->erase(it.spilled_it_)};
+  if (it == cend())
+    return cend();
+  /* the edges after it move back one, so the next one is now at its index */
+  RemoveEdgeAt(it.i_);
+  return {this, it.i_, {}};
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+gdwg::Graph<N, E> gdwg::SmallGraph<N, E, NC, EC>::ToGraph() const {
+  if (spilled_)
+    return *spilled_;
+  Graph<N, E> g{};
+  for (std::size_t i = 0; i < num_nodes_; ++i) {
+    g.InsertNode(nodes_[i]);
+  }
+  for (std::size_t e = 0; e < num_edges_; ++e) {
+    g.InsertEdge(nodes_[edges_[e].src], nodes_[edges_[e].dst], edges_[e].weight);
+  }
+  return g;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+typename gdwg::SmallGraph<N, E, NC, EC>::const_iterator
+gdwg::SmallGraph<N, E, NC, EC>::cbegin() const {
+  return {this, 0, spilled_ ? spilled_->cbegin() : typename Graph<N, E>::const_iterator{}};
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+typename gdwg::SmallGraph<N, E, NC, EC>::const_iterator
+gdwg::SmallGraph<N, E, NC, EC>::cend() const {
+  return {this, num_edges_, spilled_ ? spilled_->cend() : typename Graph<N, E>::const_iterator{}};
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+typename gdwg::SmallGraph<N, E, NC, EC>::const_iterator::reference
+gdwg::SmallGraph<N, E, NC, EC>::const_iterator::operator*() const {
+  if (g_->spilled_)
+    return *spilled_it_;
+  const auto& edge = g_->edges_[i_];
+  return {g_->nodes_[edge.src], g_->nodes_[edge.dst], edge.weight};
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+std::size_t gdwg::SmallGraph<N, E, NC, EC>::FindNode(const N& val) const {
+  const auto it = std::lower_bound(nodes_.begin(), nodes_.begin() + num_nodes_, val);
+  if (it == nodes_.begin() + num_nodes_ || val < *it)
+    return num_nodes_;
+  return static_cast<std::size_t>(it - nodes_.begin());
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+std::size_t gdwg::SmallGraph<N, E, NC, EC>::LowerBound(std::size_t src, std::size_t dst) const {
+  const auto last = edges_.begin() + static_cast<std::ptrdiff_t>(num_edges_);
+  auto before = [](const InlineEdge& edge, const std::pair<std::size_t, std::size_t>& key) {
+    return std::make_pair<std::size_t, std::size_t>(edge.src, edge.dst) < key;
+  };
+  const auto it = std::lower_bound(edges_.begin(), last, std::make_pair(src, dst), before);
+  return static_cast<std::size_t>(it - edges_.begin());
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+std::size_t
+gdwg::SmallGraph<N, E, NC, EC>::LowerBound(std::size_t src, std::size_t dst, const E& w) const {
+  auto i = LowerBound(src, dst);
+  while (i < num_edges_ && edges_[i].src == src && edges_[i].dst == dst && edges_[i].weight < w)
+    ++i;
+  return i;
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+void gdwg::SmallGraph<N, E, NC, EC>::RemoveEdgeAt(std::size_t i) {
+  std::move(edges_.begin() + static_cast<std::ptrdiff_t>(i + 1),
+            edges_.begin() + static_cast<std::ptrdiff_t>(num_edges_),
+            edges_.begin() + static_cast<std::ptrdiff_t>(i));
+  edges_[--num_edges_] = InlineEdge{};
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+void gdwg::SmallGraph<N, E, NC, EC>::RemoveNodeAt(std::size_t i) {
+  std::size_t kept = 0;
+  for (std::size_t e = 0; e < num_edges_; ++e) {
+    if (edges_[e].src == i || edges_[e].dst == i)
+      continue;
+    if (kept != e)
+      edges_[kept] = std::move(edges_[e]);
+    /* every node after i moves back one */
+    edges_[kept].src -= edges_[kept].src > i;
+    edges_[kept].dst -= edges_[kept].dst > i;
+    ++kept;
+  }
+  std::fill(edges_.begin() + static_cast<std::ptrdiff_t>(kept),
+            edges_.begin() + static_cast<std::ptrdiff_t>(num_edges_), InlineEdge{});
+  num_edges_ = kept;
+  std::move(nodes_.begin() + static_cast<std::ptrdiff_t>(i + 1), nodes_.begin() + num_nodes_,
+            nodes_.begin() + static_cast<std::ptrdiff_t>(i));
+  nodes_[--num_nodes_] = N{};
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+void gdwg::SmallGraph<N, E, NC, EC>::Rename(std::size_t i, const N& new_data) {
+  /* where new_data goes once node i is out of the way */
+  auto j = static_cast<std::size_t>(
+      std::lower_bound(nodes_.begin(), nodes_.begin() + num_nodes_, new_data) - nodes_.begin());
+  j -= j > i;
+  nodes_[i] = new_data;
+  const auto first = nodes_.begin() + static_cast<std::ptrdiff_t>(std::min(i, j));
+  const auto last = nodes_.begin() + static_cast<std::ptrdiff_t>(std::max(i, j) + 1);
+  if (i < j)
+    std::rotate(first, first + 1, last);
+  else
+    std::rotate(first, last - 1, last);
+  /* the nodes between the two ends shift one place towards i */
+  auto remap = [i, j](std::uint8_t& node) {
+    if (node == i)
+      node = static_cast<std::uint8_t>(j);
+    else if (i < j && i < node && node <= j)
+      --node;
+    else if (j < i && j <= node && node < i)
+      ++node;
+  };
+  for (std::size_t e = 0; e < num_edges_; ++e) {
+    remap(edges_[e].src);
+    remap(edges_[e].dst);
+  }
+  SortEdges();
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+void gdwg::SmallGraph<N, E, NC, EC>::SortEdges() {
+  const auto first = edges_.begin();
+  const auto last = edges_.begin() + static_cast<std::ptrdiff_t>(num_edges_);
+  auto key = [](const InlineEdge& edge) { return std::tie(edge.src, edge.dst, edge.weight); };
+  std::sort(first, last, [&key](const auto& a, const auto& b) { return key(a) < key(b); });
+  const auto new_last =
+      std::unique(first, last, [&key](const auto& a, const auto& b) { return key(a) == key(b); });
+  std::fill(new_last, last, InlineEdge{});
+  num_edges_ = static_cast<std::size_t>(new_last - first);
+}
+
+template <typename N, typename E, std::size_t NC, std::size_t EC>
+void gdwg::SmallGraph<N, E, NC, EC>::Spill() {
+  auto g = std::make_unique<Graph<N, E>>(ToGraph());
+  Clear();
+  spilled_ = std::move(g);
+}
@@ -0,0 +1,73 @@
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/small_graph.h"
+
+namespace {
+
+/* makes, fills and destroys num_graphs graphs of type G, each with the nodes and
+ * edges given, and returns a checksum so none of it can be optimised away */
+template <typename G, typename N, typename E>
+std::size_t Churn(std::size_t num_graphs,
+                  const std::vector<N>& nodes,
+                  const std::vector<std::tuple<N, N, E>>& edges) {
+  std::size_t checksum = 0;
+  for (std::size_t i = 0; i < num_graphs; ++i) {
+    G g{};
+    for (const auto& node : nodes) {
+      g.InsertNode(node);
+    }
+    for (const auto& [src, dst, w] : edges) {
+      g.InsertEdge(src, dst, w);
+    }
+    checksum += g.IsConnected(nodes.front(), nodes.back());
+  }
+  return checksum;
+}
+
+template <typename N, typename E>
+void Compare(const std::string& name,
+             std::size_t num_graphs,
+             const std::vector<N>& nodes,
+             const std::vector<std::tuple<N, N, E>>& edges) {
+  gdwg::benchmark::Stopwatch graph_timer{};
+  const auto expected = Churn<gdwg::Graph<N, E>>(num_graphs, nodes, edges);
+  gdwg::benchmark::Report("Graph<" + name + ">", num_graphs, graph_timer.Seconds());
+  gdwg::benchmark::Stopwatch small_timer{};
+  const auto checksum = Churn<gdwg::SmallGraph<N, E>>(num_graphs, nodes, edges);
+  gdwg::benchmark::Report("SmallGraph<" + name + ">", num_graphs, small_timer.Seconds());
+  if (checksum != expected)
+    std::cerr << "checksum mismatch for " << name << "\n";
+}
+
+}  // namespace
+
+/* the cost of making, filling and destroying lots of tiny graphs (8 nodes and 12
+ * edges each): a Graph, which allocates a node for every set element, against a
+ * SmallGraph, which keeps them all inline. Rates are in graphs per second.
+ * usage: small_graph_benchmark [num_graphs (default 1M)] */
+int main(int argc, char** argv) {
+  const auto num_graphs = gdwg::benchmark::Arg(argc, argv, 1, 1000000);
+
+  std::vector<int> int_nodes{};
+  std::vector<std::string> string_nodes{};
+  for (int i = 0; i < 8; ++i) {
+    int_nodes.push_back(i * 7 % 8);
+    string_nodes.push_back("node" + std::to_string(i * 7 % 8));
+  }
+  std::vector<std::tuple<int, int, int>> int_edges{};
+  std::vector<std::tuple<std::string, std::string, double>> string_edges{};
+  for (int i = 0; i < 12; ++i) {
+    const int src = i * 5 % 8;
+    const int dst = (i * 3 + 1) % 8;
+    int_edges.emplace_back(src, dst, i);
+    string_edges.emplace_back("node" + std::to_string(src), "node" + std::to_string(dst), i);
+  }
+  Compare("int, int", num_graphs, int_nodes, int_edges);
+  Compare("std::string, double", num_graphs, string_nodes, string_edges);
+}
@@ -0,0 +1,179 @@
+#include "assignments/dg/small_graph.h"
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+namespace {
+
+template <typename G>
+std::vector<std::tuple<int, int, int>> EdgesOf(const G& g) {
+  return {g.begin(), g.end()};
+}
+
+template <typename G>
+std::string Printed(const G& g) {
+  std::ostringstream os;
+  os << g;
+  return os.str();
+}
+
+/* runs f on both, and requires the same result, or the same exception */
+template <typename Small, typename F>
+void RequireSame(Small& small, gdwg::Graph<int, int>& g, F f) {
+  std::string small_error = "none";
+  std::string graph_error = "none";
+  decltype(f(g)) small_result{};
+  decltype(f(g)) graph_result{};
+  try {
+    small_result = f(small);
+  } catch (const std::exception& e) {
+    small_error = e.what();
+  }
+  try {
+    graph_result = f(g);
+  } catch (const std::exception& e) {
+    graph_error = e.what();
+  }
+  REQUIRE(small_error == graph_error);
+  REQUIRE(small_result == graph_result);
+}
+
+}  // namespace
+
+SCENARIO("SmallGraph behaves like a Graph") {
+  GIVEN("a graph that fits inline") {
+    gdwg::SmallGraph<std::string, double> g{};
+    g.InsertNode("b");
+    g.InsertNode("a");
+    g.InsertNode("c");
+    g.InsertEdge("a", "b", 2);
+    g.InsertEdge("a", "b", 1);
+    g.InsertEdge("c", "a", 3);
+    g.InsertEdge("b", "b", 4);
+    THEN("it answers queries from its arrays") {
+      REQUIRE(g.IsInline());
+      REQUIRE(g.GetNodes() == std::vector<std::string>{"a", "b", "c"});
+      REQUIRE(g.GetWeights("a", "b") == std::vector<double>{1, 2});
+      REQUIRE(g.GetConnected("a") == std::vector<std::string>{"b"});
+      REQUIRE(g.IsConnected("c", "a"));
+      REQUIRE(!g.IsConnected("a", "c"));
+      REQUIRE(!g.InsertEdge("a", "b", 1));
+      REQUIRE(!g.InsertNode("a"));
+      std::vector<std::tuple<std::string, std::string, double>> edges{g.begin(), g.end()};
+      REQUIRE(edges == std::vector<std::tuple<std::string, std::string, double>>{
+                           {"a", "b", 1}, {"a", "b", 2}, {"b", "b", 4}, {"c", "a", 3}});
+      REQUIRE(std::get<2>(*g.rbegin()) == 3);
+      REQUIRE_THROWS_AS(g.InsertEdge("a", "z", 1), std::runtime_error);
+      REQUIRE_THROWS_AS(g.GetConnected("z"), std::out_of_range);
+    }
+    WHEN("a node is renamed past the others") {
+      REQUIRE(g.Replace("a", "d"));
+      THEN("its edges follow it and stay in order") {
+        REQUIRE(g.GetNodes() == std::vector<std::string>{"b", "c", "d"});
+        REQUIRE(g.GetWeights("d", "b") == std::vector<double>{1, 2});
+        REQUIRE(g.IsConnected("c", "d"));
+        REQUIRE(g.ToGraph().GetWeights("d", "b") == std::vector<double>{1, 2});
+      }
+    }
+    WHEN("it is copied and moved") {
+      auto copy{g};
+      auto moved{std::move(g)};
+      THEN("the copy and the new owner both have everything, and the old one nothing") {
+        REQUIRE(copy.GetNodes() == moved.GetNodes());
+        REQUIRE(g.GetNodes().empty());
+        REQUIRE(g.begin() == g.end());
+      }
+    }
+  }
+  GIVEN("more nodes than fit inline") {
+    gdwg::SmallGraph<int, int, 4, 4> g{};
+    for (int i = 0; i < 5; ++i) {
+      g.InsertNode(i);
+    }
+    THEN("it spills into a Graph with everything it had") {
+      REQUIRE(!g.IsInline());
+      REQUIRE(g.GetNodes() == std::vector<int>{0, 1, 2, 3, 4});
+      auto copy{g};
+      REQUIRE(!copy.IsInline());
+      REQUIRE(copy.GetNodes() == g.GetNodes());
+    }
+    THEN("clearing it makes it small again") {
+      g.Clear();
+      REQUIRE(g.IsInline());
+      REQUIRE(g.GetNodes().empty());
+    }
+  }
+}
+
+SCENARIO("SmallGraph against Graph under random edits") {
+  GIVEN("the same random edits to a SmallGraph and a Graph") {
+    std::mt19937 rng{39};
+    gdwg::SmallGraph<int, int, 6, 10> small{};
+    gdwg::Graph<int, int> g{};
+    auto node = [&rng]() { return static_cast<int>(rng() % 9); };
+    for (int step = 0; step < 4000; ++step) {
+      const int a = node();
+      const int b = node();
+      const int w = static_cast<int>(rng() % 3);
+      switch (rng() % 10) {
+      case 0:
+      case 1:
+        RequireSame(small, g, [&](auto& x) { return x.InsertNode(a); });
+        break;
+      case 2:
+      case 3:
+      case 4:
+        RequireSame(small, g, [&](auto& x) { return x.InsertEdge(a, b, w); });
+        break;
+      case 5:
+        RequireSame(small, g, [&](auto& x) { return x.erase(a, b, w); });
+        /* and through find, which also says what comes after the erased edge */
+        RequireSame(small, g, [&](auto& x) {
+          auto next = x.erase(x.find(b, a, w));
+          return std::vector<std::tuple<int, int, int>>{next, x.end()};
+        });
+        break;
+      case 6:
+        RequireSame(small, g, [&](auto& x) { return x.DeleteNode(a); });
+        break;
+      case 7:
+        RequireSame(small, g, [&](auto& x) { return x.Replace(a, b); });
+        break;
+      case 8:
+        RequireSame(small, g, [&](auto& x) {
+          x.MergeReplace(a, b);
+          return true;
+        });
+        break;
+      default:
+        RequireSame(small, g, [&](auto& x) { return x.GetConnected(a); });
+        RequireSame(small, g, [&](auto& x) { return x.GetWeights(a, b); });
+        RequireSame(small, g, [&](auto& x) { return x.IsConnected(a, b); });
+        break;
+      }
+      REQUIRE(small.GetNodes() == g.GetNodes());
+      REQUIRE(EdgesOf(small) == EdgesOf(g));
+      REQUIRE(Printed(small) == Printed(g));
+      /* start over now and then, so most of the run is inline */
+      if (step % 50 == 49) {
+        /* the copy may spill where small hasn't, and still compare equal */
+        auto copy{small};
+        REQUIRE((copy == small));
+        copy.InsertNode(a + 100);
+        REQUIRE((copy != small));
+        copy.DeleteNode(a + 100);
+        REQUIRE((copy == small));
+        small.Clear();
+        g.Clear();
+      }
+    }
+  }
+}
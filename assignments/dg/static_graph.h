@@ -0,0 +1,152 @@
+#ifndef ASSIGNMENTS_DG_STATIC_GRAPH_H_
+#define ASSIGNMENTS_DG_STATIC_GRAPH_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+
+namespace gdwg {
+
+/* a graph fixed at compile time, for topologies known up front (pipeline
+ * stages, state machines). It is built by a constexpr constructor (usually
+ * through MakeStaticGraph) into std::arrays: the nodes sorted, and the edges as
+ * (src id, dst id, weight) sorted the same way Graph orders them, with each
+ * node's outgoing edges a run found through a table of offsets. Declared
+ * constexpr, the whole thing is worked out by the compiler and sits in
+ * read-only data, so the constexpr queries are a binary search for each node
+ * and a scan of one short run of edges, and with constant arguments they fold
+ * away to constants.
+ *
+ * The query methods mean, and throw, what they do on Graph. N and E have to be
+ * literal types whose < and == are constexpr (ints, chars, std::string_view and
+ * so on) and default constructible. Building sorts by insertion, so it is meant
+ * for the small graphs this is for, not thousands of edges */
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+class StaticGraph {
+ public:
+  using node_id = std::uint32_t;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::tuple<N, N, E>;
+    using reference = std::tuple<const N&, const N&, const E&>;
+    using pointer = void;
+    using difference_type = int;
+
+    constexpr const_iterator() = default;
+
+    constexpr reference operator*() const {
+      return {g_->nodes_[g_->src_[i_]], g_->nodes_[g_->dst_[i_]], g_->weights_[i_]};
+    }
+    constexpr const_iterator& operator++() {
+      ++i_;
+      return *this;
+    }
+    constexpr const_iterator operator++(int) {
+      auto copy{*this};
+      ++(*this);
+      return copy;
+    }
+    constexpr const_iterator& operator--() {
+      --i_;
+      return *this;
+    }
+    constexpr const_iterator operator--(int) {
+      auto copy{*this};
+      --(*this);
+      return copy;
+    }
+
+    friend constexpr bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+      return lhs.i_ == rhs.i_;
+    }
+    friend constexpr bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    const StaticGraph* g_{nullptr};
+    std::size_t i_{0};
+
+    friend class StaticGraph;
+    constexpr const_iterator(const StaticGraph* g, std::size_t i) : g_{g}, i_{i} {}
+  };
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /* ctors */
+  /* sorts nodes and edges into place. Throws std::invalid_argument if a node is
+   * given twice, or an edge is given twice or has an end that isn't a node
+   * (which, during constant evaluation, makes it a compile error) */
+  constexpr StaticGraph(const std::array<N, NodeCount>& nodes,
+                        const std::array<std::tuple<N, N, E>, EdgeCount>& edges);
+
+  /* methods */
+  constexpr std::size_t NumNodes() const { return NodeCount; }
+  constexpr std::size_t NumEdges() const { return EdgeCount; }
+  constexpr bool IsNode(const N& val) const { return FindNode(val) < NodeCount; }
+  /* throws std::runtime_error if src or dst doesn't exist, like Graph::IsConnected */
+  constexpr bool IsConnected(const N& src, const N& dst) const;
+  /* how many edges go out of src. Throws std::out_of_range if it isn't a node */
+  constexpr std::size_t OutDegree(const N& src) const;
+  /* the edge (src, dst, w), or end() */
+  constexpr const_iterator find(const N& src, const N& dst, const E& w) const;
+  /* id <-> value conversion, ids being positions in node order. Id throws
+   * std::out_of_range for unknown values */
+  constexpr node_id Id(const N& val) const;
+  constexpr const N& Value(node_id id) const { return nodes_[id]; }
+  constexpr const std::array<N, NodeCount>& Nodes() const { return nodes_; }
+  /* the same as Graph's, so they hand back vectors (which can't be constexpr) */
+  std::vector<N> GetNodes() const { return {nodes_.begin(), nodes_.end()}; }
+  /* throws std::out_of_range if src doesn't exist, like Graph::GetConnected */
+  std::vector<N> GetConnected(const N& src) const;
+  /* throws std::out_of_range if src or dst doesn't exist, like Graph::GetWeights */
+  std::vector<E> GetWeights(const N& src, const N& dst) const;
+  /* a Graph with the same nodes and edges, built with Graph::FromSortedIds */
+  Graph<N, E> ToGraph() const;
+
+  /* iterator methods, over (src, dst, w) in the same order as Graph's */
+  constexpr const_iterator cbegin() const { return const_iterator{this, 0}; }
+  constexpr const_iterator cend() const { return const_iterator{this, EdgeCount}; }
+  constexpr const_iterator begin() const { return cbegin(); }
+  constexpr const_iterator end() const { return cend(); }
+  const_reverse_iterator crbegin() const { return const_reverse_iterator{cend()}; }
+  const_reverse_iterator crend() const { return const_reverse_iterator{cbegin()}; }
+  const_reverse_iterator rbegin() const { return crbegin(); }
+  const_reverse_iterator rend() const { return crend(); }
+
+ private:
+  /* the position of val in nodes_, or NodeCount if it isn't there */
+  constexpr std::size_t FindNode(const N& val) const;
+  /* the edges from src to dst (by id) are [first, second), in weight order */
+  constexpr std::pair<std::size_t, std::size_t> EdgesBetween(std::size_t src,
+                                                             std::size_t dst) const;
+
+  std::array<N, NodeCount> nodes_{};
+  /* src's outgoing edges are [offsets_[src], offsets_[src + 1]) */
+  std::array<std::size_t, NodeCount + 1> offsets_{};
+  std::array<node_id, EdgeCount> src_{};
+  std::array<node_id, EdgeCount> dst_{};
+  std::array<E, EdgeCount> weights_{};
+};
+
+/* the usual way to make one, with the sizes worked out from the lists, e.g.
+ *   constexpr auto g = gdwg::MakeStaticGraph<char, int>({'a', 'b'}, {{'a', 'b', 1}}); */
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+constexpr StaticGraph<N, E, NodeCount, EdgeCount>
+MakeStaticGraph(const N (&nodes)[NodeCount], const std::tuple<N, N, E> (&edges)[EdgeCount]);
+/* a graph without edges */
+template <typename N, typename E, std::size_t NodeCount>
+constexpr StaticGraph<N, E, NodeCount, 0> MakeStaticGraph(const N (&nodes)[NodeCount]);
+
+}  // namespace gdwg
+
+#include "assignments/dg/static_graph.tpp"
+
+#endif  // ASSIGNMENTS_DG_STATIC_GRAPH_H_
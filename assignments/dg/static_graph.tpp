@@ -0,0 +1,208 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+namespace detail {
+
+/* an insertion sort, as std::sort isn't constexpr until C++20 (and std::swap
+ * isn't either) */
+template <typename T, std::size_t Size, typename Less>
+constexpr void InsertionSort(std::array<T, Size>& a, Less less) {
+  for (std::size_t i = 1; i < Size; ++i) {
+    for (std::size_t j = i; j > 0 && less(a[j], a[j - 1]); --j) {
+      T moved = a[j];
+      a[j] = a[j - 1];
+      a[j - 1] = moved;
+    }
+  }
+}
+
+/* a built-in array as a std::array, copy constructing each element (std::tuple
+ * can be copied in a constant expression, but not assigned until C++20) */
+template <typename T, std::size_t Size, std::size_t... I>
+constexpr std::array<T, Size> ToArray(const T (&a)[Size], std::index_sequence<I...>) {
+  return {{a[I]...}};
+}
+
+}  // namespace detail
+}  // namespace gdwg
+
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+constexpr gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::StaticGraph(
+    const std::array<N, NodeCount>& nodes,
+    const std::array<std::tuple<N, N, E>, EdgeCount>& edges)
+  : nodes_{nodes} {
+  detail::InsertionSort(nodes_, [](const N& a, const N& b) { return a < b; });
+  for (std::size_t i = 1; i < NodeCount; ++i) {
+    if (!(nodes_[i - 1] < nodes_[i]))
+      throw std::invalid_argument("Cannot call MakeStaticGraph with the same node twice");
+  }
+
+  /* edges by id, which sort the same as by value since ids follow node order */
+  struct IdEdge {
+    std::size_t src;
+    std::size_t dst;
+    E w;
+  };
+  std::array<IdEdge, EdgeCount> by_id{};
+  for (std::size_t e = 0; e < EdgeCount; ++e) {
+    const auto src = FindNode(std::get<0>(edges[e]));
+    const auto dst = FindNode(std::get<1>(edges[e]));
+    if (src == NodeCount || dst == NodeCount) {
+      throw std::invalid_argument(
+          "Cannot call MakeStaticGraph with an edge whose src or dst isn't a node");
+    }
+    by_id[e] = IdEdge{src, dst, std::get<2>(edges[e])};
+  }
+  auto less = [](const IdEdge& a, const IdEdge& b) {
+    if (a.src != b.src)
+      return a.src < b.src;
+    if (a.dst != b.dst)
+      return a.dst < b.dst;
+    return a.w < b.w;
+  };
+  detail::InsertionSort(by_id, less);
+  for (std::size_t e = 0; e < EdgeCount; ++e) {
+    if (e > 0 && !less(by_id[e - 1], by_id[e]))
+      throw std::invalid_argument("Cannot call MakeStaticGraph with the same edge twice");
+    src_[e] = static_cast<node_id>(by_id[e].src);
+    dst_[e] = static_cast<node_id>(by_id[e].dst);
+    weights_[e] = by_id[e].w;
+    ++offsets_[by_id[e].src + 1];
+  }
+  for (std::size_t v = 0; v < NodeCount; ++v) {
+    offsets_[v + 1] += offsets_[v];
+  }
+}
+
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+constexpr bool gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::IsConnected(const N& src,
+                                                                        const N& dst) const {
+  const auto src_id = FindNode(src);
+  const auto dst_id = FindNode(dst);
+  if (src_id == NodeCount || dst_id == NodeCount) {
+    throw std::runtime_error(
+        "Cannot call Graph::IsConnected if src or dst node don't exist in the graph");
+  }
+  const auto range = EdgesBetween(src_id, dst_id);
+  return range.first != range.second;
+}
+
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+constexpr std::size_t gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::OutDegree(const N& src) const {
+  const auto id = Id(src);
+  return offsets_[id + 1] - offsets_[id];
+}
+
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+constexpr typename gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::const_iterator
+gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::find(const N& src, const N& dst, const E& w) const {
+  const auto src_id = FindNode(src);
+  const auto dst_id = FindNode(dst);
+  if (src_id == NodeCount || dst_id == NodeCount)
+    return cend();
+  const auto [first, last] = EdgesBetween(src_id, dst_id);
+  for (auto e = first; e < last; ++e) {
+    if (weights_[e] == w)
+      return const_iterator{this, e};
+  }
+  return cend();
+}
+
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+constexpr typename gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::node_id
+gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::Id(const N& val) const {
+  const auto id = FindNode(val);
+  if (id == NodeCount)
+    throw std::out_of_range("Cannot call StaticGraph::Id on a value that isn't a node");
+  return static_cast<node_id>(id);
+}
+
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+std::vector<N> gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::GetConnected(const N& src) const {
+  const auto id = FindNode(src);
+  if (id == NodeCount) {
+    throw std::out_of_range("Cannot call Graph::GetConnected if src doesn't exist in the graph");
+  }
+  /* src's edges are sorted by dst, so each neighbour's edges are a run */
+  std::vector<N> connected{};
+  for (auto e = offsets_[id]; e < offsets_[id + 1]; ++e) {
+    if (e == offsets_[id] || dst_[e] != dst_[e - 1])
+      connected.push_back(nodes_[dst_[e]]);
+  }
+  return connected;
+}
+
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+std::vector<E> gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::GetWeights(const N& src,
+                                                                       const N& dst) const {
+  const auto src_id = FindNode(src);
+  const auto dst_id = FindNode(dst);
+  if (src_id == NodeCount || dst_id == NodeCount) {
+    throw std::out_of_range(
+        "Cannot call Graph::GetWeights if src or dst node don't exist in the graph");
+  }
+  const auto [first, last] = EdgesBetween(src_id, dst_id);
+  return {weights_.begin() + static_cast<std::ptrdiff_t>(first),
+          weights_.begin() + static_cast<std::ptrdiff_t>(last)};
+}
+
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+gdwg::Graph<N, E> gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::ToGraph() const {
+  std::vector<std::tuple<std::uint32_t, std::uint32_t, E>> edges{};
+  edges.reserve(EdgeCount);
+  for (std::size_t e = 0; e < EdgeCount; ++e) {
+    edges.emplace_back(src_[e], dst_[e], weights_[e]);
+  }
+  return Graph<N, E>::FromSortedIds(GetNodes(), std::move(edges));
+}
+
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+constexpr std::size_t gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::FindNode(const N& val) const {
+  if (NodeCount == 0)
+    return NodeCount;
+  /* a binary search that only ever halves the range, so its one comparison per
+   * step can become a conditional move rather than a hard to predict branch */
+  std::size_t first = 0;
+  for (std::size_t size = NodeCount; size > 1; size -= size / 2) {
+    const auto mid = first + size / 2;
+    first = nodes_[mid] < val ? mid : first;
+  }
+  first += nodes_[first] < val;
+  return first < NodeCount && !(val < nodes_[first]) ? first : NodeCount;
+}
+
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+constexpr std::pair<std::size_t, std::size_t>
+gdwg::StaticGraph<N, E, NodeCount, EdgeCount>::EdgesBetween(std::size_t src,
+                                                            std::size_t dst) const {
+  /* a node of a graph like this has a handful of edges, which a scan gets
+   * through faster than a binary search would */
+  auto first = offsets_[src];
+  const auto last = offsets_[src + 1];
+  while (first < last && dst_[first] < dst)
+    ++first;
+  auto end = first;
+  while (end < last && dst_[end] == dst)
+    ++end;
+  return {first, end};
+}
+
+template <typename N, typename E, std::size_t NodeCount, std::size_t EdgeCount>
+constexpr gdwg::StaticGraph<N, E, NodeCount, EdgeCount>
+gdwg::MakeStaticGraph(const N (&nodes)[NodeCount], const std::tuple<N, N, E> (&edges)[EdgeCount]) {
+  return StaticGraph<N, E, NodeCount, EdgeCount>{
+      detail::ToArray(nodes, std::make_index_sequence<NodeCount>{}),
+      detail::ToArray(edges, std::make_index_sequence<EdgeCount>{})};
+}
+
+template <typename N, typename E, std::size_t NodeCount>
+constexpr gdwg::StaticGraph<N, E, NodeCount, 0> gdwg::MakeStaticGraph(const N (&nodes)[NodeCount]) {
+  return StaticGraph<N, E, NodeCount, 0>{
+      detail::ToArray(nodes, std::make_index_sequence<NodeCount>{}), {}};
+}
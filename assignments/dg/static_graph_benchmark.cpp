@@ -0,0 +1,111 @@
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/static_graph.h"
+
+namespace {
+
+constexpr std::size_t kStates = 16;
+constexpr std::size_t kTransitions = 48;
+
+/* a state machine: three transitions out of every state, on inputs 0, 1 and 2 */
+constexpr std::tuple<int, int, int> Transition(std::size_t i) {
+  return {static_cast<int>(i / 3), static_cast<int>((i * 7 + 1) % kStates),
+          static_cast<int>(i % 3)};
+}
+
+constexpr std::array<int, kStates> States() {
+  std::array<int, kStates> states{};
+  for (std::size_t i = 0; i < kStates; ++i) {
+    states[i] = static_cast<int>(i);
+  }
+  return states;
+}
+
+template <std::size_t... I>
+constexpr gdwg::StaticGraph<int, int, kStates, kTransitions> Machine(std::index_sequence<I...>) {
+  return {States(), {{Transition(I)...}}};
+}
+
+constexpr auto kMachine = Machine(std::make_index_sequence<kTransitions>{});
+
+}  // namespace
+
+/* lookups on a 16 state, 48 transition machine, held in a Graph built at run
+ * time and in a StaticGraph built by the compiler: IsConnected and find for
+ * random (state, state, input) triples, and a sum over every edge.
+ * usage: static_graph_benchmark [num_queries (default 2000000)] */
+int main(int argc, char** argv) {
+  const auto num_queries = gdwg::benchmark::Arg(argc, argv, 1, 2000000);
+  gdwg::benchmark::JsonResults json{};
+
+  gdwg::benchmark::Stopwatch build_timer{};
+  std::vector<std::tuple<int, int, int>> transitions{};
+  for (std::size_t i = 0; i < kTransitions; ++i) {
+    transitions.push_back(Transition(i));
+  }
+  const gdwg::Graph<int, int> g{transitions.cbegin(), transitions.cend()};
+  gdwg::benchmark::Report("Graph built at run time", kTransitions, build_timer.Seconds());
+
+  std::mt19937 rng{6771};
+  std::uniform_int_distribution<int> state{0, static_cast<int>(kStates) - 1};
+  std::uniform_int_distribution<int> input{0, 2};
+  std::vector<std::tuple<int, int, int>> queries(num_queries);
+  for (auto& [src, dst, w] : queries) {
+    src = state(rng);
+    dst = state(rng);
+    w = input(rng);
+  }
+
+  auto time = [&](const char* name, const char* storage, auto query) {
+    std::size_t found = 0;
+    gdwg::benchmark::Stopwatch timer{};
+    for (const auto& [src, dst, w] : queries) {
+      found += query(src, dst, w);
+    }
+    const auto seconds = timer.Seconds();
+    gdwg::benchmark::Report(std::string{storage} + " " + name, num_queries, seconds);
+    json.Add(name, {{"storage", storage}}, num_queries, seconds);
+    return found;
+  };
+  std::size_t check = 0;
+  check += time("IsConnected", "Graph", [&g](int src, int dst, int) {
+    return g.IsConnected(src, dst);
+  });
+  check -= time("IsConnected", "StaticGraph", [](int src, int dst, int) {
+    return kMachine.IsConnected(src, dst);
+  });
+  check += time("find", "Graph", [&g](int src, int dst, int w) {
+    return g.find(src, dst, w) != g.end();
+  });
+  check -= time("find", "StaticGraph", [](int src, int dst, int w) {
+    return kMachine.find(src, dst, w) != kMachine.end();
+  });
+
+  const auto passes = num_queries / kTransitions;
+  auto sum = [&](const char* storage, const auto& graph) {
+    long total = 0;
+    gdwg::benchmark::Stopwatch timer{};
+    for (std::size_t pass = 0; pass < passes; ++pass) {
+      for (const auto& [src, dst, w] : graph) {
+        total += src + dst + w;
+      }
+    }
+    const auto seconds = timer.Seconds();
+    gdwg::benchmark::Report(std::string{storage} + " iteration", passes * kTransitions, seconds);
+    json.Add("iteration", {{"storage", storage}}, passes * kTransitions, seconds);
+    return total;
+  };
+  const auto graph_total = sum("Graph", g);
+  const auto static_total = sum("StaticGraph", kMachine);
+  std::cout << "  (mismatches " << check << ", totals " << graph_total << " and " << static_total
+            << ")\n";
+  json.Write(std::cout);
+}
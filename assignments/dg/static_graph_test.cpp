@@ -0,0 +1,89 @@
+#include "assignments/dg/static_graph.h"
+
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+namespace {
+
+using namespace std::string_view_literals;
+
+/* a small pipeline, given out of order, with parallel edges and a loop back */
+constexpr auto kPipeline = gdwg::MakeStaticGraph<std::string_view, int>(
+    {"sink"sv, "parse"sv, "source"sv, "filter"sv},
+    {{"source"sv, "parse"sv, 1},
+     {"parse"sv, "filter"sv, 2},
+     {"parse"sv, "sink"sv, 5},
+     {"parse"sv, "filter"sv, 1},
+     {"filter"sv, "sink"sv, 3},
+     {"filter"sv, "parse"sv, 9}});
+
+/* every query can be answered by the compiler */
+static_assert(kPipeline.NumNodes() == 4 && kPipeline.NumEdges() == 6);
+static_assert(kPipeline.IsNode("parse"sv) && !kPipeline.IsNode("nope"sv));
+static_assert(kPipeline.IsConnected("parse"sv, "filter"sv));
+static_assert(!kPipeline.IsConnected("sink"sv, "source"sv));
+static_assert(kPipeline.OutDegree("parse"sv) == 3 && kPipeline.OutDegree("sink"sv) == 0);
+static_assert(kPipeline.find("parse"sv, "filter"sv, 1) != kPipeline.end());
+static_assert(kPipeline.find("parse"sv, "filter"sv, 3) == kPipeline.end());
+static_assert(kPipeline.Value(kPipeline.Id("source"sv)) == "source"sv);
+static_assert(std::get<0>(*kPipeline.begin()) == "filter"sv);
+
+constexpr auto kIsolated = gdwg::MakeStaticGraph<int, double>({3, 1, 2});
+static_assert(kIsolated.NumEdges() == 0 && kIsolated.begin() == kIsolated.end());
+static_assert(kIsolated.Nodes()[0] == 1);
+static_assert(!kIsolated.IsNode(0) && kIsolated.IsNode(1) && kIsolated.IsNode(2));
+static_assert(kIsolated.IsNode(3) && !kIsolated.IsNode(4));
+
+}  // namespace
+
+SCENARIO("StaticGraph answers like a Graph") {
+  GIVEN("a static graph and a Graph with the same edges") {
+    using Edge = std::tuple<std::string_view, std::string_view, int>;
+    const std::vector<Edge> edges{{"source", "parse", 1}, {"parse", "filter", 2},
+                                  {"parse", "sink", 5},   {"parse", "filter", 1},
+                                  {"filter", "sink", 3},  {"filter", "parse", 9}};
+    const gdwg::Graph<std::string_view, int> g{edges.cbegin(), edges.cend()};
+    THEN("the queries agree") {
+      REQUIRE(kPipeline.GetNodes() == g.GetNodes());
+      for (const auto src : g.GetNodes()) {
+        REQUIRE(kPipeline.GetConnected(src) == g.GetConnected(src));
+        REQUIRE(kPipeline.OutDegree(src) == g.OutDegree(src));
+        for (const auto dst : g.GetNodes()) {
+          REQUIRE(kPipeline.IsConnected(src, dst) == g.IsConnected(src, dst));
+          REQUIRE(kPipeline.GetWeights(src, dst) == g.GetWeights(src, dst));
+        }
+      }
+    }
+    THEN("iterating gives the same edges in the same order, both ways") {
+      REQUIRE(std::vector<Edge>(kPipeline.begin(), kPipeline.end()) ==
+              std::vector<Edge>(g.begin(), g.end()));
+      REQUIRE(std::vector<Edge>(kPipeline.rbegin(), kPipeline.rend()) ==
+              std::vector<Edge>(g.rbegin(), g.rend()));
+      REQUIRE((kPipeline.ToGraph() == g));
+    }
+    THEN("missing nodes throw what Graph throws") {
+      REQUIRE_THROWS_AS(kPipeline.IsConnected("nope", "sink"), std::runtime_error);
+      REQUIRE_THROWS_AS(kPipeline.GetConnected("nope"), std::out_of_range);
+      REQUIRE_THROWS_AS(kPipeline.GetWeights("sink", "nope"), std::out_of_range);
+      REQUIRE_THROWS_AS(kPipeline.OutDegree("nope"), std::out_of_range);
+      REQUIRE_THROWS_AS(kPipeline.Id("nope"), std::out_of_range);
+    }
+  }
+  GIVEN("lists that don't make a graph") {
+    THEN("building throws (and would fail to compile if constexpr)") {
+      auto same_node = [] { return gdwg::MakeStaticGraph<int, int>({1, 2, 1}); };
+      auto same_edge = [] {
+        return gdwg::MakeStaticGraph<int, int>({1, 2}, {{1, 2, 3}, {1, 2, 3}});
+      };
+      auto missing_node = [] { return gdwg::MakeStaticGraph<int, int>({1, 2}, {{1, 5, 3}}); };
+      REQUIRE_THROWS_AS(same_node(), std::invalid_argument);
+      REQUIRE_THROWS_AS(same_edge(), std::invalid_argument);
+      REQUIRE_THROWS_AS(missing_node(), std::invalid_argument);
+    }
+  }
+}
@@ -0,0 +1,142 @@
+#ifndef ASSIGNMENTS_DG_TEMPORAL_GRAPH_H_
+#define ASSIGNMENTS_DG_TEMPORAL_GRAPH_H_
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+
+namespace gdwg {
+
+/* a Graph whose edges are only valid for a time: each edge (src, dst, w) has an
+ * interval [start, end) of times T, and the same edge can come and go many
+ * times. Nodes are timeless. Every version of every edge is kept in an ordinary
+ * Graph (History()), whose weights are TimedWeights, and alongside it each node
+ * has its outgoing and incoming versions indexed by end time, as does the whole
+ * graph. A query as of time t only has to look at versions that end after t,
+ * found with one binary search, so however much history has built up behind
+ * it, a query about now only touches the edges that are live now (plus any that
+ * start in the future) */
+template <typename N, typename E, typename T = std::int64_t>
+class TemporalGraph {
+ public:
+  /* the end of an edge that hasn't ended */
+  static constexpr T kForever = std::numeric_limits<T>::max();
+
+  /* the weight of a version of an edge in History() */
+  struct TimedWeight {
+    E value;
+    T start;
+    T end;
+
+    friend bool operator<(const TimedWeight& a, const TimedWeight& b) {
+      return std::tie(a.value, a.start, a.end) < std::tie(b.value, b.start, b.end);
+    }
+    friend bool operator==(const TimedWeight& a, const TimedWeight& b) {
+      return a.value == b.value && a.start == b.start && a.end == b.end;
+    }
+  };
+
+  /* one version of an edge, as handed back by the queries */
+  struct TemporalEdge {
+    N src;
+    N dst;
+    E value;
+    T start;
+    T end;
+
+    /* versions can share (src, dst, w, start) and differ only in end, so end is
+     * part of the order too, or equal keys would come back in any order */
+    friend bool operator<(const TemporalEdge& a, const TemporalEdge& b) {
+      return std::tie(a.src, a.dst, a.value, a.start, a.end) <
+             std::tie(b.src, b.dst, b.value, b.start, b.end);
+    }
+    friend bool operator==(const TemporalEdge& a, const TemporalEdge& b) {
+      return std::tie(a.src, a.dst, a.value, a.start, a.end) ==
+             std::tie(b.src, b.dst, b.value, b.start, b.end);
+    }
+  };
+
+  /* ctors */
+  TemporalGraph() = default;
+
+  /* methods */
+  bool InsertNode(const N& val);
+  /* deletes the node and every version of every edge in or out of it */
+  bool DeleteNode(const N& val);
+  bool IsNode(const N& val) const { return history_.IsNode(val); }
+  std::vector<N> GetNodes() const { return history_.GetNodes(); }
+  /* adds a version of (src, dst, w) valid over [start, end). Returns false if
+   * that exact version is already there. Throws std::runtime_error if src or dst
+   * isn't a node (as Graph::InsertEdge does), and std::invalid_argument if the
+   * interval is empty */
+  bool InsertEdge(const N& src, const N& dst, const E& w, T start, T end = kForever);
+  /* ends the version of (src, dst, w) that started at start and hadn't ended,
+   * at end. Returns false if there is no such version. Throws
+   * std::invalid_argument if end isn't after start */
+  bool EndEdge(const N& src, const N& dst, const E& w, T start, T end);
+  /* removes one version entirely, returning false if it isn't there */
+  bool EraseEdge(const N& src, const N& dst, const E& w, T start, T end);
+  void Clear();
+
+  /* every version of every edge, as an ordinary Graph */
+  const Graph<N, TimedWeight>& History() const { return history_; }
+
+  /* queries as of a time t, i.e. over the versions with start <= t < end */
+  /* the nodes src has an edge to at t, in order. Throws std::out_of_range if
+   * src isn't a node */
+  std::vector<N> GetConnectedAsOf(const N& src, T t) const;
+  /* src's outgoing, or dst's incoming, edge versions at t, ordered by (src, dst,
+   * w, start, end). Throw std::out_of_range if the node isn't one */
+  std::vector<TemporalEdge> OutgoingAsOf(const N& src, T t) const;
+  std::vector<TemporalEdge> IncomingAsOf(const N& dst, T t) const;
+  /* the graph as it was at t: every node, and every edge with a version live at t */
+  Graph<N, E> AsOf(T t) const;
+  /* every edge version that was live at some point in [from, to), ordered by
+   * (src, dst, w, start, end) */
+  std::vector<TemporalEdge> EdgesInWindow(T from, T to) const;
+
+ private:
+  /* compares a version (any tuple starting with its end time) to a bare end
+   * time, so the versions ending after t are an upper_bound away */
+  struct EndTime {
+    T t;
+    template <typename Version>
+    friend bool operator<(const Version& version, const EndTime& end) {
+      return std::get<0>(version) < end.t;
+    }
+    template <typename Version>
+    friend bool operator<(const EndTime& end, const Version& version) {
+      return end.t < std::get<0>(version);
+    }
+  };
+  /* versions in end time order: (end, start, other end of the edge, w). For a
+   * node's outgoing edges the other end is dst, for incoming ones src */
+  using ByEnd = std::set<std::tuple<T, T, N, E>, std::less<>>;
+  struct NodeIndex {
+    ByEnd outgoing;
+    ByEnd incoming;
+  };
+
+  void Index(const N& src, const N& dst, const E& w, T start, T end);
+  void Unindex(const N& src, const N& dst, const E& w, T start, T end);
+  /* the versions in by_end live at t, as edges from src (or to dst, if incoming) */
+  std::vector<TemporalEdge>
+  LiveAt(const ByEnd& by_end, const N& node, bool incoming, T t) const;
+
+  Graph<N, TimedWeight> history_;
+  std::map<N, NodeIndex> index_;
+  /* every version, as (end, start, src, dst, w) */
+  std::set<std::tuple<T, T, N, N, E>, std::less<>> by_end_;
+};
+
+}  // namespace gdwg
+
+#include "assignments/dg/temporal_graph.tpp"
+
+#endif  // ASSIGNMENTS_DG_TEMPORAL_GRAPH_H_
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+template <typename N, typename E, typename T>
+bool gdwg::TemporalGraph<N, E, T>::InsertNode(const N& val) {
+  if (!history_.InsertNode(val))
+    return false;
+  index_.emplace(val, NodeIndex{});
+  return true;
+}
+
+template <typename N, typename E, typename T>
+bool gdwg::TemporalGraph<N, E, T>::DeleteNode(const N& val) {
+  auto node_it = index_.find(val);
+  if (node_it == index_.end())
+    return false;
+  /* take each version out of the index at its other end and out of by_end_. A
+   * reflexive edge is seen from both sides, and the second erase finds nothing */
+  for (const auto& [end, start, dst, w] : node_it->second.outgoing) {
+    if (!(dst == val))
+      index_.at(dst).incoming.erase(std::tie(end, start, val, w));
+    by_end_.erase(std::tie(end, start, val, dst, w));
+  }
+  for (const auto& [end, start, src, w] : node_it->second.incoming) {
+    if (!(src == val))
+      index_.at(src).outgoing.erase(std::tie(end, start, val, w));
+    by_end_.erase(std::tie(end, start, src, val, w));
+  }
+  index_.erase(node_it);
+  return history_.DeleteNode(val);
+}
+
+template <typename N, typename E, typename T>
+bool gdwg::TemporalGraph<N, E, T>::InsertEdge(const N& src,
+                                              const N& dst,
+                                              const E& w,
+                                              T start,
+                                              T end) {
+  if (!(start < end)) {
+    throw std::invalid_argument("Cannot call TemporalGraph::InsertEdge with an empty interval");
+  }
+  if (!history_.InsertEdge(src, dst, TimedWeight{w, start, end}))
+    return false;
+  Index(src, dst, w, start, end);
+  return true;
+}
+
+template <typename N, typename E, typename T>
+bool gdwg::TemporalGraph<N, E, T>::EndEdge(const N& src,
+                                           const N& dst,
+                                           const E& w,
+                                           T start,
+                                           T end) {
+  if (!(start < end)) {
+    throw std::invalid_argument("Cannot call TemporalGraph::EndEdge with an end before its start");
+  }
+  if (!history_.erase(src, dst, TimedWeight{w, start, kForever}))
+    return false;
+  Unindex(src, dst, w, start, kForever);
+  /* the ended version might already have been there on its own */
+  if (history_.InsertEdge(src, dst, TimedWeight{w, start, end}))
+    Index(src, dst, w, start, end);
+  return true;
+}
+
+template <typename N, typename E, typename T>
+bool gdwg::TemporalGraph<N, E, T>::EraseEdge(const N& src,
+                                             const N& dst,
+                                             const E& w,
+                                             T start,
+                                             T end) {
+  if (!history_.erase(src, dst, TimedWeight{w, start, end}))
+    return false;
+  Unindex(src, dst, w, start, end);
+  return true;
+}
+
+template <typename N, typename E, typename T>
+void gdwg::TemporalGraph<N, E, T>::Clear() {
+  history_.Clear();
+  index_.clear();
+  by_end_.clear();
+}
+
+template <typename N, typename E, typename T>
+std::vector<N> gdwg::TemporalGraph<N, E, T>::GetConnectedAsOf(const N& src, T t) const {
+  std::vector<N> connected{};
+  for (auto& edge : OutgoingAsOf(src, t)) {
+    if (connected.empty() || !(connected.back() == edge.dst))
+      connected.push_back(std::move(edge.dst));
+  }
+  return connected;
+}
+
+template <typename N, typename E, typename T>
+std::vector<typename gdwg::TemporalGraph<N, E, T>::TemporalEdge>
+gdwg::TemporalGraph<N, E, T>::OutgoingAsOf(const N& src, T t) const {
+  auto node_it = index_.find(src);
+  if (node_it == index_.end()) {
+    throw std::out_of_range(
+        "Cannot call TemporalGraph::OutgoingAsOf if src doesn't exist in the graph");
+  }
+  return LiveAt(node_it->second.outgoing, src, false, t);
+}
+
+template <typename N, typename E, typename T>
+std::vector<typename gdwg::TemporalGraph<N, E, T>::TemporalEdge>
+gdwg::TemporalGraph<N, E, T>::IncomingAsOf(const N& dst, T t) const {
+  auto node_it = index_.find(dst);
+  if (node_it == index_.end()) {
+    throw std::out_of_range(
+        "Cannot call TemporalGraph::IncomingAsOf if dst doesn't exist in the graph");
+  }
+  return LiveAt(node_it->second.incoming, dst, true, t);
+}
+
+template <typename N, typename E, typename T>
+gdwg::Graph<N, E> gdwg::TemporalGraph<N, E, T>::AsOf(T t) const {
+  /* index_ lists the nodes in order, so edges can be built by node id */
+  std::vector<N> nodes{};
+  nodes.reserve(index_.size());
+  for (const auto& entry : index_) {
+    nodes.push_back(entry.first);
+  }
+  auto id = [&nodes](const N& val) {
+    return static_cast<std::uint32_t>(std::lower_bound(nodes.begin(), nodes.end(), val) -
+                                      nodes.begin());
+  };
+  std::vector<std::tuple<std::uint32_t, std::uint32_t, E>> edges{};
+  for (auto it = by_end_.upper_bound(EndTime{t}); it != by_end_.end(); ++it) {
+    const auto& [end, start, src, dst, w] = *it;
+    if (!(t < start))
+      edges.emplace_back(id(src), id(dst), w);
+  }
+  /* versions of the same edge can overlap, but the graph has it once */
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  return Graph<N, E>::FromSortedIds(std::move(nodes), std::move(edges));
+}
+
+template <typename N, typename E, typename T>
+std::vector<typename gdwg::TemporalGraph<N, E, T>::TemporalEdge>
+gdwg::TemporalGraph<N, E, T>::EdgesInWindow(T from, T to) const {
+  std::vector<TemporalEdge> edges{};
+  if (!(from < to))
+    return edges;
+  /* live at some point in [from, to) means start < to and end > from */
+  for (auto it = by_end_.upper_bound(EndTime{from}); it != by_end_.end(); ++it) {
+    const auto& [end, start, src, dst, w] = *it;
+    if (start < to)
+      edges.push_back({src, dst, w, start, end});
+  }
+  std::sort(edges.begin(), edges.end());
+  return edges;
+}
+
+template <typename N, typename E, typename T>
+void gdwg::TemporalGraph<N, E, T>::Index(const N& src, const N& dst, const E& w, T start, T end) {
+  index_.at(src).outgoing.emplace(end, start, dst, w);
+  index_.at(dst).incoming.emplace(end, start, src, w);
+  by_end_.emplace(end, start, src, dst, w);
+}
+
+template <typename N, typename E, typename T>
+void gdwg::TemporalGraph<N, E, T>::Unindex(const N& src,
+                                           const N& dst,
+                                           const E& w,
+                                           T start,
+                                           T end) {
+  index_.at(src).outgoing.erase(std::tie(end, start, dst, w));
+  index_.at(dst).incoming.erase(std::tie(end, start, src, w));
+  by_end_.erase(std::tie(end, start, src, dst, w));
+}
+
+template <typename N, typename E, typename T>
+std::vector<typename gdwg::TemporalGraph<N, E, T>::TemporalEdge>
+gdwg::TemporalGraph<N, E, T>::LiveAt(const ByEnd& by_end, const N& node, bool incoming, T t) const {
+  std::vector<TemporalEdge> edges{};
+  for (auto it = by_end.upper_bound(EndTime{t}); it != by_end.end(); ++it) {
+    const auto& [end, start, other, w] = *it;
+    if (t < start)
+      continue;
+    if (incoming) {
+      edges.push_back({other, node, w, start, end});
+    } else {
+      edges.push_back({node, other, w, start, end});
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  return edges;
+}
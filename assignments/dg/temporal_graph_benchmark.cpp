@@ -0,0 +1,98 @@
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/temporal_graph.h"
+
+namespace {
+
+using Temporal = gdwg::TemporalGraph<int, int>;
+
+/* src's neighbours at t with the time kept in the weight and filtered after the
+ * fact: every version of every edge out of src is looked at */
+std::size_t ConnectedAsOfByScan(const gdwg::Graph<int, Temporal::TimedWeight>& history,
+                                int src,
+                                std::int64_t t) {
+  std::size_t found = 0;
+  for (const auto dst : history.GetConnected(src)) {
+    for (const auto& w : history.GetWeights(src, dst)) {
+      if (w.start <= t && t < w.end) {
+        ++found;
+        break;
+      }
+    }
+  }
+  return found;
+}
+
+}  // namespace
+
+/* num_edges random edges between num_nodes nodes, each of which has been
+ * switched on and off num_versions times, with only its last version still live.
+ * Times "who is src connected to now" queries on the temporal graph's end time
+ * index against filtering every version of src's edges, and reports what it
+ * costs to build the history.
+ * usage: temporal_graph_benchmark [num_nodes (default 2000)] [num_edges (default 20000)]
+ *                                 [num_versions (default 50)] [num_queries (default 20000)] */
+int main(int argc, char** argv) {
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 1, 2000);
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 2, 20000);
+  const auto num_versions = gdwg::benchmark::Arg(argc, argv, 3, 50);
+  const auto num_queries = gdwg::benchmark::Arg(argc, argv, 4, 20000);
+  const auto edges = gdwg::benchmark::RandomEdges(num_nodes, num_edges);
+  gdwg::benchmark::JsonResults json{};
+
+  gdwg::benchmark::Stopwatch build_timer{};
+  Temporal g{};
+  for (std::size_t v = 0; v < num_nodes; ++v) {
+    g.InsertNode(static_cast<int>(v));
+  }
+  const auto now = static_cast<std::int64_t>(2 * num_versions);
+  std::size_t num_inserted = 0;
+  for (const auto& [src, dst, w] : edges) {
+    for (std::size_t i = 0; i + 1 < num_versions; ++i) {
+      const auto start = static_cast<std::int64_t>(2 * i);
+      num_inserted += g.InsertEdge(src, dst, w, start, start + 1);
+    }
+    num_inserted += g.InsertEdge(src, dst, w, now);
+  }
+  const auto build_seconds = build_timer.Seconds();
+  gdwg::benchmark::Report("InsertEdge", num_inserted, build_seconds);
+  json.Add("InsertEdge", {}, num_inserted, build_seconds);
+
+  std::mt19937 rng{6771};
+  std::uniform_int_distribution<int> node{0, static_cast<int>(num_nodes) - 1};
+  std::vector<int> sources(num_queries);
+  for (auto& src : sources) {
+    src = node(rng);
+  }
+
+  std::size_t scan_found = 0;
+  gdwg::benchmark::Stopwatch scan_timer{};
+  for (const auto src : sources) {
+    scan_found += ConnectedAsOfByScan(g.History(), src, now);
+  }
+  const auto scan_seconds = scan_timer.Seconds();
+  gdwg::benchmark::Report("as of now, filtering every version", num_queries, scan_seconds);
+  json.Add("ConnectedAsOf", {{"method", "scan"}}, num_queries, scan_seconds);
+
+  std::size_t index_found = 0;
+  gdwg::benchmark::Stopwatch index_timer{};
+  for (const auto src : sources) {
+    index_found += g.GetConnectedAsOf(src, now).size();
+  }
+  const auto index_seconds = index_timer.Seconds();
+  gdwg::benchmark::Report("GetConnectedAsOf now", num_queries, index_seconds);
+  json.Add("ConnectedAsOf", {{"method", "index"}}, num_queries, index_seconds);
+
+  gdwg::benchmark::Stopwatch as_of_timer{};
+  const auto snapshot = g.AsOf(now);
+  gdwg::benchmark::Report("AsOf now", num_edges, as_of_timer.Seconds());
+  std::cout << "  (found " << scan_found << " and " << index_found << ", "
+            << snapshot.GetNodes().size() << " nodes as of now)\n";
+  json.Write(std::cout);
+}
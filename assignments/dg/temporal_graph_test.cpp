@@ -0,0 +1,187 @@
+#include "assignments/dg/temporal_graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+namespace {
+
+using Temporal = gdwg::TemporalGraph<std::string, int>;
+using Edge = Temporal::TemporalEdge;
+
+}  // namespace
+
+SCENARIO("edges that come and go") {
+  GIVEN("three nodes with edges over different intervals") {
+    Temporal g{};
+    g.InsertNode("a");
+    g.InsertNode("b");
+    g.InsertNode("c");
+    REQUIRE(g.InsertEdge("a", "b", 1, 0, 10));
+    REQUIRE(g.InsertEdge("a", "b", 1, 20));
+    REQUIRE(g.InsertEdge("a", "c", 2, 5, 15));
+    REQUIRE(g.InsertEdge("c", "a", 3, 0));
+    REQUIRE(!g.InsertEdge("a", "b", 1, 0, 10));
+    WHEN("asking who a is connected to over time") {
+      THEN("only versions with start <= t < end count") {
+        REQUIRE(g.GetConnectedAsOf("a", -1).empty());
+        REQUIRE(g.GetConnectedAsOf("a", 0) == std::vector<std::string>{"b"});
+        REQUIRE(g.GetConnectedAsOf("a", 5) == std::vector<std::string>{"b", "c"});
+        REQUIRE(g.GetConnectedAsOf("a", 10) == std::vector<std::string>{"c"});
+        REQUIRE(g.GetConnectedAsOf("a", 15).empty());
+        REQUIRE(g.GetConnectedAsOf("a", 20) == std::vector<std::string>{"b"});
+        REQUIRE(g.GetConnectedAsOf("a", Temporal::kForever - 1) ==
+                std::vector<std::string>{"b"});
+      }
+    }
+    WHEN("asking for whole edge versions") {
+      THEN("they come with their intervals, in order") {
+        REQUIRE((g.OutgoingAsOf("a", 7) ==
+                 std::vector<Edge>{{"a", "b", 1, 0, 10}, {"a", "c", 2, 5, 15}}));
+        REQUIRE((g.IncomingAsOf("a", 7) ==
+                 std::vector<Edge>{{"c", "a", 3, 0, Temporal::kForever}}));
+        REQUIRE(g.IncomingAsOf("b", 12).empty());
+      }
+    }
+    WHEN("taking the graph as of a time") {
+      const auto then = g.AsOf(7);
+      const auto now = g.AsOf(100);
+      THEN("every node is there, with the edges live at that time") {
+        gdwg::Graph<std::string, int> expected_then{"a", "b", "c"};
+        expected_then.InsertEdge("a", "b", 1);
+        expected_then.InsertEdge("a", "c", 2);
+        expected_then.InsertEdge("c", "a", 3);
+        REQUIRE((then == expected_then));
+        gdwg::Graph<std::string, int> expected_now{"a", "b", "c"};
+        expected_now.InsertEdge("a", "b", 1);
+        expected_now.InsertEdge("c", "a", 3);
+        REQUIRE((now == expected_now));
+      }
+    }
+    WHEN("asking for a window") {
+      THEN("every version overlapping [from, to) is there") {
+        REQUIRE((g.EdgesInWindow(10, 20) ==
+                 std::vector<Edge>{{"a", "c", 2, 5, 15}, {"c", "a", 3, 0, Temporal::kForever}}));
+        const std::vector<Edge> expected{{"a", "b", 1, 0, 10},
+                                         {"a", "b", 1, 20, Temporal::kForever},
+                                         {"a", "c", 2, 5, 15},
+                                         {"c", "a", 3, 0, Temporal::kForever}};
+        REQUIRE((g.EdgesInWindow(9, 21) == expected));
+        REQUIRE(g.EdgesInWindow(5, 5).empty());
+      }
+    }
+    WHEN("many versions share a start and differ only in their end") {
+      std::vector<Edge> expected{{"a", "b", 1, 0, 10}, {"a", "c", 2, 5, 15}};
+      for (auto end = 16; end < 60; ++end) {
+        REQUIRE(g.InsertEdge("a", "c", 2, 5, end));
+        expected.push_back({"a", "c", 2, 5, end});
+      }
+      THEN("they come back ordered by end as well") {
+        REQUIRE((g.OutgoingAsOf("a", 5) == expected));
+        expected.erase(expected.begin());
+        expected.push_back({"c", "a", 3, 0, Temporal::kForever});
+        REQUIRE((g.EdgesInWindow(10, 11) == expected));
+      }
+    }
+    WHEN("an open edge is ended") {
+      REQUIRE(g.EndEdge("c", "a", 3, 0, 8));
+      THEN("it is gone after its end, but still there before") {
+        REQUIRE(g.GetConnectedAsOf("c", 7) == std::vector<std::string>{"a"});
+        REQUIRE(g.GetConnectedAsOf("c", 8).empty());
+        REQUIRE(g.History().IsConnected("c", "a"));
+        REQUIRE(g.History().GetWeights("c", "a") ==
+                std::vector<Temporal::TimedWeight>{{3, 0, 8}});
+        REQUIRE(!g.EndEdge("c", "a", 3, 0, 9));
+      }
+    }
+    WHEN("a version is erased") {
+      REQUIRE(g.EraseEdge("a", "b", 1, 0, 10));
+      REQUIRE(!g.EraseEdge("a", "b", 1, 0, 10));
+      THEN("it is gone at every time") {
+        REQUIRE(g.GetConnectedAsOf("a", 0).empty());
+        REQUIRE(g.GetConnectedAsOf("a", 20) == std::vector<std::string>{"b"});
+        REQUIRE(g.IncomingAsOf("b", 5).empty());
+      }
+    }
+    WHEN("a node is deleted") {
+      REQUIRE(g.DeleteNode("a"));
+      THEN("every version touching it goes too") {
+        REQUIRE(!g.IsNode("a"));
+        REQUIRE(g.GetNodes() == std::vector<std::string>{"b", "c"});
+        REQUIRE(g.GetConnectedAsOf("c", 5).empty());
+        REQUIRE(g.IncomingAsOf("b", 5).empty());
+        REQUIRE(g.EdgesInWindow(0, Temporal::kForever).empty());
+        REQUIRE(!g.DeleteNode("a"));
+      }
+    }
+    WHEN("it is cleared") {
+      g.Clear();
+      THEN("nothing is left") {
+        REQUIRE(g.GetNodes().empty());
+        REQUIRE(g.EdgesInWindow(0, Temporal::kForever).empty());
+      }
+    }
+  }
+}
+
+SCENARIO("TemporalGraph errors") {
+  GIVEN("a graph with one node") {
+    Temporal g{};
+    g.InsertNode("a");
+    THEN("bad edges and missing nodes throw, leaving the graph alone") {
+      REQUIRE_THROWS_AS(g.InsertEdge("a", "a", 1, 5, 5), std::invalid_argument);
+      REQUIRE_THROWS_AS(g.InsertEdge("a", "a", 1, 5, 4), std::invalid_argument);
+      REQUIRE_THROWS_AS(g.InsertEdge("a", "b", 1, 0), std::runtime_error);
+      REQUIRE(g.InsertEdge("a", "a", 1, 0));
+      REQUIRE_THROWS_AS(g.EndEdge("a", "a", 1, 0, 0), std::invalid_argument);
+      REQUIRE_THROWS_AS(g.GetConnectedAsOf("b", 0), std::out_of_range);
+      REQUIRE_THROWS_AS(g.OutgoingAsOf("b", 0), std::out_of_range);
+      REQUIRE_THROWS_AS(g.IncomingAsOf("b", 0), std::out_of_range);
+      REQUIRE(g.GetConnectedAsOf("a", 0) == std::vector<std::string>{"a"});
+      REQUIRE(g.DeleteNode("a"));
+      REQUIRE(g.EdgesInWindow(0, 10).empty());
+    }
+  }
+}
+
+SCENARIO("as-of queries agree with checking every version") {
+  GIVEN("many random versions between a few nodes") {
+    gdwg::TemporalGraph<int, int> g{};
+    for (int v = 0; v < 8; ++v) {
+      g.InsertNode(v);
+    }
+    std::mt19937 rng{6771};
+    std::uniform_int_distribution<int> node{0, 7};
+    std::uniform_int_distribution<std::int64_t> time{0, 100};
+    std::vector<std::tuple<int, int, int, std::int64_t, std::int64_t>> versions{};
+    for (int i = 0; i < 300; ++i) {
+      const auto src = node(rng);
+      const auto dst = node(rng);
+      const auto start = time(rng);
+      const auto end = start + 1 + time(rng) / 4;
+      if (g.InsertEdge(src, dst, i % 3, start, end))
+        versions.emplace_back(src, dst, i % 3, start, end);
+    }
+    THEN("every node's neighbours match at every time") {
+      for (std::int64_t t = -1; t <= 130; ++t) {
+        for (int v = 0; v < 8; ++v) {
+          std::vector<int> expected{};
+          for (const auto& [src, dst, w, start, end] : versions) {
+            if (src == v && start <= t && t < end)
+              expected.push_back(dst);
+          }
+          std::sort(expected.begin(), expected.end());
+          expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+          REQUIRE(g.GetConnectedAsOf(v, t) == expected);
+        }
+      }
+    }
+  }
+}
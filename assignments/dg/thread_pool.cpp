@@ -0,0 +1,105 @@
+#include "assignments/dg/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+gdwg::ThreadPool::ThreadPool(std::size_t num_threads) {
+  /* hardware_concurrency is allowed to report 0 if it doesn't know */
+  num_threads = std::max<std::size_t>(num_threads, 1);
+  workers_.reserve(num_threads);
+  for (std::size_t i = 0; i < num_threads; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+gdwg::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+gdwg::ThreadPool& gdwg::ThreadPool::Default() {
+  static ThreadPool pool{};
+  return pool;
+}
+
+void gdwg::ThreadPool::WorkerLoop() {
+  std::unique_lock<std::mutex> lock{mutex_};
+  while (true) {
+    wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+    if (jobs_.empty())
+      return; /* only get here when stopping */
+    RunOneJob(lock);
+  }
+}
+
+bool gdwg::ThreadPool::RunOneJob(std::unique_lock<std::mutex>& lock) {
+  if (jobs_.empty())
+    return false;
+  auto job = std::move(jobs_.front());
+  jobs_.pop();
+  lock.unlock();
+  job();
+  lock.lock();
+  return true;
+}
+
+void gdwg::ThreadPool::ParallelFor(std::size_t n, const std::function<void(std::size_t)>& task) {
+  if (n == 0)
+    return;
+  /* every participant (helpers and the caller) pulls the next index until
+   * they run out, so uneven tasks balance themselves out */
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr error{};
+  std::mutex error_mutex{};
+  auto drain = [&] {
+    for (auto i = next++; i < n; i = next++) {
+      try {
+        task(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock{error_mutex};
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+  };
+
+  /* no point waking more helpers than there are tasks left for them */
+  const auto num_helpers = std::min(workers_.size(), n - 1);
+  std::size_t finished = 0;
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    for (std::size_t i = 0; i < num_helpers; ++i) {
+      jobs_.push([&] {
+        drain();
+        std::lock_guard<std::mutex> done_lock{mutex_};
+        ++finished;
+        wake_.notify_all();
+      });
+    }
+  }
+  wake_.notify_all();
+  drain();
+
+  /* the helpers reference this stack frame, so wait for every one of them. Run
+   * any queued jobs while waiting in case our helpers are stuck behind them */
+  std::unique_lock<std::mutex> lock{mutex_};
+  while (finished < num_helpers) {
+    if (!RunOneJob(lock))
+      wake_.wait(lock);
+  }
+  lock.unlock();
+  if (error)
+    std::rethrow_exception(error);
+}
@@ -0,0 +1,49 @@
+#ifndef ASSIGNMENTS_DG_THREAD_POOL_H_
+#define ASSIGNMENTS_DG_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace gdwg {
+
+/* a fixed set of worker threads that ParallelFor hands work out to. The thread
+ * calling ParallelFor works too (and keeps running queued jobs while it waits),
+ * so nested ParallelFor calls from inside a task can't deadlock the pool */
+class ThreadPool {
+ public:
+  /* ctors and dtor */
+  explicit ThreadPool(std::size_t num_threads = std::thread::hardware_concurrency());
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  /* methods */
+  /* number of worker threads, not counting the caller */
+  std::size_t Size() const { return workers_.size(); }
+  /* runs task(0) .. task(n - 1) across the pool and returns once they have all
+   * finished. If any task throws, the first exception is rethrown here */
+  void ParallelFor(std::size_t n, const std::function<void(std::size_t)>& task);
+
+  /* a process wide pool with one worker per hardware thread */
+  static ThreadPool& Default();
+
+ private:
+  void WorkerLoop();
+  /* pops and runs one queued job; lock must be held and is released while running */
+  bool RunOneJob(std::unique_lock<std::mutex>& lock);
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::queue<std::function<void()>> jobs_;
+  bool stopping_{false};
+};
+
+}  // namespace gdwg
+
+#endif  // ASSIGNMENTS_DG_THREAD_POOL_H_
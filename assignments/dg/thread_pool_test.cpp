@@ -0,0 +1,41 @@
+#include "assignments/dg/thread_pool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "catch.h"
+
+SCENARIO("ParallelFor") {
+  GIVEN("a pool with a few threads") {
+    gdwg::ThreadPool pool{3};
+    REQUIRE(pool.Size() == 3);
+    WHEN("we run a task per index") {
+      std::vector<int> hits(1000, 0);
+      pool.ParallelFor(hits.size(), [&](std::size_t i) { ++hits[i]; });
+      THEN("every index ran exactly once") { REQUIRE(hits == std::vector<int>(1000, 1)); }
+    }
+    WHEN("we run no tasks at all") {
+      pool.ParallelFor(0, [](std::size_t) { throw std::logic_error("shouldn't run"); });
+    }
+    WHEN("a task calls ParallelFor itself") {
+      std::atomic<int> total{0};
+      pool.ParallelFor(8, [&](std::size_t) { pool.ParallelFor(8, [&](std::size_t) { ++total; }); });
+      THEN("the nested calls finish rather than deadlock") { REQUIRE(total == 64); }
+    }
+    WHEN("a task throws") {
+      THEN("the exception comes out of ParallelFor and the pool is still usable") {
+        REQUIRE_THROWS_AS(pool.ParallelFor(10,
+                                           [](std::size_t i) {
+                                             if (i == 5)
+                                               throw std::runtime_error("task 5");
+                                           }),
+                          std::runtime_error);
+        std::atomic<int> total{0};
+        pool.ParallelFor(10, [&](std::size_t) { ++total; });
+        REQUIRE(total == 10);
+      }
+    }
+  }
+}
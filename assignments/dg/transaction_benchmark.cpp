@@ -0,0 +1,104 @@
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+
+namespace {
+
+/* num_edits small edits at random: a new edge, an edge erased, a node renamed
+ * to a new value, or a node deleted (taking its edges with it) */
+void Edit(gdwg::Graph<int, int>& g,
+          std::size_t num_nodes,
+          std::size_t num_edits,
+          std::mt19937& rng) {
+  std::uniform_int_distribution<int> node{0, static_cast<int>(num_nodes) - 1};
+  for (std::size_t i = 0; i < num_edits; ++i) {
+    const auto a = node(rng);
+    const auto b = node(rng);
+    if (!g.IsNode(a) || !g.IsNode(b))
+      continue;
+    switch (i % 4) {
+      case 0:
+        g.InsertEdge(a, b, static_cast<int>(i));
+        break;
+      case 1:
+        if (g.begin() != g.end())
+          g.erase(g.begin());
+        break;
+      case 2:
+        g.Replace(a, static_cast<int>(num_nodes + i));
+        break;
+      default:
+        g.DeleteNode(a);
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+/* undoing a few edits to a big graph: copying the graph before each batch and
+ * putting the copy back afterwards, against a Transaction rolled back, and what
+ * a committed transaction costs over editing without one.
+ * usage: transaction_benchmark [num_nodes (default 20000)] [num_edges (default 200000)]
+ *                              [num_edits (default 100)] [rounds (default 5)] */
+int main(int argc, char** argv) {
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 1, 20000);
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 2, 200000);
+  const auto num_edits = gdwg::benchmark::Arg(argc, argv, 3, 100);
+  const auto rounds = gdwg::benchmark::Arg(argc, argv, 4, 5);
+  const auto edges = gdwg::benchmark::RandomEdges(num_nodes, num_edges);
+  gdwg::Graph<int, int> g{edges.cbegin(), edges.cend()};
+  const auto original = g;
+  gdwg::benchmark::JsonResults json{};
+
+  std::mt19937 copy_rng{1};
+  gdwg::benchmark::Stopwatch copy_timer{};
+  for (std::size_t r = 0; r < rounds; ++r) {
+    auto saved = g;
+    Edit(g, num_nodes, num_edits, copy_rng);
+    g = std::move(saved);
+  }
+  const auto copy_seconds = copy_timer.Seconds();
+  gdwg::benchmark::Report("copy, edit, restore", rounds * num_edits, copy_seconds);
+  json.Add("undo", {{"method", "copy"}}, rounds * num_edits, copy_seconds);
+
+  std::mt19937 undo_rng{1};
+  gdwg::benchmark::Stopwatch undo_timer{};
+  for (std::size_t r = 0; r < rounds; ++r) {
+    gdwg::Graph<int, int>::Transaction transaction{g};
+    Edit(g, num_nodes, num_edits, undo_rng);
+    transaction.Rollback();
+  }
+  const auto undo_seconds = undo_timer.Seconds();
+  gdwg::benchmark::Report("Transaction, edit, Rollback", rounds * num_edits, undo_seconds);
+  json.Add("undo", {{"method", "transaction"}}, rounds * num_edits, undo_seconds);
+
+  auto plain = original;
+  std::mt19937 plain_rng{2};
+  gdwg::benchmark::Stopwatch plain_timer{};
+  Edit(plain, num_nodes, rounds * num_edits, plain_rng);
+  const auto plain_seconds = plain_timer.Seconds();
+  gdwg::benchmark::Report("edits without a transaction", rounds * num_edits, plain_seconds);
+  json.Add("edit", {{"method", "plain"}}, rounds * num_edits, plain_seconds);
+
+  auto committed = original;
+  std::mt19937 commit_rng{2};
+  gdwg::benchmark::Stopwatch commit_timer{};
+  {
+    gdwg::Graph<int, int>::Transaction transaction{committed};
+    Edit(committed, num_nodes, rounds * num_edits, commit_rng);
+    transaction.Commit();
+  }
+  const auto commit_seconds = commit_timer.Seconds();
+  gdwg::benchmark::Report("edits in a committed Transaction", rounds * num_edits, commit_seconds);
+  json.Add("edit", {{"method", "transaction"}}, rounds * num_edits, commit_seconds);
+
+  std::cout << "  (rolled back to the original: " << (g == original)
+            << ", committed same as plain: " << (committed == plain) << ")\n";
+  json.Write(std::cout);
+}
@@ -0,0 +1,209 @@
+#ifndef ASSIGNMENTS_DG_TRAVERSAL_H_
+#define ASSIGNMENTS_DG_TRAVERSAL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+
+/* lazy traversals of a Graph: ranges that work out the next node only when the
+ * iterator is advanced, so taking the first k nodes of a BFS costs about k nodes'
+ * worth of work, and traversal can be interleaved with anything else. Each one
+ * is a hand-written state machine (a queue or a stack of resume points) that
+ * reads the graph's nodes_ and adjacency sets in place, like the views do.
+ * Making a range sizes all of its state for every node of the graph up front,
+ * so stepping through it never allocates. The graph must outlive the range and
+ * mustn't change while it is being walked, and a range can only be walked once */
+namespace gdwg {
+namespace detail {
+
+/* a fixed capacity open addressing table from node pointer to a count, with
+ * room for every node of the graph it was made for */
+template <typename Node>
+class NodeTable {
+ public:
+  explicit NodeTable(std::size_t num_nodes);
+
+  /* true if node wasn't already in the table (and now is) */
+  bool Insert(const Node* node) { return Slot(node, 0).second; }
+  /* node's count, which starts at init the first time node is seen */
+  std::uint32_t& At(const Node* node, std::uint32_t init) {
+    return values_[Slot(node, init).first];
+  }
+
+ private:
+  /* node's slot, and whether it was just added */
+  std::pair<std::size_t, bool> Slot(const Node* node, std::uint32_t init);
+
+  std::vector<const Node*> keys_;
+  std::vector<std::uint32_t> values_;
+};
+
+/* the iterator of every traversal range: an input iterator that asks its range
+ * for the current node, and to move on */
+template <typename Range, typename N>
+class TraversalIterator {
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = N;
+  using reference = const N&;
+  using pointer = const N*;
+  using difference_type = std::ptrdiff_t;
+
+  TraversalIterator() = default;
+  explicit TraversalIterator(Range* range) : range_{range} {}
+
+  reference operator*() const { return range_->Current(); }
+  pointer operator->() const { return &range_->Current(); }
+  TraversalIterator& operator++() {
+    range_->Advance();
+    return *this;
+  }
+  void operator++(int) { ++(*this); }
+
+  /* end() has no range; any other iterator reaches it once its range is done */
+  friend bool operator==(const TraversalIterator& lhs, const TraversalIterator& rhs) {
+    return lhs.AtEnd() == rhs.AtEnd();
+  }
+  friend bool operator!=(const TraversalIterator& lhs, const TraversalIterator& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  bool AtEnd() const { return range_ == nullptr || range_->Done(); }
+
+  Range* range_{nullptr};
+};
+
+}  // namespace detail
+
+/* breadth first order from start: start, then the nodes one edge away (in
+ * order), then two edges away, and so on. Only nodes reachable from start come
+ * out */
+template <typename N, typename E>
+class BfsRange {
+ public:
+  using iterator = detail::TraversalIterator<BfsRange, N>;
+
+  /* ctors. Throw std::out_of_range if start isn't a node */
+  BfsRange(const Graph<N, E>& g, const N& start);
+  BfsRange(const BfsRange&) = delete;
+  BfsRange& operator=(const BfsRange&) = delete;
+
+  /* methods */
+  iterator begin() { return iterator{this}; }
+  iterator end() { return iterator{}; }
+  /* how many edges from start the current node is */
+  std::size_t Depth() const { return depth_; }
+
+ private:
+  using Node = typename Graph<N, E>::Node;
+  friend iterator;
+
+  const N& Current() const { return queue_[head_]->value_; }
+  bool Done() const { return head_ == queue_.size(); }
+  void Advance();
+
+  detail::NodeTable<Node> seen_;
+  /* every node seen so far, in order. The ones before head_ are done, and
+   * level_end_ is where the current node's depth ends */
+  std::vector<const Node*> queue_;
+  std::size_t head_{0};
+  std::size_t level_end_{1};
+  std::size_t depth_{0};
+};
+
+/* depth first preorder from start: each node comes out before the nodes it
+ * leads to, following each node's edges in order and backtracking once they are
+ * all seen. Only nodes reachable from start come out */
+template <typename N, typename E>
+class DfsRange {
+ public:
+  using iterator = detail::TraversalIterator<DfsRange, N>;
+
+  /* ctors. Throw std::out_of_range if start isn't a node */
+  DfsRange(const Graph<N, E>& g, const N& start);
+  DfsRange(const DfsRange&) = delete;
+  DfsRange& operator=(const DfsRange&) = delete;
+
+  /* methods */
+  iterator begin() { return iterator{this}; }
+  iterator end() { return iterator{}; }
+  /* how many edges deep the current node is on the path the search took */
+  std::size_t Depth() const { return stack_.size() - 1; }
+
+ private:
+  using Node = typename Graph<N, E>::Node;
+  using EdgeIt = typename Graph<N, E>::AdjacencySet::const_iterator;
+  friend iterator;
+
+  const N& Current() const { return stack_.back().first->value_; }
+  bool Done() const { return stack_.empty(); }
+  void Advance();
+
+  detail::NodeTable<Node> seen_;
+  /* the path from start to the current node, each with the next edge to try */
+  std::vector<std::pair<const Node*, EdgeIt>> stack_;
+};
+
+/* every node of the graph, each before all of the nodes its edges lead to
+ * (Kahn's algorithm). Nodes with no incoming edges are found by a lazy scan of
+ * nodes_ in order, and each node's remaining in-degree is only counted once an
+ * edge into it is followed. Advancing throws std::domain_error once the graph
+ * turns out to have a cycle, which can't happen before every node outside of it
+ * has come out (or making it, if every node is on or after a cycle) */
+template <typename N, typename E>
+class TopologicalRange {
+ public:
+  using iterator = detail::TraversalIterator<TopologicalRange, N>;
+
+  /* ctors */
+  explicit TopologicalRange(const Graph<N, E>& g);
+  TopologicalRange(const TopologicalRange&) = delete;
+  TopologicalRange& operator=(const TopologicalRange&) = delete;
+
+  /* methods */
+  iterator begin() { return iterator{this}; }
+  iterator end() { return iterator{}; }
+
+ private:
+  using Node = typename Graph<N, E>::Node;
+  using NodeIt = typename Graph<N, E>::NodeSet::const_iterator;
+  friend iterator;
+
+  const N& Current() const { return queue_[head_]->value_; }
+  bool Done() const { return head_ == queue_.size(); }
+  void Advance();
+  /* queues the next node of nodes_ with no incoming edges, if there is one */
+  void FindSource();
+  void CheckForCycle() const;
+
+  const Graph<N, E>& g_;
+  detail::NodeTable<Node> in_degree_;
+  std::vector<const Node*> queue_;
+  std::size_t head_{0};
+  NodeIt scan_;
+};
+
+/* so callers can write for (const auto& node : gdwg::Bfs(g, start)) */
+template <typename N, typename E>
+BfsRange<N, E> Bfs(const Graph<N, E>& g, const N& start) {
+  return {g, start};
+}
+template <typename N, typename E>
+DfsRange<N, E> Dfs(const Graph<N, E>& g, const N& start) {
+  return {g, start};
+}
+template <typename N, typename E>
+TopologicalRange<N, E> TopologicalOrder(const Graph<N, E>& g) {
+  return TopologicalRange<N, E>{g};
+}
+
+}  // namespace gdwg
+
+#include "assignments/dg/traversal.tpp"
+
+#endif  // ASSIGNMENTS_DG_TRAVERSAL_H_
@@ -0,0 +1,127 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <typename Node>
+gdwg::detail::NodeTable<Node>::NodeTable(std::size_t num_nodes) {
+  /* at most half full, so probes stay short */
+  std::size_t capacity = 2;
+  while (capacity < 2 * num_nodes)
+    capacity *= 2;
+  keys_.assign(capacity, nullptr);
+  values_.assign(capacity, 0);
+}
+
+template <typename Node>
+std::pair<std::size_t, bool> gdwg::detail::NodeTable<Node>::Slot(const Node* node,
+                                                                 std::uint32_t init) {
+  /* nodes are separate allocations, so the low bits are mostly alignment;
+   * multiplying mixes the rest into the high bits, and the product is folded down */
+  const auto mask = keys_.size() - 1;
+  const auto h = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(node)) *
+                 0x9e3779b97f4a7c15ull;
+  for (auto i = static_cast<std::size_t>(h ^ (h >> 32)) & mask;; i = (i + 1) & mask) {
+    if (keys_[i] == node)
+      return {i, false};
+    if (keys_[i] == nullptr) {
+      keys_[i] = node;
+      values_[i] = init;
+      return {i, true};
+    }
+  }
+}
+
+template <typename N, typename E>
+gdwg::BfsRange<N, E>::BfsRange(const Graph<N, E>& g, const N& start) : seen_{g.nodes_.size()} {
+  auto start_it = g.nodes_.find(start);
+  if (start_it == g.nodes_.end()) {
+    throw std::out_of_range("Cannot call Bfs if start doesn't exist in the graph");
+  }
+  queue_.reserve(g.nodes_.size());
+  queue_.push_back(start_it->get());
+  seen_.Insert(start_it->get());
+}
+
+template <typename N, typename E>
+void gdwg::BfsRange<N, E>::Advance() {
+  /* the current node's neighbours only join the queue once we move past it */
+  for (const auto& edge_wp : queue_[head_]->outgoing_) {
+    const Node* dst = edge_wp.lock()->dst_;
+    if (seen_.Insert(dst))
+      queue_.push_back(dst);
+  }
+  if (++head_ == level_end_) {
+    level_end_ = queue_.size();
+    ++depth_;
+  }
+}
+
+template <typename N, typename E>
+gdwg::DfsRange<N, E>::DfsRange(const Graph<N, E>& g, const N& start) : seen_{g.nodes_.size()} {
+  auto start_it = g.nodes_.find(start);
+  if (start_it == g.nodes_.end()) {
+    throw std::out_of_range("Cannot call Dfs if start doesn't exist in the graph");
+  }
+  stack_.reserve(g.nodes_.size());
+  stack_.emplace_back(start_it->get(), (*start_it)->outgoing_.cbegin());
+  seen_.Insert(start_it->get());
+}
+
+template <typename N, typename E>
+void gdwg::DfsRange<N, E>::Advance() {
+  /* resume the deepest node with an edge left to an unseen node, dropping the
+   * ones that have run out */
+  while (!stack_.empty()) {
+    auto& [node, edge_it] = stack_.back();
+    while (edge_it != node->outgoing_.cend()) {
+      const Node* dst = (edge_it++)->lock()->dst_;
+      if (seen_.Insert(dst)) {
+        stack_.emplace_back(dst, dst->outgoing_.cbegin());
+        return;
+      }
+    }
+    stack_.pop_back();
+  }
+}
+
+template <typename N, typename E>
+gdwg::TopologicalRange<N, E>::TopologicalRange(const Graph<N, E>& g)
+  : g_{g}, in_degree_{g.nodes_.size()}, scan_{g.nodes_.cbegin()} {
+  queue_.reserve(g.nodes_.size());
+  FindSource();
+  CheckForCycle();
+}
+
+template <typename N, typename E>
+void gdwg::TopologicalRange<N, E>::FindSource() {
+  for (; scan_ != g_.nodes_.cend(); ++scan_) {
+    if ((*scan_)->incoming_.empty()) {
+      queue_.push_back((scan_++)->get());
+      return;
+    }
+  }
+}
+
+template <typename N, typename E>
+void gdwg::TopologicalRange<N, E>::Advance() {
+  for (const auto& edge_wp : queue_[head_]->outgoing_) {
+    const Node* dst = edge_wp.lock()->dst_;
+    /* parallel edges each count towards the in-degree, and each take one off */
+    auto& remaining = in_degree_.At(dst, static_cast<std::uint32_t>(dst->incoming_.size()));
+    if (--remaining == 0)
+      queue_.push_back(dst);
+  }
+  if (++head_ == queue_.size())
+    FindSource();
+  CheckForCycle();
+}
+
+template <typename N, typename E>
+void gdwg::TopologicalRange<N, E>::CheckForCycle() const {
+  /* out of nodes with nothing left coming in, but some nodes never came out */
+  if (Done() && queue_.size() != g_.nodes_.size()) {
+    throw std::domain_error("Cannot call TopologicalOrder on a graph with a cycle");
+  }
+}
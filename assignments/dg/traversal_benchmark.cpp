@@ -0,0 +1,54 @@
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/traversal.h"
+
+/* times walking all of a lazy BFS, DFS and topological order of a random graph,
+ * against taking only the first k nodes of each, which should cost about k
+ * nodes' worth of work plus the O(num_nodes) setup. The topological order runs on
+ * the same edges pointed from the smaller node to the bigger, so it is a DAG.
+ * usage: traversal_benchmark [num_edges (default 1M)] [num_nodes (default num_edges / 10)]
+ *                            [k (default 100)] */
+int main(int argc, char** argv) {
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 1, 1000000);
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 2, num_edges / 10 + 1);
+  const auto k = gdwg::benchmark::Arg(argc, argv, 3, 100);
+
+  auto edges = gdwg::benchmark::RandomEdges(num_nodes, num_edges);
+  gdwg::Graph<int, int> g{edges.cbegin(), edges.cend()};
+  for (auto& [src, dst, w] : edges) {
+    std::tie(src, dst) = std::minmax(src, dst);
+  }
+  auto reflexive = [](const auto& edge) { return std::get<0>(edge) == std::get<1>(edge); };
+  edges.erase(std::remove_if(edges.begin(), edges.end(), reflexive), edges.end());
+  gdwg::Graph<int, int> dag{edges.cbegin(), edges.cend()};
+
+  /* walks up to limit nodes of the range, and reports how many came out */
+  std::size_t checksum = 0;
+  auto walk = [&checksum](const std::string& name, auto&& range, std::size_t limit,
+                          const gdwg::benchmark::Stopwatch& timer) {
+    std::size_t count = 0;
+    for (auto it = range.begin(); it != range.end() && count < limit; ++it) {
+      checksum += static_cast<std::size_t>(*it);
+      ++count;
+    }
+    gdwg::benchmark::Report(name, count, timer.Seconds());
+  };
+  const int start = std::get<0>(*g.begin());
+  for (auto limit : {num_nodes, k}) {
+    const auto suffix = limit == k ? ", first " + std::to_string(k) : ", all";
+    gdwg::benchmark::Stopwatch bfs_timer{};
+    walk("bfs" + suffix, gdwg::Bfs(g, start), limit, bfs_timer);
+    gdwg::benchmark::Stopwatch dfs_timer{};
+    walk("dfs" + suffix, gdwg::Dfs(g, start), limit, dfs_timer);
+    gdwg::benchmark::Stopwatch topological_timer{};
+    walk("topological order" + suffix, gdwg::TopologicalOrder(dag), limit, topological_timer);
+  }
+  std::cerr << "checksum " << checksum << "\n";
+}
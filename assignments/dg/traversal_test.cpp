@@ -0,0 +1,136 @@
+#include "assignments/dg/traversal.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+/* a small DAG with parallel edges, plus an unreachable node e:
+ * a -> b, a -> c (twice), b -> d, c -> d, and e -> d */
+std::vector<std::tuple<char, char, int>> traversal_edges{
+    {'a', 'b', 1}, {'a', 'c', 1}, {'a', 'c', 2}, {'b', 'd', 1}, {'c', 'd', 1}, {'e', 'd', 1}};
+
+SCENARIO("Lazy BFS and DFS") {
+  GIVEN("a small graph") {
+    gdwg::Graph<char, int> g{traversal_edges.begin(), traversal_edges.end()};
+    THEN("BFS goes level by level, in edge order, from start only") {
+      std::vector<char> seen{};
+      std::vector<std::size_t> depths{};
+      auto bfs = gdwg::Bfs(g, 'a');
+      for (const auto& node : bfs) {
+        seen.push_back(node);
+        depths.push_back(bfs.Depth());
+      }
+      REQUIRE(seen == std::vector<char>{'a', 'b', 'c', 'd'});
+      REQUIRE(depths == std::vector<std::size_t>{0, 1, 1, 2});
+    }
+    THEN("DFS follows the first edge all the way down before backtracking") {
+      std::vector<char> seen{};
+      std::vector<std::size_t> depths{};
+      auto dfs = gdwg::Dfs(g, 'a');
+      for (const auto& node : dfs) {
+        seen.push_back(node);
+        depths.push_back(dfs.Depth());
+      }
+      REQUIRE(seen == std::vector<char>{'a', 'b', 'd', 'c'});
+      REQUIRE(depths == std::vector<std::size_t>{0, 1, 2, 1});
+    }
+    THEN("stopping early leaves the rest unvisited") {
+      auto bfs = gdwg::Bfs(g, 'a');
+      auto it = bfs.begin();
+      REQUIRE(*it == 'a');
+      ++it;
+      REQUIRE(*it == 'b');
+      REQUIRE(it != bfs.end());
+    }
+    THEN("a node with no edges out is the whole traversal") {
+      auto dfs = gdwg::Dfs(g, 'd');
+      REQUIRE(std::distance(dfs.begin(), dfs.end()) == 1);
+    }
+    THEN("starting from a node that doesn't exist throws") {
+      REQUIRE_THROWS_AS(gdwg::Bfs(g, 'z'), std::out_of_range);
+      REQUIRE_THROWS_AS(gdwg::Dfs(g, 'z'), std::out_of_range);
+    }
+  }
+  GIVEN("a graph with a cycle") {
+    std::vector<std::tuple<std::string, std::string, int>> edges{
+        {"x", "y", 1}, {"y", "z", 1}, {"z", "x", 1}, {"z", "z", 1}};
+    gdwg::Graph<std::string, int> g{edges.begin(), edges.end()};
+    THEN("every node comes out once") {
+      auto bfs = gdwg::Bfs(g, std::string{"y"});
+      REQUIRE(std::vector<std::string>(bfs.begin(), bfs.end()) ==
+              std::vector<std::string>{"y", "z", "x"});
+      auto dfs = gdwg::Dfs(g, std::string{"z"});
+      REQUIRE(std::vector<std::string>(dfs.begin(), dfs.end()) ==
+              std::vector<std::string>{"z", "x", "y"});
+    }
+  }
+}
+
+SCENARIO("Lazy topological order") {
+  GIVEN("a DAG") {
+    gdwg::Graph<char, int> g{traversal_edges.begin(), traversal_edges.end()};
+    THEN("every node comes out after everything with an edge into it") {
+      auto order = gdwg::TopologicalOrder(g);
+      REQUIRE(std::vector<char>(order.begin(), order.end()) ==
+              std::vector<char>{'a', 'b', 'c', 'e', 'd'});
+    }
+  }
+  GIVEN("a bigger random DAG") {
+    std::mt19937 rng{38};
+    std::vector<std::tuple<int, int, int>> edges{};
+    for (int i = 0; i < 2000; ++i) {
+      int src = static_cast<int>(rng() % 300);
+      int dst = static_cast<int>(rng() % 300);
+      if (src != dst)
+        edges.emplace_back(std::min(src, dst), std::max(src, dst), i);
+    }
+    gdwg::Graph<int, int> g{edges.begin(), edges.end()};
+    THEN("the order has every node once, and every edge points forwards") {
+      auto order = gdwg::TopologicalOrder(g);
+      std::vector<int> seen(order.begin(), order.end());
+      REQUIRE(seen.size() == g.GetNodes().size());
+      std::vector<std::size_t> position(300, 0);
+      for (std::size_t i = 0; i < seen.size(); ++i) {
+        position[static_cast<std::size_t>(seen[i])] = i;
+      }
+      for (const auto& [src, dst, w] : g) {
+        REQUIRE(position[static_cast<std::size_t>(src)] < position[static_cast<std::size_t>(dst)]);
+      }
+      auto bfs = gdwg::Bfs(g, seen.front());
+      auto dfs = gdwg::Dfs(g, seen.front());
+      REQUIRE(std::distance(bfs.begin(), bfs.end()) == std::distance(dfs.begin(), dfs.end()));
+    }
+  }
+  GIVEN("a graph with a cycle after a few other nodes") {
+    std::vector<std::tuple<char, char, int>> edges{
+        {'a', 'b', 1}, {'b', 'c', 1}, {'c', 'd', 1}, {'d', 'c', 1}, {'e', 'a', 1}};
+    gdwg::Graph<char, int> g{edges.begin(), edges.end()};
+    THEN("the nodes before the cycle come out, then advancing throws") {
+      auto order = gdwg::TopologicalOrder(g);
+      auto it = order.begin();
+      REQUIRE(*it == 'e');
+      ++it;
+      REQUIRE(*it == 'a');
+      ++it;
+      REQUIRE(*it == 'b');
+      REQUIRE_THROWS_AS(++it, std::domain_error);
+    }
+  }
+  GIVEN("a graph that is all cycle") {
+    std::vector<std::tuple<char, char, int>> edges{{'a', 'a', 1}};
+    gdwg::Graph<char, int> g{edges.begin(), edges.end()};
+    REQUIRE_THROWS_AS(gdwg::TopologicalOrder(g), std::domain_error);
+  }
+  GIVEN("an empty graph") {
+    gdwg::Graph<char, int> g{};
+    auto order = gdwg::TopologicalOrder(g);
+    REQUIRE(order.begin() == order.end());
+  }
+}
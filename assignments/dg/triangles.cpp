@@ -0,0 +1,53 @@
+#include "assignments/dg/triangles.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+std::size_t gdwg::SortedIntersectionSize(const std::uint32_t* a,
+                                         std::size_t a_size,
+                                         const std::uint32_t* b,
+                                         std::size_t b_size) {
+  std::size_t i = 0;
+  std::size_t j = 0;
+  std::size_t count = 0;
+#ifdef __SSE2__
+  /* compare a block of 4 from a against all 4 rotations of a block of 4 from b.
+   * Values are unique within each array, so each lane matches at most once. Then
+   * move on whichever block ends lower (or both, if they end on the same value) */
+  while (i + 4 <= a_size && j + 4 <= b_size) {
+    const auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+    const auto rot1 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    const auto rot2 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2));
+    const auto rot3 = _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3));
+    const auto matches =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, rot1)),
+                     _mm_or_si128(_mm_cmpeq_epi32(va, rot2), _mm_cmpeq_epi32(va, rot3)));
+    count += static_cast<std::size_t>(
+        __builtin_popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(matches)))));
+    const auto a_last = a[i + 3];
+    const auto b_last = b[j + 3];
+    if (a_last <= b_last)
+      i += 4;
+    if (b_last <= a_last)
+      j += 4;
+  }
+#endif
+  /* plain merge for whatever is left (or everything, without SSE2) */
+  while (i < a_size && j < b_size) {
+    if (a[i] < b[j]) {
+      ++i;
+    } else if (b[j] < a[i]) {
+      ++j;
+    } else {
+      ++count;
+      ++i;
+      ++j;
+    }
+  }
+  return count;
+}
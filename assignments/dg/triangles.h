@@ -0,0 +1,52 @@
+#ifndef ASSIGNMENTS_DG_TRIANGLES_H_
+#define ASSIGNMENTS_DG_TRIANGLES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+
+namespace gdwg {
+
+/* triangle counts and local clustering coefficients of the undirected simple graph
+ * underneath a Graph: edge direction, weights, parallel edges and reflexive edges
+ * are all ignored, so u and v are neighbours if there is any edge between them */
+template <typename N>
+struct TriangleStats {
+  std::uint64_t total_triangles{0};
+  /* the rest are per node, in the graph's node order */
+  std::vector<N> nodes;
+  std::vector<std::uint64_t> triangles;
+  /* triangles through v over the number of pairs of v's neighbours (0 when v has
+   * fewer than two neighbours) */
+  std::vector<double> clustering;
+  /* the mean of clustering over every node */
+  double average_clustering{0.0};
+};
+
+/* the number of values in both of the strictly increasing arrays a and b. Uses
+ * SSE2 to compare 4 x 4 values at a time where it is available */
+std::size_t SortedIntersectionSize(const std::uint32_t* a,
+                                   std::size_t a_size,
+                                   const std::uint32_t* b,
+                                   std::size_t b_size);
+
+/* relabels nodes by (degree, id) and points every edge from its lower to its
+ * higher ranked end, so each triangle is found once and hubs only ever have
+ * their short "upward" lists intersected. Nodes are processed in parallel on pool */
+template <typename N, typename E>
+TriangleStats<N> CountTriangles(const CsrSnapshot<N, E>& g,
+                                ThreadPool& pool = ThreadPool::Default());
+template <typename N, typename E>
+TriangleStats<N> CountTriangles(const Graph<N, E>& g, ThreadPool& pool = ThreadPool::Default()) {
+  return CountTriangles(CsrSnapshot<N, E>{g}, pool);
+}
+
+}  // namespace gdwg
+
+#include "assignments/dg/triangles.tpp"
+
+#endif  // ASSIGNMENTS_DG_TRIANGLES_H_
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "assignments/dg/parallel_sort.h"
+
+namespace gdwg {
+namespace detail {
+
+/* runs func(v) for every v in [0, n), in many more chunks than threads so a few
+ * high degree nodes don't leave the other threads idle */
+template <typename F>
+void ForEachNodeInParallel(std::size_t n, ThreadPool& pool, F func) {
+  const auto num_chunks = std::min(n, 16 * (pool.Size() + 1));
+  pool.ParallelFor(num_chunks, [&](std::size_t chunk) {
+    const auto first = n * chunk / num_chunks;
+    const auto last = n * (chunk + 1) / num_chunks;
+    for (auto v = first; v < last; ++v) {
+      func(static_cast<std::uint32_t>(v));
+    }
+  });
+}
+
+/* calls func(u) once for every neighbour u != v of v, in increasing order, by
+ * merging v's (sorted, possibly repeated) outgoing and incoming targets */
+template <typename N, typename E, typename F>
+void ForEachUndirectedNeighbour(const CsrSnapshot<N, E>& g,
+                                const CsrSnapshot<N, E>& t,
+                                std::uint32_t v,
+                                F func) {
+  auto out = g.Targets().data() + g.Offsets()[v];
+  const auto out_end = g.Targets().data() + g.Offsets()[v + 1];
+  auto in = t.Targets().data() + t.Offsets()[v];
+  const auto in_end = t.Targets().data() + t.Offsets()[v + 1];
+  bool any = false;
+  std::uint32_t last = 0;
+  while (out != out_end || in != in_end) {
+    std::uint32_t u;
+    if (in == in_end || (out != out_end && *out < *in)) {
+      u = *out++;
+    } else {
+      u = *in++;
+    }
+    if (u != v && (!any || u != last))
+      func(u);
+    any = true;
+    last = u;
+  }
+}
+
+}  // namespace detail
+}  // namespace gdwg
+
+template <typename N, typename E>
+gdwg::TriangleStats<N> gdwg::CountTriangles(const CsrSnapshot<N, E>& g, ThreadPool& pool) {
+  const auto t = g.Transposed();
+  const auto n = g.NumNodes();
+
+  /* undirected degrees, then rank nodes by (degree, id) */
+  std::vector<std::uint32_t> degree(n, 0);
+  detail::ForEachNodeInParallel(n, pool, [&](std::uint32_t v) {
+    detail::ForEachUndirectedNeighbour(g, t, v, [&](std::uint32_t) { ++degree[v]; });
+  });
+  std::vector<std::uint32_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  ParallelSort(
+      order.begin(), order.end(),
+      [&degree](std::uint32_t a, std::uint32_t b) {
+        return degree[a] < degree[b] || (degree[a] == degree[b] && a < b);
+      },
+      pool);
+  std::vector<std::uint32_t> rank(n);
+  for (std::uint32_t r = 0; r < n; ++r) {
+    rank[order[r]] = r;
+  }
+
+  /* split every node's neighbours into the ones ranked above it (up) and below it
+   * (down), both by rank id. Each edge is in exactly one up list */
+  std::vector<std::size_t> up_offsets(n + 1, 0);
+  std::vector<std::size_t> down_offsets(n + 1, 0);
+  detail::ForEachNodeInParallel(n, pool, [&](std::uint32_t v) {
+    std::size_t up = 0;
+    detail::ForEachUndirectedNeighbour(g, t, v, [&](std::uint32_t u) { up += rank[v] < rank[u]; });
+    up_offsets[rank[v] + 1] = up;
+    down_offsets[rank[v] + 1] = degree[v] - up;
+  });
+  std::partial_sum(up_offsets.begin(), up_offsets.end(), up_offsets.begin());
+  std::partial_sum(down_offsets.begin(), down_offsets.end(), down_offsets.begin());
+  std::vector<std::uint32_t> up(up_offsets[n]);
+  std::vector<std::uint32_t> down(down_offsets[n]);
+  detail::ForEachNodeInParallel(n, pool, [&](std::uint32_t v) {
+    const auto r = rank[v];
+    auto up_next = up_offsets[r];
+    auto down_next = down_offsets[r];
+    detail::ForEachUndirectedNeighbour(g, t, v, [&](std::uint32_t u) {
+      if (r < rank[u]) {
+        up[up_next++] = rank[u];
+      } else {
+        down[down_next++] = rank[u];
+      }
+    });
+    std::sort(up.begin() + static_cast<std::ptrdiff_t>(up_offsets[r]),
+              up.begin() + static_cast<std::ptrdiff_t>(up_offsets[r + 1]));
+    std::sort(down.begin() + static_cast<std::ptrdiff_t>(down_offsets[r]),
+              down.begin() + static_cast<std::ptrdiff_t>(down_offsets[r + 1]));
+  });
+  auto up_list = [&](std::uint32_t r) { return up.data() + up_offsets[r]; };
+  auto up_size = [&](std::uint32_t r) { return up_offsets[r + 1] - up_offsets[r]; };
+
+  /* a triangle a < b < c (by rank) is found once, from edge a -> b, as the c in
+   * both up(a) and up(b). That credits a and b; c is credited by counting, for each of
+   * its down neighbours a, how many of up(a) are also in down(c) */
+  std::vector<std::uint64_t> lowest(n, 0);
+  std::vector<std::uint64_t> middle(n, 0);
+  std::vector<std::uint64_t> highest(n, 0);
+  std::vector<std::uint32_t> per_edge(up.size(), 0);
+  detail::ForEachNodeInParallel(n, pool, [&](std::uint32_t a) {
+    std::uint64_t count = 0;
+    for (auto e = up_offsets[a]; e < up_offsets[a + 1]; ++e) {
+      const auto b = up[e];
+      per_edge[e] = static_cast<std::uint32_t>(
+          SortedIntersectionSize(up_list(a), up_size(a), up_list(b), up_size(b)));
+      count += per_edge[e];
+    }
+    lowest[a] = count;
+  });
+  for (std::size_t e = 0; e < up.size(); ++e) {
+    middle[up[e]] += per_edge[e];
+  }
+  detail::ForEachNodeInParallel(n, pool, [&](std::uint32_t c) {
+    const auto down_first = down.data() + down_offsets[c];
+    const auto down_size = down_offsets[c + 1] - down_offsets[c];
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i < down_size; ++i) {
+      count += SortedIntersectionSize(up_list(down_first[i]), up_size(down_first[i]), down_first,
+                                      down_size);
+    }
+    highest[c] = count;
+  });
+
+  TriangleStats<N> stats{};
+  stats.nodes = g.Nodes();
+  stats.triangles.resize(n);
+  stats.clustering.resize(n);
+  double clustering_sum = 0.0;
+  for (std::uint32_t v = 0; v < n; ++v) {
+    const auto r = rank[v];
+    stats.triangles[v] = lowest[r] + middle[r] + highest[r];
+    stats.total_triangles += lowest[r];
+    const double d = degree[v];
+    if (degree[v] >= 2)
+      stats.clustering[v] = 2.0 * static_cast<double>(stats.triangles[v]) / (d * (d - 1));
+    clustering_sum += stats.clustering[v];
+  }
+  if (n > 0)
+    stats.average_clustering = clustering_sum / static_cast<double>(n);
+  return stats;
+}
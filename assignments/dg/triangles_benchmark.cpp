@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/csr_snapshot.h"
+#include "assignments/dg/graph.h"
+#include "assignments/dg/triangles.h"
+
+namespace {
+
+/* counts by output iterator, so std::set_intersection has nothing to allocate */
+struct Counter {
+  using iterator_category = std::output_iterator_tag;
+  using value_type = void;
+  using difference_type = void;
+  using pointer = void;
+  using reference = void;
+
+  Counter& operator*() { return *this; }
+  Counter& operator++() { return *this; }
+  Counter& operator=(std::uint32_t) {
+    ++*count;
+    return *this;
+  }
+  std::size_t* count;
+};
+
+}  // namespace
+
+/* times SortedIntersectionSize against std::set_intersection on sorted lists of
+ * 1000 ids, then CountTriangles on a random graph.
+ * usage: triangles_benchmark [num_edges (default 10M)] [num_nodes (default num_edges / 10)] */
+int main(int argc, char** argv) {
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 1, 10000000);
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 2, num_edges / 10 + 1);
+
+  const std::size_t num_lists = 2000;
+  const std::size_t list_size = 1000;
+  std::mt19937 rng{6771};
+  std::vector<std::vector<std::uint32_t>> lists(num_lists);
+  for (auto& list : lists) {
+    for (std::size_t i = 0; i < list_size; ++i) {
+      list.push_back(static_cast<std::uint32_t>(rng() % (4 * list_size)));
+    }
+    std::sort(list.begin(), list.end());
+    list.erase(std::unique(list.begin(), list.end()), list.end());
+  }
+  std::size_t simd_common = 0;
+  gdwg::benchmark::Stopwatch simd_timer{};
+  for (std::size_t i = 0; i + 1 < num_lists; ++i) {
+    simd_common += gdwg::SortedIntersectionSize(lists[i].data(), lists[i].size(),
+                                                lists[i + 1].data(), lists[i + 1].size());
+  }
+  gdwg::benchmark::Report("SortedIntersectionSize", num_lists * list_size, simd_timer.Seconds());
+  std::size_t std_common = 0;
+  gdwg::benchmark::Stopwatch std_timer{};
+  for (std::size_t i = 0; i + 1 < num_lists; ++i) {
+    std::set_intersection(lists[i].begin(), lists[i].end(), lists[i + 1].begin(),
+                          lists[i + 1].end(), Counter{&std_common});
+  }
+  gdwg::benchmark::Report("std::set_intersection", num_lists * list_size, std_timer.Seconds());
+  if (simd_common != std_common) {
+    std::cerr << "intersection mismatch: " << simd_common << " != " << std_common << "\n";
+    return 1;
+  }
+
+  const auto edges = gdwg::benchmark::RandomEdges(num_nodes, num_edges);
+  gdwg::Graph<int, int> g{edges.cbegin(), edges.cend()};
+  gdwg::CsrSnapshot<int, int> csr{g};
+  gdwg::benchmark::Stopwatch count_timer{};
+  const auto stats = gdwg::CountTriangles(csr);
+  gdwg::benchmark::Report("CountTriangles", csr.NumEdges(), count_timer.Seconds());
+  std::cout << "triangles: " << stats.total_triangles
+            << ", average clustering: " << stats.average_clustering << "\n";
+}
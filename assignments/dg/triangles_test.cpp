@@ -0,0 +1,100 @@
+#include "assignments/dg/triangles.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "assignments/dg/thread_pool.h"
+#include "catch.h"
+
+SCENARIO("SortedIntersectionSize") {
+  std::mt19937 rng{3};
+  /* sizes either side of the 4 wide blocks, and values dense enough to collide */
+  for (auto a_size : {0, 1, 3, 4, 5, 8, 17, 100}) {
+    for (auto b_size : {0, 2, 4, 7, 16, 33}) {
+      std::set<std::uint32_t> a_set{};
+      std::set<std::uint32_t> b_set{};
+      while (a_set.size() < static_cast<std::size_t>(a_size))
+        a_set.insert(rng() % 150);
+      while (b_set.size() < static_cast<std::size_t>(b_size))
+        b_set.insert(rng() % 150);
+      std::vector<std::uint32_t> a{a_set.begin(), a_set.end()};
+      std::vector<std::uint32_t> b{b_set.begin(), b_set.end()};
+      std::vector<std::uint32_t> common{};
+      std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(common));
+      REQUIRE(gdwg::SortedIntersectionSize(a.data(), a.size(), b.data(), b.size()) ==
+              common.size());
+      REQUIRE(gdwg::SortedIntersectionSize(b.data(), b.size(), a.data(), a.size()) ==
+              common.size());
+    }
+  }
+}
+
+SCENARIO("CountTriangles") {
+  GIVEN("a complete graph on 4 nodes, with a tail, a self loop and edges both ways") {
+    std::vector<std::tuple<char, char, int>> edges{
+        {'a', 'b', 1}, {'b', 'a', 1}, {'a', 'c', 1}, {'a', 'd', 1}, {'b', 'c', 1},
+        {'b', 'c', 2}, {'d', 'b', 1}, {'c', 'd', 1}, {'d', 'e', 1}, {'e', 'e', 1}};
+    gdwg::Graph<char, int> g{edges.begin(), edges.end()};
+    gdwg::ThreadPool pool{2};
+    auto stats = gdwg::CountTriangles(g, pool);
+    THEN("every triangle is counted once, whichever way its edges point") {
+      REQUIRE(stats.total_triangles == 4);
+      REQUIRE(stats.nodes == g.GetNodes());
+      REQUIRE(stats.triangles == std::vector<std::uint64_t>{3, 3, 3, 3, 0});
+    }
+    THEN("the clustering coefficients only count distinct neighbours") {
+      REQUIRE(stats.clustering[0] == Approx(1.0));
+      REQUIRE(stats.clustering[3] == Approx(0.5));
+      REQUIRE(stats.clustering[4] == Approx(0.0));
+      REQUIRE(stats.average_clustering == Approx(3.5 / 5));
+    }
+  }
+  GIVEN("a graph with no nodes") {
+    gdwg::Graph<int, int> g{};
+    auto stats = gdwg::CountTriangles(g);
+    REQUIRE(stats.total_triangles == 0);
+    REQUIRE(stats.nodes.empty());
+  }
+  GIVEN("a random graph") {
+    const int n = 60;
+    std::mt19937 rng{8};
+    std::vector<std::tuple<int, int, int>> edges{};
+    std::vector<std::vector<bool>> adjacent(n, std::vector<bool>(n, false));
+    for (int i = 0; i < 600; ++i) {
+      const int src = static_cast<int>(rng() % n);
+      const int dst = static_cast<int>(rng() % n);
+      edges.emplace_back(src, dst, i);
+      adjacent[src][dst] = adjacent[dst][src] = src != dst;
+    }
+    gdwg::Graph<int, int> g{edges.begin(), edges.end()};
+    gdwg::ThreadPool pool{3};
+    auto stats = gdwg::CountTriangles(g, pool);
+    THEN("it matches checking every triple") {
+      std::uint64_t total = 0;
+      std::vector<std::uint64_t> per_node(n, 0);
+      for (int a = 0; a < n; ++a) {
+        for (int b = a + 1; b < n; ++b) {
+          for (int c = b + 1; c < n; ++c) {
+            if (adjacent[a][b] && adjacent[b][c] && adjacent[a][c]) {
+              ++total;
+              ++per_node[a];
+              ++per_node[b];
+              ++per_node[c];
+            }
+          }
+        }
+      }
+      REQUIRE(stats.total_triangles == total);
+      /* every node got at least one edge, so node ids line up with positions */
+      REQUIRE(stats.nodes.size() == static_cast<std::size_t>(n));
+      REQUIRE(stats.triangles == per_node);
+    }
+  }
+}
@@ -0,0 +1,34 @@
+#include "assignments/dg/union_find.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
+gdwg::UnionFind::UnionFind(std::size_t n) : parent_(n), size_(n, 1), num_sets_{n} {
+  /* everything starts off as its own set */
+  std::iota(parent_.begin(), parent_.end(), 0);
+}
+
+std::uint32_t gdwg::UnionFind::Find(std::uint32_t x) {
+  /* path halving: point every other node on the way up at its grandparent */
+  while (parent_[x] != x) {
+    parent_[x] = parent_[parent_[x]];
+    x = parent_[x];
+  }
+  return x;
+}
+
+bool gdwg::UnionFind::Union(std::uint32_t a, std::uint32_t b) {
+  a = Find(a);
+  b = Find(b);
+  if (a == b)
+    return false;
+  /* hang the smaller tree under the bigger one to keep trees shallow */
+  if (size_[a] < size_[b])
+    std::swap(a, b);
+  parent_[b] = a;
+  size_[a] += size_[b];
+  --num_sets_;
+  return true;
+}
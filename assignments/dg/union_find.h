@@ -0,0 +1,33 @@
+#ifndef ASSIGNMENTS_DG_UNION_FIND_H_
+#define ASSIGNMENTS_DG_UNION_FIND_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gdwg {
+
+/* disjoint sets over the dense ids 0..n-1, with union by size and path halving,
+ * so a run of m operations is effectively O(m) */
+class UnionFind {
+ public:
+  /* ctors */
+  explicit UnionFind(std::size_t n);
+
+  /* methods */
+  std::uint32_t Find(std::uint32_t x);
+  /* merges the sets holding a and b, returning false if they were already one set */
+  bool Union(std::uint32_t a, std::uint32_t b);
+  bool Connected(std::uint32_t a, std::uint32_t b) { return Find(a) == Find(b); }
+  std::size_t NumSets() const { return num_sets_; }
+  std::size_t Size() const { return parent_.size(); }
+
+ private:
+  std::vector<std::uint32_t> parent_;
+  std::vector<std::uint32_t> size_;
+  std::size_t num_sets_;
+};
+
+}  // namespace gdwg
+
+#endif  // ASSIGNMENTS_DG_UNION_FIND_H_
@@ -0,0 +1,49 @@
+#ifndef ASSIGNMENTS_DG_VARINT_H_
+#define ASSIGNMENTS_DG_VARINT_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace gdwg {
+namespace detail {
+
+/* LEB128 style varints, as every binary format here writes its integers
+ * (CompressedGraph's neighbour lists, EncodePatch and what builds on it): 7 bits
+ * per byte, lowest first, high bit set on every byte but the last */
+inline void PutVarint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(v));
+}
+
+/* the most bytes a 64 bit value takes */
+constexpr int kMaxVarintBytes = 10;
+
+/* reads a varint into v, taking its bytes one at a time from next_byte() (which
+ * is where a reader of untrusted bytes checks for the end). Returns false if
+ * there are still more after kMaxVarintBytes */
+template <typename NextByte>
+bool GetVarint(NextByte next_byte, std::uint64_t& v) {
+  v = 0;
+  for (int shift = 0; shift < 7 * kMaxVarintBytes; shift += 7) {
+    const std::uint8_t byte = next_byte();
+    v |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+/* reads the varint at pos, which has to be a whole one, and moves pos past it */
+inline std::uint64_t GetVarint(const std::uint8_t*& pos) {
+  std::uint64_t v = 0;
+  GetVarint([&pos] { return *pos++; }, v);
+  return v;
+}
+
+}  // namespace detail
+}  // namespace gdwg
+
+#endif  // ASSIGNMENTS_DG_VARINT_H_
@@ -0,0 +1,245 @@
+#ifndef ASSIGNMENTS_DG_VIEWS_H_
+#define ASSIGNMENTS_DG_VIEWS_H_
+
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+
+/* read-only views over a Graph. A view holds a reference to the graph and reads
+ * its nodes_, edges_ and adjacency sets in place, so making one is O(1) and
+ * IsNode, IsConnected, find and iteration allocate nothing. The graph (and the
+ * view, for iterators) must outlive them, and any edit to the graph shows up
+ * in every view of it straight away */
+namespace gdwg {
+namespace detail {
+
+/* steps through a Graph's edges, skipping any that keep_ says to leave out */
+template <typename N, typename E, typename Keep>
+class FilteredEdgeIterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = std::tuple<N, N, E>;
+  using reference = std::tuple<const N&, const N&, const E&>;
+  using pointer = void;
+  using difference_type = int;
+
+  FilteredEdgeIterator() = default;
+  FilteredEdgeIterator(typename Graph<N, E>::const_iterator it,
+                       typename Graph<N, E>::const_iterator last,
+                       const Keep* keep)
+    : it_{it}, last_{last}, keep_{keep} {
+    while (it_ != last_ && !Kept())
+      ++it_;
+  }
+
+  reference operator*() const { return *it_; }
+  FilteredEdgeIterator& operator++() {
+    do {
+      ++it_;
+    } while (it_ != last_ && !Kept());
+    return *this;
+  }
+  FilteredEdgeIterator operator++(int) {
+    auto copy{*this};
+    ++(*this);
+    return copy;
+  }
+  /* like any bidirectional iterator, there must be a kept edge before this one */
+  FilteredEdgeIterator& operator--() {
+    do {
+      --it_;
+    } while (!Kept());
+    return *this;
+  }
+  FilteredEdgeIterator operator--(int) {
+    auto copy{*this};
+    --(*this);
+    return copy;
+  }
+
+  friend bool operator==(const FilteredEdgeIterator& lhs, const FilteredEdgeIterator& rhs) {
+    return lhs.it_ == rhs.it_;
+  }
+  friend bool operator!=(const FilteredEdgeIterator& lhs, const FilteredEdgeIterator& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  bool Kept() const {
+    const auto& [src, dst, w] = *it_;
+    return (*keep_)(src, dst, w);
+  }
+
+  typename Graph<N, E>::const_iterator it_;
+  typename Graph<N, E>::const_iterator last_;
+  const Keep* keep_{nullptr};
+};
+
+}  // namespace detail
+
+/* the transpose of a graph: every edge src -> dst shows up as dst -> src. It walks
+ * each node's incoming_ set, which is already ordered by the original src, so edges
+ * still come out ordered by (src, dst, w) */
+template <typename N, typename E>
+class ReverseView {
+ public:
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::tuple<N, N, E>;
+    using reference = std::tuple<const N&, const N&, const E&>;
+    using pointer = void;
+    using difference_type = int;
+
+    const_iterator() = default;
+
+    reference operator*() const;
+    const_iterator& operator++();
+    const_iterator operator++(int) {
+      auto copy{*this};
+      ++(*this);
+      return copy;
+    }
+    const_iterator& operator--();
+    const_iterator operator--(int) {
+      auto copy{*this};
+      --(*this);
+      return copy;
+    }
+
+    /* like the graph's original iterator, the edge iterator only matters when
+     * the node iterator isn't the end */
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+      return lhs.node_it_ == rhs.node_it_ &&
+             (lhs.node_it_ == lhs.node_end_it_ || lhs.edge_it_ == rhs.edge_it_);
+    }
+    friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+      return !(lhs == rhs);
+    }
+
+   private:
+    typename Graph<N, E>::NodeSet::const_iterator node_it_;
+    typename Graph<N, E>::AdjacencySet::const_iterator edge_it_;
+    typename Graph<N, E>::NodeSet::const_iterator node_end_it_;
+    /* what edge_it_ points at, locked once per move rather than on every
+     * dereference. edges_ owns the edge, so the raw pointer stays good */
+    const typename Graph<N, E>::Edge* edge_{nullptr};
+
+    friend class ReverseView;
+    const_iterator(const decltype(node_it_)& node_it,
+                   const decltype(edge_it_)& edge_it,
+                   const decltype(node_end_it_)& node_end_it)
+      : node_it_{node_it}, edge_it_{edge_it}, node_end_it_{node_end_it} {
+      Load();
+    }
+    void Load() { edge_ = node_it_ == node_end_it_ ? nullptr : edge_it_->lock().get(); }
+  };
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /* ctors */
+  explicit ReverseView(const Graph<N, E>& g) : g_{g} {}
+
+  /* methods, with the same meaning (and exceptions) as on Graph */
+  bool IsNode(const N& val) const { return g_.IsNode(val); }
+  bool IsConnected(const N& src, const N& dst) const;
+  std::vector<N> GetNodes() const { return g_.GetNodes(); }
+  std::vector<N> GetConnected(const N& src) const;
+  std::vector<E> GetWeights(const N& src, const N& dst) const;
+  const_iterator find(const N& src, const N& dst, const E& w) const;
+
+  /* iterator methods */
+  const_iterator cbegin() const;
+  const_iterator cend() const { return {g_.nodes_.cend(), {}, g_.nodes_.cend()}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+  const_reverse_iterator crbegin() const { return const_reverse_iterator{cend()}; }
+  const_reverse_iterator crend() const { return const_reverse_iterator{cbegin()}; }
+  const_reverse_iterator rbegin() const { return crbegin(); }
+  const_reverse_iterator rend() const { return crend(); }
+
+ private:
+  const Graph<N, E>& g_;
+};
+
+/* the subgraph induced by the nodes keep(n) returns true for: those nodes, and
+ * every edge whose src and dst are both among them */
+template <typename N, typename E, typename NodePred>
+class InducedSubgraphView {
+ private:
+  /* turns the node predicate into an edge one for the iterator */
+  struct Keep {
+    bool operator()(const N& src, const N& dst, const E&) const { return pred_(src) && pred_(dst); }
+    NodePred pred_;
+  };
+
+ public:
+  using const_iterator = detail::FilteredEdgeIterator<N, E, Keep>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /* ctors */
+  InducedSubgraphView(const Graph<N, E>& g, NodePred keep) : g_{g}, keep_{keep} {}
+
+  /* methods, with the same meaning (and exceptions) as on Graph, where nodes that
+   * aren't kept don't exist */
+  bool IsNode(const N& val) const { return keep_.pred_(val) && g_.IsNode(val); }
+  bool IsConnected(const N& src, const N& dst) const;
+  std::vector<N> GetNodes() const;
+  std::vector<N> GetConnected(const N& src) const;
+  std::vector<E> GetWeights(const N& src, const N& dst) const;
+  const_iterator find(const N& src, const N& dst, const E& w) const;
+
+  /* iterator methods */
+  const_iterator cbegin() const { return {g_.cbegin(), g_.cend(), &keep_}; }
+  const_iterator cend() const { return {g_.cend(), g_.cend(), &keep_}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+  const_reverse_iterator crbegin() const { return const_reverse_iterator{cend()}; }
+  const_reverse_iterator crend() const { return const_reverse_iterator{cbegin()}; }
+  const_reverse_iterator rbegin() const { return crbegin(); }
+  const_reverse_iterator rend() const { return crend(); }
+
+ private:
+  const Graph<N, E>& g_;
+  Keep keep_;
+};
+
+/* every node of the graph, but only the edges keep(src, dst, w) returns true for */
+template <typename N, typename E, typename EdgePred>
+class EdgeFilterView {
+ public:
+  using const_iterator = detail::FilteredEdgeIterator<N, E, EdgePred>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /* ctors */
+  EdgeFilterView(const Graph<N, E>& g, EdgePred keep) : g_{g}, keep_{keep} {}
+
+  /* methods, with the same meaning (and exceptions) as on Graph */
+  bool IsNode(const N& val) const { return g_.IsNode(val); }
+  bool IsConnected(const N& src, const N& dst) const;
+  std::vector<N> GetNodes() const { return g_.GetNodes(); }
+  std::vector<N> GetConnected(const N& src) const;
+  std::vector<E> GetWeights(const N& src, const N& dst) const;
+  const_iterator find(const N& src, const N& dst, const E& w) const;
+
+  /* iterator methods */
+  const_iterator cbegin() const { return {g_.cbegin(), g_.cend(), &keep_}; }
+  const_iterator cend() const { return {g_.cend(), g_.cend(), &keep_}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+  const_reverse_iterator crbegin() const { return const_reverse_iterator{cend()}; }
+  const_reverse_iterator crend() const { return const_reverse_iterator{cbegin()}; }
+  const_reverse_iterator rbegin() const { return crbegin(); }
+  const_reverse_iterator rend() const { return crend(); }
+
+ private:
+  const Graph<N, E>& g_;
+  EdgePred keep_;
+};
+
+}  // namespace gdwg
+
+#include "assignments/dg/views.tpp"
+
+#endif  // ASSIGNMENTS_DG_VIEWS_H_
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+template <typename N, typename E>
+bool gdwg::ReverseView<N, E>::IsConnected(const N& src, const N& dst) const {
+  auto src_it = g_.nodes_.find(src);
+  if (src_it == g_.nodes_.end() || !g_.IsNode(dst)) {
+    throw std::runtime_error(
+        "Cannot call ReverseView::IsConnected if src or dst node don't exist in the graph");
+  }
+  /* src's reversed outgoing edges are its incoming ones, ordered by their original src */
+  for (const auto& edge_wp : (*src_it)->incoming_) {
+    auto edge_sp = edge_wp.lock();
+    if (edge_sp->src_->value_ == dst)
+      return true;
+    if (dst < edge_sp->src_->value_)
+      break;
+  }
+  return false;
+}
+
+template <typename N, typename E>
+std::vector<N> gdwg::ReverseView<N, E>::GetConnected(const N& src) const {
+  auto src_it = g_.nodes_.find(src);
+  if (src_it == g_.nodes_.end()) {
+    throw std::out_of_range(
+        "Cannot call ReverseView::GetConnected if src doesn't exist in the graph");
+  }
+  /* already ordered, so only parallel edges next to each other need skipping */
+  std::vector<N> connected{};
+  for (const auto& edge_wp : (*src_it)->incoming_) {
+    auto edge_sp = edge_wp.lock();
+    if (connected.empty() || connected.back() != edge_sp->src_->value_)
+      connected.push_back(edge_sp->src_->value_);
+  }
+  return connected;
+}
+
+template <typename N, typename E>
+std::vector<E> gdwg::ReverseView<N, E>::GetWeights(const N& src, const N& dst) const {
+  auto src_it = g_.nodes_.find(src);
+  if (src_it == g_.nodes_.end() || !g_.IsNode(dst)) {
+    throw std::out_of_range(
+        "Cannot call ReverseView::GetWeights if src or dst node don't exist in the graph");
+  }
+  std::vector<E> weights{};
+  for (const auto& edge_wp : (*src_it)->incoming_) {
+    auto edge_sp = edge_wp.lock();
+    if (edge_sp->src_->value_ == dst)
+      weights.push_back(edge_sp->value_);
+  }
+  return weights;
+}
+
+template <typename N, typename E>
+typename gdwg::ReverseView<N, E>::const_iterator
+gdwg::ReverseView<N, E>::find(const N& src, const N& dst, const E& w) const {
+  /* the reversed edge src -> dst is the original dst -> src */
+  auto edge_it = g_.edges_.find(std::tie(dst, src, w));
+  if (edge_it == g_.edges_.end())
+    return cend();
+  auto node_it = g_.nodes_.find(src);
+  auto adj_it = (*node_it)->incoming_.find(typename Graph<N, E>::AdjacencySet::key_type{*edge_it});
+  return {node_it, adj_it, g_.nodes_.cend()};
+}
+
+template <typename N, typename E>
+typename gdwg::ReverseView<N, E>::const_iterator gdwg::ReverseView<N, E>::cbegin() const {
+  /* start at the first node that has any incoming edges */
+  for (auto node_it = g_.nodes_.cbegin(); node_it != g_.nodes_.cend(); ++node_it) {
+    if (!(*node_it)->incoming_.empty())
+      return {node_it, (*node_it)->incoming_.cbegin(), g_.nodes_.cend()};
+  }
+  return cend();
+}
+
+template <typename N, typename E>
+typename gdwg::ReverseView<N, E>::const_iterator::reference
+gdwg::ReverseView<N, E>::const_iterator::operator*() const {
+  return {edge_->dst_->value_, edge_->src_->value_, edge_->value_};
+}
+
+template <typename N, typename E>
+typename gdwg::ReverseView<N, E>::const_iterator&
+gdwg::ReverseView<N, E>::const_iterator::operator++() {
+  ++edge_it_;
+  /* move on to the next node with incoming edges if we ran off this one */
+  while (edge_it_ == (*node_it_)->incoming_.cend()) {
+    ++node_it_;
+    if (node_it_ == node_end_it_) {
+      edge_it_ = {};
+      edge_ = nullptr;
+      return *this;
+    }
+    edge_it_ = (*node_it_)->incoming_.cbegin();
+  }
+  Load();
+  return *this;
+}
+
+template <typename N, typename E>
+typename gdwg::ReverseView<N, E>::const_iterator&
+gdwg::ReverseView<N, E>::const_iterator::operator--() {
+  /* if we are off the end or at the start of a node, go back to the last
+   * edge of the previous node that has any */
+  if (node_it_ == node_end_it_ || edge_it_ == (*node_it_)->incoming_.cbegin()) {
+    do {
+      --node_it_;
+    } while ((*node_it_)->incoming_.empty());
+    edge_it_ = (*node_it_)->incoming_.cend();
+  }
+  --edge_it_;
+  Load();
+  return *this;
+}
+
+template <typename N, typename E, typename NodePred>
+bool gdwg::InducedSubgraphView<N, E, NodePred>::IsConnected(const N& src, const N& dst) const {
+  if (!IsNode(src) || !IsNode(dst)) {
+    throw std::runtime_error(
+        "Cannot call InducedSubgraphView::IsConnected if src or dst node don't exist in the graph");
+  }
+  /* both ends are kept, so every edge between them is too */
+  return g_.IsConnected(src, dst);
+}
+
+template <typename N, typename E, typename NodePred>
+std::vector<N> gdwg::InducedSubgraphView<N, E, NodePred>::GetNodes() const {
+  std::vector<N> nodes{};
+  for (const auto& node : g_.nodes_) {
+    if (keep_.pred_(node->value_))
+      nodes.push_back(node->value_);
+  }
+  return nodes;
+}
+
+template <typename N, typename E, typename NodePred>
+std::vector<N> gdwg::InducedSubgraphView<N, E, NodePred>::GetConnected(const N& src) const {
+  if (!IsNode(src)) {
+    throw std::out_of_range(
+        "Cannot call InducedSubgraphView::GetConnected if src doesn't exist in the graph");
+  }
+  std::vector<N> connected{};
+  for (const auto& edge_wp : (*g_.nodes_.find(src))->outgoing_) {
+    auto edge_sp = edge_wp.lock();
+    const N& dst = edge_sp->dst_->value_;
+    if ((connected.empty() || connected.back() != dst) && keep_.pred_(dst))
+      connected.push_back(dst);
+  }
+  return connected;
+}
+
+template <typename N, typename E, typename NodePred>
+std::vector<E> gdwg::InducedSubgraphView<N, E, NodePred>::GetWeights(const N& src,
+                                                                     const N& dst) const {
+  if (!IsNode(src) || !IsNode(dst)) {
+    throw std::out_of_range(
+        "Cannot call InducedSubgraphView::GetWeights if src or dst node don't exist in the graph");
+  }
+  return g_.GetWeights(src, dst);
+}
+
+template <typename N, typename E, typename NodePred>
+typename gdwg::InducedSubgraphView<N, E, NodePred>::const_iterator
+gdwg::InducedSubgraphView<N, E, NodePred>::find(const N& src, const N& dst, const E& w) const {
+  auto it = g_.find(src, dst, w);
+  if (it == g_.cend() || !keep_(src, dst, w))
+    return cend();
+  return {it, g_.cend(), &keep_};
+}
+
+template <typename N, typename E, typename EdgePred>
+bool gdwg::EdgeFilterView<N, E, EdgePred>::IsConnected(const N& src, const N& dst) const {
+  auto src_it = g_.nodes_.find(src);
+  if (src_it == g_.nodes_.end() || !g_.IsNode(dst)) {
+    throw std::runtime_error(
+        "Cannot call EdgeFilterView::IsConnected if src or dst node don't exist in the graph");
+  }
+  for (const auto& edge_wp : (*src_it)->outgoing_) {
+    auto edge_sp = edge_wp.lock();
+    if (edge_sp->dst_->value_ == dst && keep_(src, dst, edge_sp->value_))
+      return true;
+  }
+  return false;
+}
+
+template <typename N, typename E, typename EdgePred>
+std::vector<N> gdwg::EdgeFilterView<N, E, EdgePred>::GetConnected(const N& src) const {
+  auto src_it = g_.nodes_.find(src);
+  if (src_it == g_.nodes_.end()) {
+    throw std::out_of_range(
+        "Cannot call EdgeFilterView::GetConnected if src doesn't exist in the graph");
+  }
+  std::vector<N> connected{};
+  for (const auto& edge_wp : (*src_it)->outgoing_) {
+    auto edge_sp = edge_wp.lock();
+    const N& dst = edge_sp->dst_->value_;
+    if ((connected.empty() || connected.back() != dst) && keep_(src, dst, edge_sp->value_))
+      connected.push_back(dst);
+  }
+  return connected;
+}
+
+template <typename N, typename E, typename EdgePred>
+std::vector<E> gdwg::EdgeFilterView<N, E, EdgePred>::GetWeights(const N& src, const N& dst) const {
+  auto src_it = g_.nodes_.find(src);
+  if (src_it == g_.nodes_.end() || !g_.IsNode(dst)) {
+    throw std::out_of_range(
+        "Cannot call EdgeFilterView::GetWeights if src or dst node don't exist in the graph");
+  }
+  std::vector<E> weights{};
+  for (const auto& edge_wp : (*src_it)->outgoing_) {
+    auto edge_sp = edge_wp.lock();
+    if (edge_sp->dst_->value_ == dst && keep_(src, dst, edge_sp->value_))
+      weights.push_back(edge_sp->value_);
+  }
+  return weights;
+}
+
+template <typename N, typename E, typename EdgePred>
+typename gdwg::EdgeFilterView<N, E, EdgePred>::const_iterator
+gdwg::EdgeFilterView<N, E, EdgePred>::find(const N& src, const N& dst, const E& w) const {
+  auto it = g_.find(src, dst, w);
+  if (it == g_.cend() || !keep_(src, dst, w))
+    return cend();
+  return {it, g_.cend(), &keep_};
+}
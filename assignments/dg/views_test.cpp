@@ -0,0 +1,91 @@
+#include "assignments/dg/views.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/graph.h"
+#include "catch.h"
+
+/* a small graph with parallel edges and a reflexive edge to build the views over */
+std::vector<std::tuple<char, char, int>> view_edges{{'a', 'b', 1}, {'a', 'b', 2}, {'a', 'c', 3},
+                                                    {'b', 'c', 4}, {'c', 'a', 5}, {'c', 'c', 6},
+                                                    {'d', 'a', 7}};
+
+SCENARIO("ReverseView") {
+  GIVEN("a view of a graph") {
+    gdwg::Graph<char, int> g{view_edges.begin(), view_edges.end()};
+    gdwg::ReverseView<char, int> rv{g};
+    THEN("iterating gives every edge flipped, ordered by (src, dst, w)") {
+      std::vector<std::tuple<char, char, int>> expected{};
+      for (const auto& [src, dst, w] : view_edges) {
+        expected.emplace_back(dst, src, w);
+      }
+      std::sort(expected.begin(), expected.end());
+      std::vector<std::tuple<char, char, int>> seen{rv.begin(), rv.end()};
+      REQUIRE(seen == expected);
+      std::vector<std::tuple<char, char, int>> backwards{rv.rbegin(), rv.rend()};
+      REQUIRE(std::equal(backwards.begin(), backwards.end(), expected.rbegin(), expected.rend()));
+    }
+    THEN("queries are answered as if edges pointed the other way") {
+      REQUIRE(rv.IsConnected('b', 'a'));
+      REQUIRE(!rv.IsConnected('a', 'b'));
+      REQUIRE(rv.GetConnected('a') == std::vector<char>{'c', 'd'});
+      REQUIRE(rv.GetConnected('d').empty());
+      REQUIRE(rv.GetWeights('b', 'a') == std::vector<int>{1, 2});
+      REQUIRE(rv.find('b', 'a', 2) != rv.end());
+      REQUIRE(*rv.find('b', 'a', 2) == std::make_tuple('b', 'a', 2));
+      REQUIRE(rv.find('a', 'b', 2) == rv.end());
+      REQUIRE_THROWS_AS(rv.GetConnected('z'), std::out_of_range);
+      REQUIRE_THROWS_AS(rv.IsConnected('a', 'z'), std::runtime_error);
+    }
+    WHEN("the graph changes") {
+      g.erase('d', 'a', 7);
+      THEN("the view sees it straight away") {
+        REQUIRE(rv.GetConnected('a') == std::vector<char>{'c'});
+      }
+    }
+  }
+}
+
+SCENARIO("InducedSubgraphView") {
+  GIVEN("a view that leaves out node c") {
+    gdwg::Graph<char, int> g{view_edges.begin(), view_edges.end()};
+    gdwg::InducedSubgraphView view{g, [](char n) { return n != 'c'; }};
+    THEN("c and every edge touching it are gone") {
+      REQUIRE(!view.IsNode('c'));
+      REQUIRE(view.GetNodes() == std::vector<char>{'a', 'b', 'd'});
+      std::vector<std::tuple<char, char, int>> seen{view.begin(), view.end()};
+      REQUIRE(seen == std::vector<std::tuple<char, char, int>>{
+                          {'a', 'b', 1}, {'a', 'b', 2}, {'d', 'a', 7}});
+      std::vector<std::tuple<char, char, int>> backwards{view.rbegin(), view.rend()};
+      REQUIRE(backwards.size() == 3);
+      REQUIRE(backwards.front() == std::make_tuple('d', 'a', 7));
+      REQUIRE(view.GetConnected('a') == std::vector<char>{'b'});
+      REQUIRE(view.find('a', 'c', 3) == view.end());
+      REQUIRE(view.find('a', 'b', 2) != view.end());
+      REQUIRE_THROWS_AS(view.IsConnected('a', 'c'), std::runtime_error);
+      REQUIRE_THROWS_AS(view.GetWeights('c', 'a'), std::out_of_range);
+    }
+  }
+}
+
+SCENARIO("EdgeFilterView") {
+  GIVEN("a view that only keeps heavy edges") {
+    gdwg::Graph<char, int> g{view_edges.begin(), view_edges.end()};
+    gdwg::EdgeFilterView view{g, [](char, char, int w) { return w >= 3; }};
+    THEN("every node is still there but the light edges are gone") {
+      REQUIRE(view.GetNodes() == g.GetNodes());
+      REQUIRE(!view.IsConnected('a', 'b'));
+      REQUIRE(view.IsConnected('a', 'c'));
+      REQUIRE(view.GetConnected('a') == std::vector<char>{'c'});
+      REQUIRE(view.GetWeights('a', 'b').empty());
+      REQUIRE(view.find('a', 'b', 1) == view.end());
+      REQUIRE(std::distance(view.begin(), view.end()) == 5);
+      REQUIRE(*view.begin() == std::make_tuple('a', 'c', 3));
+      REQUIRE(*view.rbegin() == std::make_tuple('d', 'a', 7));
+    }
+  }
+}
@@ -0,0 +1,98 @@
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "assignments/dg/benchmark.h"
+#include "assignments/dg/graph.h"
+
+namespace {
+
+/* runs num_queries weight range queries (each about 1/1000th of the weights
+ * wide), global top-k queries and per-source top-k queries on g, returning the
+ * total number of edges found so it can't be optimised away */
+std::size_t RunQueries(const std::string& name,
+                       const gdwg::Graph<int, int>& g,
+                       std::size_t num_nodes,
+                       std::size_t num_queries,
+                       gdwg::benchmark::JsonResults& json) {
+  std::mt19937 rng{6771};
+  std::uniform_int_distribution<int> low{1, 100000};
+  std::uniform_int_distribution<int> node{0, static_cast<int>(num_nodes) - 1};
+  std::size_t found = 0;
+  const std::string index = g.HasWeightIndex() ? "indexed" : "scan";
+
+  gdwg::benchmark::Stopwatch range_timer{};
+  for (std::size_t i = 0; i < num_queries; ++i) {
+    const auto lo = low(rng);
+    found += g.EdgesWithWeightIn(lo, lo + 100).size();
+  }
+  const auto range_seconds = range_timer.Seconds();
+  gdwg::benchmark::Report(name + " EdgesWithWeightIn", num_queries, range_seconds);
+  json.Add("EdgesWithWeightIn", {{"index", index}}, num_queries, range_seconds);
+
+  gdwg::benchmark::Stopwatch top_timer{};
+  for (std::size_t i = 0; i < num_queries; ++i) {
+    found += g.HeaviestEdges(10).size();
+  }
+  const auto top_seconds = top_timer.Seconds();
+  gdwg::benchmark::Report(name + " HeaviestEdges(10)", num_queries, top_seconds);
+  json.Add("HeaviestEdges", {{"index", index}}, num_queries, top_seconds);
+
+  gdwg::benchmark::Stopwatch out_timer{};
+  for (std::size_t i = 0; i < num_queries; ++i) {
+    found += g.HeaviestOutgoingEdges(node(rng), 3).size();
+  }
+  const auto out_seconds = out_timer.Seconds();
+  gdwg::benchmark::Report(name + " HeaviestOutgoingEdges(3)", num_queries, out_seconds);
+  json.Add("HeaviestOutgoingEdges", {{"index", index}}, num_queries, out_seconds);
+  return found;
+}
+
+}  // namespace
+
+/* weight range and top-k queries on a random graph with weights in 1..100100,
+ * scanning and then with the weight index, plus what the index costs to build
+ * and to keep up to date on inserts.
+ * usage: weight_index_benchmark [num_nodes (default 20000)] [num_edges (default 200000)]
+ *                               [num_queries (default 50)] */
+int main(int argc, char** argv) {
+  const auto num_nodes = gdwg::benchmark::Arg(argc, argv, 1, 20000);
+  const auto num_edges = gdwg::benchmark::Arg(argc, argv, 2, 200000);
+  const auto num_queries = gdwg::benchmark::Arg(argc, argv, 3, 50);
+  auto edges = gdwg::benchmark::RandomEdges(num_nodes, num_edges);
+  std::mt19937 rng{1};
+  std::uniform_int_distribution<int> weight{1, 100100};
+  for (auto& edge : edges) {
+    std::get<2>(edge) = weight(rng);
+  }
+  gdwg::benchmark::JsonResults json{};
+
+  gdwg::benchmark::Stopwatch plain_timer{};
+  gdwg::Graph<int, int> g{edges.cbegin(), edges.cend()};
+  gdwg::benchmark::Report("inserts without the index", edges.size(), plain_timer.Seconds());
+  auto found = RunQueries("scan", g, num_nodes, num_queries, json);
+
+  gdwg::benchmark::Stopwatch build_timer{};
+  g.EnableWeightIndex();
+  gdwg::benchmark::Report("EnableWeightIndex", edges.size(), build_timer.Seconds());
+  found -= RunQueries("indexed", g, num_nodes, num_queries, json);
+
+  gdwg::Graph<int, int> indexed{};
+  indexed.EnableWeightIndex();
+  gdwg::benchmark::Stopwatch indexed_timer{};
+  for (int v = 0; v < static_cast<int>(num_nodes); ++v) {
+    indexed.InsertNode(v);
+  }
+  for (const auto& [src, dst, w] : edges) {
+    indexed.InsertEdge(src, dst, w);
+  }
+  gdwg::benchmark::Report("inserts with the index", edges.size(), indexed_timer.Seconds());
+  if (found != 0) {
+    std::cerr << "the index and the scans disagree\n";
+    return 1;
+  }
+  json.Write(std::cout);
+}